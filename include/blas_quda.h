@@ -934,6 +934,20 @@ namespace quda {
       */
       void hDotProduct_Anorm(std::vector<Complex> &result, cvector_ref<const ColorSpinorField> &a,
                              cvector_ref<const ColorSpinorField> &b);
+
+      /**
+         @brief Orthonormalize a vector set in place using block
+         classical Gram-Schmidt with re-orthogonalization (BCGS2).
+         Each block of block_size vectors is projected against the
+         preceding vectors and factorized with a Cholesky QR, with a
+         single multi-reduction and a single multi-blas update per
+         pass.  In exact arithmetic the result is identical to
+         sequential Gram-Schmidt.
+
+         @param v[in,out] set of ColorSpinorFields to orthonormalize
+         @param block_size[in] the number of vectors per block
+      */
+      void orthonormalize(cvector_ref<ColorSpinorField> &v, unsigned int block_size = 16);
     } // namespace block
 
     // compatibility wrappers until we switch to
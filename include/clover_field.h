@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <quda_internal.h>
 #include <lattice_field.h>
 #include <comm_key.h>
@@ -456,6 +457,14 @@ namespace quda {
      */
     double abs_min(bool inverse = false) const;
 
+    /**
+       Compute checksum of this clover field: this uses a XOR-based checksum method
+       @param[in] inverse Whether to compute the checksum of the inverse field
+       @param[in] mini Whether to compute a mini checksum or global checksum.
+       @return checksum value
+     */
+    uint64_t checksum(bool inverse = false, bool mini = false) const;
+
     /**
        @brief Backs up the CloverField
     */
@@ -520,6 +529,17 @@ namespace quda {
   */
   double norm2(const CloverField &a, bool inverse=false);
 
+  /**
+     Compute XOR-based checksum of a clover field: each site is loaded
+     in register precision and the 64-bit words that constitute it are
+     XOR-ed together.
+     @param[in] c The clover field we are computing the checksum of
+     @param[in] inverse Whether to compute the checksum of the inverse field
+     @param[in] mini Whether to compute a mini checksum or global checksum.
+     @return checksum value
+  */
+  uint64_t Checksum(const CloverField &c, bool inverse = false, bool mini = false);
+
   /**
      @brief Driver for computing the clover field from the field
      strength tensor.
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <quda_internal.h>
 #include <quda.h>
@@ -870,6 +871,15 @@ namespace quda
      */
     void PrintVector(int parity, unsigned int x_cb, int rank = 0) const;
 
+    /**
+       Compute checksum of this field: this uses a XOR-based checksum method
+       @param[in] mini Whether to compute a mini checksum or global checksum.
+       A mini checksum only computes the checksum over a subset of the lattice
+       sites and is to be used for online comparisons.
+       @return checksum value
+     */
+    uint64_t checksum(bool mini = false) const;
+
     /**
        @brief Perform a component by component comparison of two
        color-spinor fields.  In doing we normalize with respect to the
@@ -1009,6 +1019,27 @@ namespace quda
   */
   void genericPrintVector(const ColorSpinorField &a, int parity, unsigned int x_cb, int rank = 0);
 
+  /**
+     Compute XOR-based checksum of this field: each site is loaded in
+     register precision and the 64-bit words that constitute it are
+     XOR-ed together, so the result is independent of field order
+     and location.
+     @param[in] v The field we are computing the checksum of
+     @param[in] mini Whether to compute a mini checksum or global checksum.
+     @return checksum value
+  */
+  uint64_t Checksum(const ColorSpinorField &v, bool mini = false);
+
+  /**
+     Compute the SciDAC checksum of this field, as recorded by QIO
+     when writing the field in its present precision (site record is
+     [spin][color][complex], big endian).  Only full-parity single-
+     or double-precision fields are supported.
+     @param[in] v The field we are computing the checksum of
+     @return The checksum pair {suma, sumb}
+  */
+  std::array<uint32_t, 2> ScidacChecksum(const ColorSpinorField &v);
+
   /**
      @brief Generic ghost packing routine
 
@@ -785,7 +785,21 @@ namespace quda
 
 constexpr CommKey default_comm_key = {1, 1, 1, 1};
 
-void push_communicator(const CommKey &split_key);
+/**
+   @brief Switch to the communicator of the given split grid, creating
+   it if needed.  An ordinary switch frees the communication buffers
+   of the prior communicator and, when returning to the default
+   communicator, joins the tune caches of the sub-partitions.  A
+   retained switch instead leaves the communication buffers and field
+   temporaries in place, for the caller to swap with those it retains
+   for the new communicator (see LatticeField::swapGhostBuffer and
+   FieldTmp::swap), and defers joining the tune caches to the next
+   ordinary return to the default communicator, which makes it cheap
+   to switch back and forth repeatedly.
+   @param[in] split_key The grid of sub-partitions to switch to
+   @param[in] retain Whether the caller retains the communication state
+*/
+void push_communicator(const CommKey &split_key, bool retain = false);
 
 /**
    @brief Broadcast from the root rank of the default communicator
@@ -18,6 +18,9 @@ namespace quda {
   // Forward declare: Dirac Op Base Class
   class Dirac;
 
+  // Forward declare: MG checkpoint
+  class MGCheckpoint;
+
   // Params for Dirac operator
   class DiracParam {
 
@@ -64,6 +67,7 @@ namespace quda {
     bool setup_use_mma;      // whether to use tensor cores where applicable for setup
     bool dslash_use_mma;     // whether to use tensor cores where applicable for dslash
     bool allow_truncation; /** whether or not we let MG coarsening drop improvements, for ex drop long links for small aggregate dimensions */
+    MGCheckpoint *checkpoint; // if set, the coarse operator is restored from this checkpoint rather than being built
 
     bool use_mobius_fused_kernel; // Whether or not use fused kernels for Mobius
 
@@ -92,6 +96,7 @@ namespace quda {
 #endif
       dslash_use_mma(false),
       allow_truncation(false),
+      checkpoint(nullptr),
 #ifdef NVSHMEM_COMMS
       use_mobius_fused_kernel(false),
 #else
@@ -1896,8 +1901,10 @@ public:
     /**
        @brief Initialize the coarse gauge fields.  Location is
        determined by gpu_setup variable.
+       @param[in] checkpoint If set, restore the coarse gauge fields
+       from this checkpoint rather than building them
     */
-    void initializeCoarse();
+    void initializeCoarse(MGCheckpoint *checkpoint = nullptr);
 
     /**
        @brief Create the CPU or GPU coarse gauge fields on demand
@@ -1961,6 +1968,29 @@ public:
      */
     DiracCoarse(const DiracCoarse &dirac, const DiracParam &param);
 
+    /**
+       @brief Rebuild the coarse gauge fields from an updated parent
+       operator, reusing the existing link storage so that any
+       operator sharing these fields sees the update.  The transfer
+       operator is assumed to have been reset beforehand.
+       @param[in] dirac The updated parent Dirac operator
+     */
+    void updateCoarseOp(const Dirac *dirac);
+
+    /**
+       @brief Create a copy of this operator on a split grid, for
+       agglomerating the coarse grid onto fewer ranks.  The coarse
+       link fields are collected onto each sub-partition of the
+       process grid with split_field, and the returned operator, whose
+       fields reside on the device, must only be applied with the
+       split communicator pushed.  This must be called with the
+       default communicator active.
+       @param[in] param Parameters for the agglomerated operator
+       @param[in] split_key Grid of sub-partitions to agglomerate onto
+       @return The agglomerated operator
+     */
+    DiracCoarse *agglomerate(const DiracParam &param, const CommKey &split_key) const;
+
     virtual bool isCoarse() const override { return true; }
 
     /**
@@ -2062,6 +2092,20 @@ public:
     */
     virtual void prefetch(QudaFieldLocation mem_space, qudaStream_t stream = device::get_default_stream()) const override;
 
+    /**
+       @brief Save the coarse link fields (Y, X, Xinv, Yhat) to a checkpoint
+       @param[in] checkpoint The checkpoint we are writing
+    */
+    void save(MGCheckpoint &checkpoint) const;
+
+    /**
+       @brief Restore the coarse link fields (Y, X, Xinv, Yhat) from
+       a checkpoint, in lieu of building them.  The fields are
+       allocated in the setup location.
+       @param[in] checkpoint The checkpoint we are reading
+    */
+    void load(MGCheckpoint &checkpoint);
+
     /**
       @brief If use_mma and the batch size is larger than 1, actually apply coarse dslash with MMA
       @param[in] f The reference field
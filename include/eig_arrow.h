@@ -0,0 +1,41 @@
+#pragma once
+
+namespace quda
+{
+
+  /**
+     @brief Structured eigen-decomposition of the symmetric
+     arrow-tridiagonal matrix that arises at a thick restart of the
+     Lanczos method.  The matrix has diagonal `diag`, an arrow in row
+     and column `arrow_pos` whose leading elements are
+     offdiag[0..arrow_pos), and is tridiagonal from `arrow_pos`
+     onwards with sub-diagonal offdiag[arrow_pos..dim-1).
+
+     The trailing tridiagonal block is solved by divide and conquer,
+     and the leading arrow is merged with it as a single arrowhead
+     matrix.  Each merge solves the arrowhead secular equation, with
+     deflation of small couplings and close poles, and recomputes the
+     coupling vector via the Gu-Eisenstat (Loewner) formula so that
+     the eigenvectors are numerically orthogonal.  The secular roots
+     and eigenvectors are computed in parallel with OpenMP, and the
+     back transformation is a dense matrix product.
+
+     @param[out] evals The eigenvalues in ascending order (length dim)
+     @param[out] evecs The eigenvectors, with eigenvector i stored
+     contiguously at evecs[dim * i] (length dim * dim)
+     @param[in] diag The diagonal of the matrix (length dim)
+     @param[in] offdiag The arrow and sub-diagonal elements (length dim - 1)
+     @param[in] dim The dimension of the matrix
+     @param[in] arrow_pos The row and column of the arrow
+  */
+  void arrowEigensolve(double *evals, double *evecs, const double *diag, const double *offdiag, int dim, int arrow_pos);
+
+  /**
+     @brief Dense eigen-decomposition of the same arrow matrix with
+     Eigen, which we retain as a reference for the structured solver.
+     The parameters are as for arrowEigensolve.
+  */
+  void arrowEigensolveDense(double *evals, double *evecs, const double *diag, const double *offdiag, int dim,
+                            int arrow_pos);
+
+} // namespace quda
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+
+namespace quda
+{
+
+  /**
+     @brief Apply shifts to an upper Hessenberg matrix via implicit
+     single-shift QR steps, chasing the bulges of all the shifts as a
+     pipelined wave whose rotations are applied in parallel.  This is
+     the restart of the implicitly restarted Arnoldi method.
+     @param[in,out] H The upper Hessenberg matrix, stored as H[row][column]
+     @param[out] Q The accumulated unitary transformation, such that
+     the resulting H is Q^dagger H Q
+     @param[in] shifts The shifts to apply
+     @param[in] num_shifts The number of shifts to apply
+     @param[in] tol Sub-diagonal elements below this tolerance split the matrix
+  */
+  void hessenbergQRShifts(std::vector<std::vector<std::complex<double>>> &H,
+                          std::vector<std::vector<std::complex<double>>> &Q,
+                          const std::vector<std::complex<double>> &shifts, int num_shifts, double tol);
+
+  /**
+     @brief Eigen-decomposition of an upper triangular matrix, e.g.,
+     the triangular factor of a Schur decomposition.  Each eigenvector
+     is an independent back substitution, so these are computed in
+     parallel.  The eigenvalues are sorted by increasing modulus, as
+     with Eigen::ComplexEigenSolver.
+     @param[out] evals The eigenvalues (length n)
+     @param[out] evecs The normalized eigenvectors, with eigenvector
+     i stored contiguously at evecs[n * i] (length n * n)
+     @param[in] T The upper triangular matrix, column major (length n * n)
+     @param[in] n The dimension of the matrix
+  */
+  void triangularEigensolve(std::complex<double> *evals, std::complex<double> *evecs, const std::complex<double> *T,
+                            int n);
+
+} // namespace quda
@@ -6,10 +6,14 @@
 #include <dirac_quda.h>
 #include <color_spinor_field.h>
 #include <eigen_helper.h>
+#include <memory>
 
 namespace quda
 {
 
+  class Solver;
+  struct SolverParam;
+
   // Local enum for the LU axpy block type
   enum blockType { PENCIL, LOWER_TRI, UPPER_TRI };
 
@@ -136,12 +140,22 @@ namespace quda
 
     /**
        @brief Promoted the specified matVec operation:
-       M, Mdag, MMdag, MdagM to a Chebyshev polynomial
+       M, Mdag, MMdag, MdagM to a Chebyshev polynomial.  A set of
+       input vectors is applied in blocks, with each block using the
+       multi-RHS operator, and the block size is autotuned.
        @param[in] out Output spinor
        @param[in] in Input spinor
     */
     void chebyOp(cvector_ref<ColorSpinorField> &out, cvector_ref <const ColorSpinorField> &in);
 
+    /**
+       @brief Apply the Chebyshev polynomial to a single block of
+       vectors, with one multi-RHS operator application per degree
+       @param[in] out Output spinor
+       @param[in] in Input spinor
+    */
+    void chebyOpBlock(cvector_ref<ColorSpinorField> &out, cvector_ref<const ColorSpinorField> &in);
+
     /**
        @brief Estimate the spectral radius of the operator for the max value of the
        Chebyshev polynomial
@@ -252,6 +266,25 @@ namespace quda
                     cvector_ref<const ColorSpinorField> &evecs, const std::vector<Complex> &evals,
                     bool accumulate = false) const;
 
+    /**
+       @brief Deflate a set of source vectors with an eigenspace that
+       resides in host memory (out-of-core deflation).  The space is
+       streamed to the device in tiles of deflation_tile_size
+       vectors, with the transfer of the next tile overlapping the
+       block inner products and block caxpy of the current tile.  The
+       host vectors are in the host field order, and each tile is
+       reordered to the native order on the device.
+       @param[in,out] sol The resulting deflated vector set
+       @param[in] src The source vector set we are deflating
+       @param[in] left The host vectors we project onto
+       @param[in] right The host vectors we accumulate with (may alias left)
+       @param[in] evals The eigen- or singular values to use in deflation
+       @param[in] accumulate Whether to preserve the sol vector content prior to accumulating
+    */
+    void deflateOutOfCore(cvector_ref<ColorSpinorField> &sol, cvector_ref<const ColorSpinorField> &src,
+                          cvector_ref<const ColorSpinorField> &left, cvector_ref<const ColorSpinorField> &right,
+                          const std::vector<Complex> &evals, bool accumulate) const;
+
     /**
        @brief Computes Left/Right SVD from pre computed Right/Left
        @param[in] evecs Computed eigenvectors of NormOp
@@ -268,6 +301,37 @@ namespace quda
     */
     virtual void computeEvals(std::vector<ColorSpinorField> &evecs, std::vector<Complex> &evals, int size = 0);
 
+    /**
+       @brief Refine an approximate eigenspace, e.g., one computed
+       for a slightly different gauge field, on the present operator.
+       A Rayleigh-Ritz projection onto the space is followed by up to
+       deflation_refine_sweeps sweeps, each of which applies
+       Rayleigh-Ritz to the space augmented with the residuals of
+       the unconverged vectors.
+       @param[in,out] evecs The approximate eigenvectors, of which the first n_conv are refined
+       @param[out] evals The refined eigenvalues
+       @return Whether all n_conv eigenpairs meet the tolerance
+    */
+    bool refine(std::vector<ColorSpinorField> &evecs, std::vector<Complex> &evals);
+
+    /**
+       @brief Compute the matrix of inner products G(i, j) = <a_i|b_j>
+       @param[in] a The left set of vectors
+       @param[in] b The right set of vectors
+       @return The matrix of inner products
+    */
+    static MatrixXcd gram(cvector_ref<const ColorSpinorField> &a, cvector_ref<const ColorSpinorField> &b);
+
+    /**
+       @brief Compute y = x * C, or y += x * C if accumulating
+       @param[in,out] y The output vectors
+       @param[in] x The input vectors
+       @param[in] C The x.size() x y.size() matrix of coefficients
+       @param[in] accumulate Whether to accumulate onto y
+    */
+    static void rotate(cvector_ref<ColorSpinorField> &y, cvector_ref<const ColorSpinorField> &x, const MatrixXcd &C,
+                       bool accumulate);
+
     /**
        @brief Load and check eigenpairs from file
        @param[in] mat Matrix operator
@@ -612,7 +676,9 @@ namespace quda
     void rotateBasis(std::vector<ColorSpinorField> &v, int keep);
 
     /**
-       @brief Apply shifts to the upper Hessenberg matrix via QR decomposition
+       @brief Apply shifts to the upper Hessenberg matrix via implicit
+       QR, chasing the bulges of all the shifts as a pipelined wave
+       whose rotations are applied in parallel (see hessenbergQRShifts)
        @param[in] evals The shifts to apply
        @param[in] num_shifts The number of shifts to apply
     */
@@ -636,6 +702,103 @@ namespace quda
                  const QudaEigSpectrumType spec_type);
   };
 
+  /**
+     @brief Locally Optimal Block Preconditioned Conjugate Gradient
+     (LOBPCG) method for the extremal eigenpairs of a Hermitian
+     operator.  A block of n_ev Ritz vectors X is iterated, and each
+     step the Rayleigh-Ritz problem is solved in the space spanned by
+     X, the preconditioned residuals W of the unconverged vectors, and
+     the previous search directions P.  The basis is kept orthonormal
+     with Hetmaniuk-Lehoucq projections and SVQB, and the operator is
+     applied to each block with a single batched (multi-RHS) call.
+
+     Any user supplied vectors are used as the initial guess, so a
+     nearby eigenspace (e.g., from a previous gauge configuration) can
+     be refined cheaply.  The preconditioner is defined by the
+     inv_type_precondition, tol_precondition and
+     maxiter_precondition of the invert_param: either an inner Krylov
+     solve on the operator, or, with QUDA_MG_INVERTER, the multigrid
+     solver pointed to by invert_param->preconditioner.
+  */
+  class LOBPCG : public EigenSolver
+  {
+    /** Parameters for the inner solver used as the preconditioner */
+    std::unique_ptr<SolverParam> K_param;
+
+    /** The preconditioner, if any */
+    std::shared_ptr<Solver> K;
+
+    /** Whether the preconditioner is a multigrid solver for M rather than a solver for the operator */
+    bool K_mg = false;
+
+    /** Temporaries in the multigrid precision */
+    std::vector<ColorSpinorField> K_in = {};
+    std::vector<ColorSpinorField> K_out = {};
+
+  public:
+    /**
+       @brief Constructor for LOBPCG Eigensolver class
+       @param eig_param The eigensolver parameters
+       @param mat The operator to solve
+    */
+    LOBPCG(const DiracMatrix &mat, QudaEigParam *eig_param);
+
+    /**
+       @brief Destructor for LOBPCG Eigensolver class
+    */
+    virtual ~LOBPCG();
+
+    /**
+       @return Whether the solver is only for Hermitian systems
+    */
+    virtual bool hermitian() { return true; } /** LOBPCG is only for Hermitian systems */
+
+    /**
+       @brief Compute eigenpairs
+       @param[in] kSpace Initial guess, returns the eigenvectors
+       @param[in] evals Computed eigenvalues
+    */
+    void operator()(std::vector<ColorSpinorField> &kSpace, std::vector<Complex> &evals);
+
+    /**
+       @brief Create the preconditioner, if one is requested
+       @param[in] meta Field from which the meta data is obtained
+    */
+    void createPreconditioner(const ColorSpinorField &meta);
+
+    /**
+       @brief Apply the preconditioner, w = K r, or copy if there is none
+       @param[out] w The preconditioned residuals
+       @param[in] r The residuals
+    */
+    void precondition(cvector_ref<ColorSpinorField> &w, cvector_ref<const ColorSpinorField> &r);
+
+    /**
+       @brief Orthonormalize a set of vectors with SVQB, dropping
+       directions that are numerically linearly dependent.  The result
+       is compacted into the leading vectors of v, and if av is
+       non-empty the operator applied to v is updated in tandem.
+       @param[in,out] v The vectors to orthonormalize
+       @param[in,out] av The operator applied to v (may be empty)
+       @param[in] tmp Workspace of the same size as v
+       @param[in] atmp Workspace of the same size as av
+       @return The number of vectors retained
+    */
+    int svqb(cvector_ref<ColorSpinorField> &v, cvector_ref<ColorSpinorField> &av, cvector_ref<ColorSpinorField> &tmp,
+             cvector_ref<ColorSpinorField> &atmp);
+
+    /**
+       @brief Project out the span of the orthonormal set x from v, and
+       update av with ax in tandem if av is non-empty
+       @param[in,out] v The vectors to project
+       @param[in,out] av The operator applied to v (may be empty)
+       @param[in] x The orthonormal vectors to project out
+       @param[in] ax The operator applied to x
+    */
+    void project(cvector_ref<ColorSpinorField> &v, cvector_ref<ColorSpinorField> &av,
+                 cvector_ref<const ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &ax);
+  };
+
   /**
      arpack_solve()
 
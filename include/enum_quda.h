@@ -132,6 +132,8 @@ typedef enum QudaInverterType_s {
   QUDA_CA_CGNE_INVERTER,
   QUDA_CA_CGNR_INVERTER,
   QUDA_CA_GCR_INVERTER,
+  QUDA_BLOCK_CG_INVERTER,
+  QUDA_CHEBYSHEV_INVERTER,
   QUDA_INVALID_INVERTER = QUDA_INVALID_ENUM
 } QudaInverterType;
 
@@ -141,6 +143,7 @@ typedef enum QudaEigType_s {
   QUDA_EIG_TR_LANCZOS_3D,  // Thick restarted lanczos solver for 3-d systems
   QUDA_EIG_IR_ARNOLDI,     // Implicitly Restarted Arnoldi solver
   QUDA_EIG_BLK_IR_ARNOLDI, // Block Implicitly Restarted Arnoldi solver
+  QUDA_EIG_LOBPCG,         // Locally optimal block preconditioned conjugate gradient solver
   QUDA_EIG_INVALID = QUDA_INVALID_ENUM
 } QudaEigType;
 
@@ -183,6 +186,7 @@ typedef enum QudaMultigridCycleType_s {
   QUDA_MG_CYCLE_FCYCLE,
   QUDA_MG_CYCLE_WCYCLE,
   QUDA_MG_CYCLE_RECURSIVE,
+  QUDA_MG_CYCLE_ADAPTIVE,
   QUDA_MG_CYCLE_INVALID = QUDA_INVALID_ENUM
 } QudaMultigridCycleType;
 
@@ -117,6 +117,8 @@
 #define QUDA_CA_CGNE_INVERTER 20
 #define QUDA_CA_CGNR_INVERTER 21
 #define QUDA_CA_GCR_INVERTER 22
+#define QUDA_BLOCK_CG_INVERTER 23
+#define QUDA_CHEBYSHEV_INVERTER 24
 #define QUDA_INVALID_INVERTER QUDA_INVALID_ENUM
 
 #define QudaEigType integer(4)
@@ -125,6 +127,7 @@
 #define QUDA_EIG_TR_LANCZOS_3D 2  // Thick Restarted Lanczos Solver for 3-d systems
 #define QUDA_EIG_IR_ARNOLDI 3     // Implicitly restarted Arnoldi solver
 #define QUDA_EIG_BLK_IR_ARNOLDI 4 // Block Implicitly restarted Arnoldi solver (not yet implemented)
+#define QUDA_EIG_LOBPCG 5         // Locally optimal block preconditioned conjugate gradient solver
 #define QUDA_EIG_INVALID QUDA_INVALID_ENUM
 
 #define QudaEigSpectrumType integer(4)
@@ -161,6 +164,7 @@
 #define QUDA_MG_CYCLE_FCYCLE 1
 #define QUDA_MG_CYCLE_WCYCLE 2
 #define QUDA_MG_CYCLE_RECURSIVE 3
+#define QUDA_MG_CYCLE_ADAPTIVE 4
 #define QUDA_MG_CYCLE_INVALID QUDA_INVALID_ENUM
 
 #define QudaSchwarzType integer(4)
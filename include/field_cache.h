@@ -46,9 +46,13 @@ namespace quda {
    */
   template <typename T>
   class FieldTmp {
-    static std::map<FieldKey<T>, std::stack<T>> cache; /** Field Cache */
-    T tmp;                                             /** The temporary field instance */
-    FieldKey<T> key;                                   /** Key associated with this instance */
+  public:
+    using cache_t = std::map<FieldKey<T>, std::stack<T>>;
+
+  private:
+    static cache_t cache; /** Field Cache */
+    T tmp;                /** The temporary field instance */
+    FieldKey<T> key;      /** Key associated with this instance */
 
   public:
     /**
@@ -109,6 +113,14 @@ namespace quda {
 
     /** @brief Flush the cache and frees all temporary allocations */
     static void destroy();
+
+    /**
+       @brief Exchange the cache with one retained elsewhere, e.g.,
+       that of another communicator, whose temporaries must not be
+       reused under the present one
+       @param[in,out] other The retained cache
+    */
+    static void swap(cache_t &other);
   };
 
   /**
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <quda_internal.h>
 #include <quda.h>
 #include <lattice_field.h>
@@ -798,6 +799,18 @@ namespace quda {
   */
   uint64_t Checksum(const GaugeField &u, bool mini=false);
 
+  /**
+     Compute the SciDAC checksum of this gauge field, as recorded by
+     QIO when writing the field in its present precision.  The CRC-32
+     of each site's record ([dir][row][col][complex], big endian) is
+     rotated by the global lexicographical site rank modulo 29 and 31
+     respectively and XOR-ed together.  Computed in parallel at the
+     location of the field.
+     @param[in] u The gauge field we are computing the checksum of
+     @return The checksum pair {suma, sumb}
+  */
+  std::array<uint32_t, 2> ScidacChecksum(const GaugeField &u);
+
   /**
      @brief Helper function for determining if the reconstruct of the fields is the same.
      @param[in] a Input field
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <quda.h>
+
+namespace quda
+{
+
+  /**
+     @brief GaugePrefetcher reads a sequence of gauge configurations
+     into pinned host buffers on a background thread, so that the
+     read of the next configuration(s) overlaps with the processing
+     of the present one.  The buffers form a ring of depth + 1 QDP
+     ordered fields: one is in use by the caller and up to depth are
+     being read or waiting to be consumed.  All buffers are allocated
+     upfront, so the background thread does no allocation.
+
+     The reads are done with QIO, which is not thread safe, so the
+     caller must not do any other QIO I/O while prefetching is
+     active.  Since the reads are collective on the same communicator
+     that the caller uses concurrently, prefetching is only done with
+     a single process: with more processes each configuration is
+     instead read (each process reading its local sub-volume) into a
+     single buffer when it is handed off.
+   */
+  class GaugePrefetcher
+  {
+    /** A single host buffer in the ring */
+    struct Slot {
+      void *gauge[4] = {};  /** QDP-ordered host gauge field */
+      int index = -1;       /** The index of the configuration held in this slot */
+    };
+
+    const std::vector<std::string> filenames;
+    const QudaPrecision precision;
+    const bool synchronous; /** Whether to read on the calling thread when handing off */
+    int X[4];
+
+    std::vector<Slot> slots;
+    std::deque<Slot *> free_slots;  /** Slots available to be read into */
+    std::deque<Slot *> ready_slots; /** Slots holding configurations that have been read */
+    Slot *current = nullptr;        /** Slot handed off to the caller */
+    int consumed = 0;               /** The number of configurations handed off */
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stop = false;
+    std::thread reader;
+
+    /**
+       @brief Read a configuration into a slot
+       @param[in] i The index of the configuration
+       @param[in,out] slot The slot to read into
+    */
+    void read(int i, Slot &slot);
+
+    /**
+       @brief The function run by the background thread: read each
+       file in turn into the next free slot
+    */
+    void read_loop();
+
+  public:
+    /**
+       @brief Allocate the buffers and start reading
+       @param[in] filenames The configurations to read, in the order they will be consumed
+       @param[in] depth The number of configurations to read ahead
+       @param[in] param Gauge parameters describing the host field (cpu_prec and X are used)
+    */
+    GaugePrefetcher(const std::vector<std::string> &filenames, int depth, const QudaGaugeParam &param);
+
+    /**
+       @brief Stop the background thread and free the buffers
+    */
+    ~GaugePrefetcher();
+
+    GaugePrefetcher(const GaugePrefetcher &) = delete;
+    GaugePrefetcher &operator=(const GaugePrefetcher &) = delete;
+
+    /**
+       @brief Hand off the next configuration, blocking until it has
+       been read (or reading it if the reads are synchronous).  The previously handed-off buffer is returned to the
+       ring, so it must no longer be in use.
+       @return Pointer to the array of four QDP-ordered direction
+       pointers, or nullptr if the sequence is exhausted
+    */
+    void **next();
+
+    /**
+       @return The filename of the configuration last handed off
+    */
+    const std::string &filename() const;
+  };
+
+} // namespace quda
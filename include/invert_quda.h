@@ -69,6 +69,13 @@ namespace quda {
     /**< Whether to user alternative reliable updates (CG only at the moment) */
     bool use_alternative_reliable = false;
 
+    /**< Whether to start the sloppy iteration in the preconditioner
+       precision and promote it on stagnation (CG only at the moment) */
+    bool adaptive_precision = false;
+
+    /**< The number of times the sloppy precision was promoted */
+    int adaptive_promotions = 0;
+
     /**< Whether to keep the partial solution accumulator in sloppy precision */
     bool use_sloppy_partial_accumulator = false;
 
@@ -280,6 +287,7 @@ namespace quda {
       compute_null_vector(QUDA_COMPUTE_NULL_VECTOR_NO),
       delta(param.reliable_delta),
       use_alternative_reliable(param.use_alternative_reliable),
+      adaptive_precision(param.adaptive_precision == QUDA_BOOLEAN_TRUE),
       use_sloppy_partial_accumulator(param.use_sloppy_partial_accumulator),
       solution_accumulator_pipeline(param.solution_accumulator_pipeline),
       max_res_increase(param.max_res_increase),
@@ -604,6 +612,14 @@ namespace quda {
     */
     void extendSVDDeflationSpace();
 
+    /**
+       @brief Migrate the deflation space to the requested location,
+       preserving the field order.  Host-resident spaces are
+       allocated in pinned memory and deflated out of core.
+       @param[in] location The location we are migrating to
+    */
+    void migrateDeflationSpace(QudaFieldLocation location);
+
     /**
        @brief Injects a deflation space into the solver from the
        vector argument.  Note the input space is reduced to zero size as a
@@ -719,6 +735,14 @@ namespace quda {
     */
     void create(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b);
 
+    /**
+       @brief Reallocate the sloppy fields in a given precision, used
+       when adaptively promoting the sloppy precision
+       @param[in] x Solution vector, from which the field meta data is taken
+       @param[in] prec The new sloppy precision
+    */
+    void set_sloppy_precision(cvector_ref<ColorSpinorField> &x, QudaPrecision prec);
+
   public:
     CG(const DiracMatrix &mat, const DiracMatrix &matSloppy, const DiracMatrix &matPrecon, const DiracMatrix &matEig,
        SolverParam &param);
@@ -1122,6 +1146,17 @@ namespace quda {
     void computeBeta(std::vector<Complex> &beta, cvector_ref<ColorSpinorField> &Ap, int i, int N, int k);
     void updateAp(std::vector<Complex> &beta, cvector_ref<ColorSpinorField> &Ap, int begin, int size, int k);
     void orthoDir(std::vector<Complex> &beta, cvector_ref<ColorSpinorField> &Ap, int k, int pipeline);
+    /**
+       @brief Orthogonalize Ap[k] against Ap[0, k) for every right
+       hand side.  Without pipelining each kernel is applied to the
+       whole set of right hand sides at once.
+       @param[out] beta The orthogonalization coefficients for each right hand side
+       @param[in,out] Ap The Krylov space, with Ap[j][i] the j-th vector of the i-th right hand side
+       @param[in] k The vector to orthogonalize
+       @param[in] pipeline The pipeline length
+    */
+    void orthoDir(std::vector<std::vector<Complex>> &beta, std::vector<std::vector<ColorSpinorField>> &Ap, int k,
+                  int pipeline);
     void backSubs(const std::vector<Complex> &alpha, const std::vector<Complex> &beta, const std::vector<double> &gamma,
                   std::vector<Complex> &delta, int n);
     void updateSolution(ColorSpinorField &x, const std::vector<Complex> &alpha, const std::vector<Complex> &beta,
@@ -1188,6 +1223,57 @@ namespace quda {
     virtual QudaInverterType getInverterType() const final { return QUDA_MR_INVERTER; }
   };
 
+  /**
+     @brief Chebyshev iteration.  This runs a fixed number of
+     iterations of the Chebyshev polynomial that is optimal on the
+     real interval [ca_lambda_min, ca_lambda_max], so it performs no
+     reductions and is intended as a smoother.  If ca_lambda_max <
+     ca_lambda_min the upper bound is estimated with power iterations
+     on the first call, and if ca_lambda_min is not positive the
+     lower bound is taken as a tenth of the upper bound, so that the
+     upper part of the spectrum is damped.  The polynomial is only
+     bounded on a real interval for a Hermitian positive definite
+     operator, so a non-Hermitian operator M is smoothed through the
+     normal equations M^dag M x = M^dag b, with the bounds applying to
+     M^dag M.  The residual of the original system then never
+     increases.
+   */
+  class Chebyshev : public Solver
+  {
+
+  private:
+    DiracMdagM mdagmSloppy;
+    DiracMdag mdagSloppy;
+    std::vector<ColorSpinorField> r;
+    std::vector<ColorSpinorField> r_sloppy;
+    std::vector<ColorSpinorField> s_sloppy;
+    std::vector<ColorSpinorField> d;
+    std::vector<ColorSpinorField> Ad;
+    std::vector<ColorSpinorField> x_sloppy;
+    bool init = false;
+
+    /**
+       @brief Allocate persistent fields and parameter checking
+       @param[in] x Solution vector
+       @param[in] b Source vector
+     */
+    void create(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b);
+
+  public:
+    Chebyshev(const DiracMatrix &mat, const DiracMatrix &matSloppy, SolverParam &param);
+
+    void operator()(cvector_ref<ColorSpinorField> &out, cvector_ref<const ColorSpinorField> &in) override;
+
+    /**
+       @return Return the residual vector from the prior solve
+    */
+    cvector_ref<const ColorSpinorField> get_residual() override;
+
+    virtual bool hermitian() const override { return false; }
+
+    virtual QudaInverterType getInverterType() const final { return QUDA_CHEBYSHEV_INVERTER; }
+  };
+
   /**
      @brief Communication-avoiding CG solver.  This solver does
      un-preconditioned CG, running in steps of n_krylov, build up a
@@ -1318,6 +1404,63 @@ namespace quda {
     virtual QudaInverterType getInverterType() const final { return QUDA_CA_GCR_INVERTER; }
   };
 
+  /**
+     @brief Block conjugate gradient solver, using the BCGrQ
+     formulation of Dubrulle, where the block residual is kept in
+     factored form R = Q C with Q orthonormal.  The operator is applied
+     to the whole block of search directions at once, so all
+     right-hand sides share each gauge-field read.  Each
+     orthonormalization is rank revealing: directions that are
+     numerically linearly dependent, or whose contribution to every
+     residual is below the tolerance, are deflated from the block, so
+     the block shrinks as the right-hand sides converge.  Reliable
+     updates recompute the true residual in the solver precision and
+     restart the iteration from it.
+   */
+  class BlockCG : public Solver
+  {
+    std::vector<ColorSpinorField> r;        /** True residual */
+    std::vector<ColorSpinorField> x_sloppy; /** Sloppy solution accumulator */
+    std::vector<ColorSpinorField> Q;        /** Orthonormal residual basis */
+    std::vector<ColorSpinorField> S;        /** Search directions */
+    std::vector<ColorSpinorField> Z;        /** Operator applied to the search directions */
+    std::vector<ColorSpinorField> T;        /** Temporary for rotations */
+    bool init = false;
+
+    /**
+       @brief Initiate the fields needed by the solver
+       @param[in] x Solution vector
+       @param[in] b Source vector
+    */
+    void create(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b);
+
+    /**
+       @brief Rank-revealing orthonormalization of the first n vectors
+       of W, using two passes of eigenvalue-based Cholesky QR.  On
+       return the first rank vectors of W are orthonormal and the
+       input satisfies W_in = W_out[0:rank) psi.
+       @param[in,out] W The vectors to orthonormalize
+       @param[in] n The number of vectors
+       @param[out] psi The rank x n triangular-like factor
+       @return The numerical rank
+    */
+    int orthonormalize(std::vector<ColorSpinorField> &W, int n, MatrixXcd &psi);
+
+  public:
+    BlockCG(const DiracMatrix &mat, const DiracMatrix &matSloppy, SolverParam &param);
+
+    void operator()(cvector_ref<ColorSpinorField> &out, cvector_ref<const ColorSpinorField> &in) override;
+
+    /**
+       @return Return the residual from the prior solve
+     */
+    cvector_ref<const ColorSpinorField> get_residual() override;
+
+    virtual bool hermitian() const override { return true; } /** Block CG is only for Hermitian systems */
+
+    virtual QudaInverterType getInverterType() const final { return QUDA_BLOCK_CG_INVERTER; }
+  };
+
   // Steepest descent solver used as a preconditioner
   class SD : public Solver {
   private:
@@ -1529,6 +1672,38 @@ public:
   void chronoExtrapolate(ColorSpinorField &x, const ColorSpinorField &b, std::vector<ColorSpinorField> &basis,
                          DiracMatrix &m, bool hermitian);
 
+  /**
+     @brief Construct the initial guess for a set of sources from a
+     recycled basis of previous solutions, for use when solving many
+     right-hand sides against the same operator.  For a Hermitian
+     operator the guess satisfies the Galerkin condition on the basis,
+     else it minimizes the residual over the basis.
+     @param[out] x The initial guesses
+     @param[in] b The sources we are solving against
+     @param[in] p The orthonormal recycled basis
+     @param[in] q The recycled basis with the operator applied
+     @param[in] hermitian Whether the operator is Hermitian or not
+   */
+  void recycleExtrapolate(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b,
+                          std::vector<ColorSpinorField> &p, std::vector<ColorSpinorField> &q, bool hermitian);
+
+  /**
+     @brief Augment the recycled basis with a set of converged
+     solutions.  Since A x = b holds to within the solver tolerance,
+     the sources are used as the operator images, so no additional
+     operator applications are required.  Once the basis reaches
+     max_dim the oldest entries are evicted.
+     @param[in,out] p The orthonormal recycled basis
+     @param[in,out] q The recycled basis with the operator applied
+     @param[in] x The converged solutions
+     @param[in] b The sources corresponding to the solutions
+     @param[in] max_dim The maximum size of the recycled basis
+     @param[in] tol The relative norm below which a new direction is discarded
+   */
+  void recycleAugment(std::vector<ColorSpinorField> &p, std::vector<ColorSpinorField> &q,
+                      cvector_ref<const ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b, int max_dim,
+                      double tol);
+
   using ColorSpinorFieldSet = ColorSpinorField;
 
   //forward declaration
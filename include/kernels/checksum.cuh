@@ -0,0 +1,262 @@
+#pragma once
+
+#include <gauge_field_order.h>
+#include <color_spinor_field_order.h>
+#include <clover_field_order.h>
+#include <quda_matrix.h>
+#include <index_helper.cuh>
+#include <reduction_kernel.h>
+
+/**
+   @file checksum.cuh
+
+   Kernels for computing field checksums.  Two flavours are supported:
+
+   - A XOR checksum, where each 64-bit word of the site-local data (in
+     register precision) is XOR-ed together.  This is independent of
+     the field order and location, so host and device copies of the
+     same field return the same checksum.
+
+   - The SciDAC checksum used by QIO records: the CRC-32 of each
+     site's big-endian record data is rotated by the site's global
+     lexicographical rank modulo 29 and 31 respectively, and these
+     are XOR-ed together to give the pair (suma, sumb).
+
+   Since XOR is associative and commutative both flavours are
+   computed as regular parallel reductions, with each 32-bit word of
+   the result carried as a double (see checksum_xor in reducer.h).
+ */
+
+namespace quda
+{
+
+  using checksum_t = array<double, 2>;
+
+  /**
+     @brief Split a 64-bit checksum into the pair of 32-bit words used as the reduction type
+     @param[in] c The 64-bit checksum
+     @return The checksum as a reduction value
+   */
+  __device__ __host__ inline checksum_t checksum_split(uint64_t c)
+  {
+    return {static_cast<double>(c & 0xffffffff), static_cast<double>(c >> 32)};
+  }
+
+  /**
+     @brief Return 64-bit XOR checksum of the words that constitute v
+     @param[in] v The object we are computing the checksum of
+   */
+  template <typename T> __device__ __host__ inline uint64_t word_checksum(const T &v)
+  {
+    // ensure length is rounded up to 64-bit multiple
+    constexpr int length = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    uint64_t base[length] = {};
+    memcpy(base, &v, sizeof(T));
+    uint64_t checksum = base[0];
+#pragma unroll
+    for (int i = 1; i < length; i++) checksum ^= base[i];
+    return checksum;
+  }
+
+  /**
+     @brief Bitwise CRC-32 (IEEE 802.3 polynomial, as used by zlib
+     and hence the SciDAC checksum) that is fed one byte at a time, so
+     the record can be streamed through without staging it in a
+     buffer.
+   */
+  struct crc32_t {
+    uint32_t crc = 0xffffffff;
+
+    __device__ __host__ inline void operator()(unsigned char byte)
+    {
+      crc ^= byte;
+#pragma unroll
+      for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1u)));
+    }
+
+    /**
+       @brief Accumulate the big-endian representation of x (the
+       SciDAC byte order), assuming a little-endian target
+     */
+    template <typename Float> __device__ __host__ inline void big_endian(Float x)
+    {
+      unsigned char bytes[sizeof(Float)];
+      memcpy(bytes, &x, sizeof(Float));
+#pragma unroll
+      for (int i = sizeof(Float) - 1; i >= 0; i--) operator()(bytes[i]);
+    }
+
+    __device__ __host__ inline uint32_t value() const { return ~crc; }
+  };
+
+  /**
+     @brief 32-bit left rotation (well defined for r = 0)
+   */
+  __device__ __host__ inline uint32_t rotl32(uint32_t x, unsigned int r) { return r ? (x << r) | (x >> (32 - r)) : x; }
+
+  /**
+     @brief Return the SciDAC checksum contribution {suma, sumb} of a
+     site record with the given CRC-32 and global lexicographical rank
+   */
+  __device__ __host__ inline checksum_t scidac_checksum(uint32_t crc, uint64_t rank)
+  {
+    return {static_cast<double>(rotl32(crc, rank % 29)), static_cast<double>(rotl32(crc, rank % 31))};
+  }
+
+  /**
+     @brief Base argument struct for checksum kernels, holds the
+     information required to compute the global rank of each site
+   */
+  template <bool scidac_> struct ChecksumArg : ReduceArg<checksum_t> {
+    static constexpr bool scidac = scidac_;
+    int X[4];         // local lattice dimensions
+    int X_global[4];  // global lattice dimensions
+    int X_offset[4];  // global coordinate of the local origin
+
+    ChecksumArg(const LatticeField &field, int threads_x, int threads_y) :
+      ReduceArg<checksum_t>(dim3(threads_x, threads_y, 1), 1, true) // reset since we reuse the arg when tuning
+    {
+      for (int d = 0; d < 4; d++) {
+        X[d] = field.X()[d];
+        X_global[d] = comm_dim(d) * X[d];
+        X_offset[d] = comm_coord(d) * X[d];
+      }
+    }
+  };
+
+  /**
+     @brief Return the global lexicographical rank (x fastest) of a given site
+   */
+  template <typename Arg> __device__ __host__ inline uint64_t global_rank(const Arg &arg, int x_cb, int parity)
+  {
+    int x[4];
+    getCoords(x, x_cb, arg.X, parity);
+    uint64_t rank = 0;
+#pragma unroll
+    for (int d = 3; d >= 0; d--) rank = rank * arg.X_global[d] + x[d] + arg.X_offset[d];
+    return rank;
+  }
+
+  template <typename Float_, int nColor_, typename G_, bool scidac>
+  struct GaugeChecksumArg : ChecksumArg<scidac> {
+    using Float = Float_;
+    using real = typename mapper<Float>::type;
+    static constexpr int nColor = nColor_;
+    using G = G_;
+    const G U;
+    const int geometry;
+
+    GaugeChecksumArg(const GaugeField &U, bool mini) :
+      ChecksumArg<scidac>(U, mini ? 1 : U.VolumeCB(), 2), U(U), geometry(U.Geometry())
+    {
+    }
+  };
+
+  template <typename Arg> struct GaugeChecksum : checksum_xor<typename Arg::reduce_t> {
+    using reduce_t = typename Arg::reduce_t;
+    using checksum_xor<reduce_t>::operator();
+    static constexpr int reduce_block_dim = 2; // x_cb in x, parity in y
+    const Arg &arg;
+    constexpr GaugeChecksum(const Arg &arg) : arg(arg) { }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline reduce_t operator()(reduce_t &value, int x_cb, int parity)
+    {
+      using Link = Matrix<complex<typename Arg::real>, Arg::nColor>;
+
+      if constexpr (Arg::scidac) {
+        // record layout is [dir][row][col][complex]
+        crc32_t crc;
+        for (int d = 0; d < arg.geometry; d++) {
+          const Link u = arg.U(d, x_cb, parity);
+#pragma unroll
+          for (int i = 0; i < Arg::nColor * Arg::nColor; i++) {
+            crc.big_endian(static_cast<typename Arg::Float>(u(i).real()));
+            crc.big_endian(static_cast<typename Arg::Float>(u(i).imag()));
+          }
+        }
+        return operator()(scidac_checksum(crc.value(), global_rank(arg, x_cb, parity)), value);
+      } else {
+        uint64_t checksum = 0;
+        for (int d = 0; d < arg.geometry; d++) {
+          const Link u = arg.U(d, x_cb, parity);
+          checksum ^= u.checksum();
+        }
+        return operator()(checksum_split(checksum), value);
+      }
+    }
+  };
+
+  template <typename Float_, int nSpin_, int nColor_, typename V_, bool scidac>
+  struct SpinorChecksumArg : ChecksumArg<scidac> {
+    using Float = Float_;
+    using real = typename mapper<Float>::type;
+    static constexpr int nSpin = nSpin_;
+    static constexpr int nColor = nColor_;
+    using V = V_;
+    const V v;
+
+    SpinorChecksumArg(const ColorSpinorField &v, bool mini) :
+      ChecksumArg<scidac>(v, mini ? 1 : v.VolumeCB(), v.SiteSubset()), v(v)
+    {
+    }
+  };
+
+  template <typename Arg> struct SpinorChecksum : checksum_xor<typename Arg::reduce_t> {
+    using reduce_t = typename Arg::reduce_t;
+    using checksum_xor<reduce_t>::operator();
+    static constexpr int reduce_block_dim = 2; // x_cb in x, parity in y
+    const Arg &arg;
+    constexpr SpinorChecksum(const Arg &arg) : arg(arg) { }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline reduce_t operator()(reduce_t &value, int x_cb, int parity)
+    {
+      array<complex<typename Arg::real>, Arg::nSpin * Arg::nColor> v;
+      arg.v.load(v.data, x_cb, parity);
+
+      if constexpr (Arg::scidac) {
+        // record layout is [spin][color][complex]
+        crc32_t crc;
+#pragma unroll
+        for (int i = 0; i < Arg::nSpin * Arg::nColor; i++) {
+          crc.big_endian(static_cast<typename Arg::Float>(v[i].real()));
+          crc.big_endian(static_cast<typename Arg::Float>(v[i].imag()));
+        }
+        return operator()(scidac_checksum(crc.value(), global_rank(arg, x_cb, parity)), value);
+      } else {
+        return operator()(checksum_split(word_checksum(v)), value);
+      }
+    }
+  };
+
+  template <typename Float_, typename C_> struct CloverChecksumArg : ChecksumArg<false> {
+    using Float = Float_;
+    using real = typename mapper<Float>::type;
+    static constexpr int length = 72;
+    using C = C_;
+    const C clover;
+
+    CloverChecksumArg(const CloverField &clover, bool inverse, bool mini) :
+      ChecksumArg<false>(clover, mini ? 1 : clover.VolumeCB(), 2), clover(clover, inverse)
+    {
+    }
+  };
+
+  template <typename Arg> struct CloverChecksum : checksum_xor<typename Arg::reduce_t> {
+    using reduce_t = typename Arg::reduce_t;
+    using checksum_xor<reduce_t>::operator();
+    static constexpr int reduce_block_dim = 2; // x_cb in x, parity in y
+    const Arg &arg;
+    constexpr CloverChecksum(const Arg &arg) : arg(arg) { }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    __device__ __host__ inline reduce_t operator()(reduce_t &value, int x_cb, int parity)
+    {
+      array<typename Arg::real, Arg::length> a;
+      arg.clover.load(a.data, x_cb, parity);
+      return operator()(checksum_split(word_checksum(a)), value);
+    }
+  };
+
+} // namespace quda
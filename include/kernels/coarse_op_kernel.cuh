@@ -65,6 +65,7 @@ namespace quda {
     int xc_size[QUDA_MAX_DIM];  /** Dimensions of coarse grid */
 
     int_fastdiv geo_bs[QUDA_MAX_DIM];   /** Geometric block dimensions */
+    int geo_offset[QUDA_MAX_DIM];       /** Offset of the aggregates from the origin */
     const int spin_bs;          /** Spin block size */
     const spin_mapper<fineSpin,coarseSpin> spin_map; /** Helper that maps fine spin to coarse spin */
 
@@ -160,6 +161,7 @@ namespace quda {
        @param[in] xc_size_ Coarse-grid geometric dimensions
        @param[in] fine_to_coarse Pointer to fine-to-coarse look-up table (memory space is same compute)
        @param[in] coarse_to_fine Pointer to coarse-to-fine look-up table (memory space is same compute)
+       @param[in] geo_offset_ Offset of the aggregates from the origin (nullptr for no offset)
        @param[in] bidirectional Whether the operator we are coarsening requires bi-directional coarsening
      */
     CalculateYArg(coarseGauge &Y, coarseGauge &X,
@@ -167,7 +169,7 @@ namespace quda {
       fineSpinorUV &UV, fineSpinorAV &AV, const fineGauge &U, const fineGauge &L, const fineGauge &K, const fineSpinorV &V,
       const fineClover &C, const fineClover &Cinv, const ColorSpinorField &v, double kappa, double mass, double mu, double mu_factor,
       const int *x_size_, const int *xc_size_, int spin_bs_,
-      const int *fine_to_coarse, const int *coarse_to_fine, bool bidirectional)
+      const int *fine_to_coarse, const int *coarse_to_fine, const int *geo_offset_, bool bidirectional)
       : Y(Y), X(X), Y_atomic(Y_atomic), X_atomic(X_atomic),
       UV(UV), AV(AV), U(U), L(L), K(K), V(V), C(C), Cinv(Cinv), spin_bs(spin_bs_), spin_map(),
       kappa(static_cast<Float>(kappa)), mass(static_cast<Float>(mass)), mu(static_cast<Float>(mu)), mu_factor(static_cast<Float>(mu_factor)),
@@ -182,6 +184,7 @@ namespace quda {
         x_size[i] = i < 4 ? x_size_[i] : 1;
         xc_size[i] = i < 4 ? xc_size_[i] : 1;
         geo_bs[i] = x_size[i] / xc_size[i];
+        geo_offset[i] = i < 4 && geo_offset_ ? geo_offset_[i] : 0;
         comm_dim[i] = i < 4 ? comm_dim_partitioned(i) : 1;
       }
     }
@@ -228,14 +231,31 @@ namespace quda {
   template <typename Arg> constexpr bool isCoarseDiagonal(const int coord[], const int coord_coarse[], int dim, int nFace, const Arg &arg)
   {
     switch (dim) {
-    case 0: return ((coord[0] + nFace) % arg.x_size[0]) / arg.geo_bs[0] == coord_coarse[0];
-    case 1: return ((coord[1] + nFace) % arg.x_size[1]) / arg.geo_bs[1] == coord_coarse[1];
-    case 2: return ((coord[2] + nFace) % arg.x_size[2]) / arg.geo_bs[2] == coord_coarse[2];
-    case 3: return ((coord[3] + nFace) % arg.x_size[3]) / arg.geo_bs[3] == coord_coarse[3];
+    case 0: return ((coord[0] + nFace + arg.x_size[0] - arg.geo_offset[0]) % arg.x_size[0]) / arg.geo_bs[0] == coord_coarse[0];
+    case 1: return ((coord[1] + nFace + arg.x_size[1] - arg.geo_offset[1]) % arg.x_size[1]) / arg.geo_bs[1] == coord_coarse[1];
+    case 2: return ((coord[2] + nFace + arg.x_size[2] - arg.geo_offset[2]) % arg.x_size[2]) / arg.geo_bs[2] == coord_coarse[2];
+    case 3: return ((coord[3] + nFace + arg.x_size[3] - arg.geo_offset[3]) % arg.x_size[3]) / arg.geo_bs[3] == coord_coarse[3];
     }
     return false;
   }
 
+  /**
+     @brief Helper for computing the coarse-grid coordinates of the
+     aggregate that a fine-grid site belongs to.  The aggregates may
+     be offset from the origin, in which case they wrap around the
+     (unpartitioned) dimension.
+
+     @param[out] coord_coarse Coarse grid coordinates
+     @param[in] coord Fine grid coordinates
+     @param[in] arg Kernel argument
+  */
+  template <typename Arg> __device__ __host__ inline void getCoarseCoords(int coord_coarse[], const int coord[], const Arg &arg)
+  {
+#pragma unroll
+    for (int d = 0; d < 4; d++)
+      coord_coarse[d] = ((coord[d] + arg.x_size[d] - arg.geo_offset[d]) % arg.x_size[d]) / arg.geo_bs[d];
+  }
+
   /**
      @brief Calculates the matrix UV^{s,c'}_mu(x) = \sum_c U^{c}_mu(x) * V^{s,c}_mu(x+mu) for Wilson-type fermions
      Where: mu = dim, s = fine spin, c' = coarse color, c = fine color
@@ -1593,7 +1613,7 @@ namespace quda {
     int coord_coarse[QUDA_MAX_DIM];
 
     getCoords(coord, x_cb, arg.x_size, parity);
-    for (int d = 0; d < nDim; d++) coord_coarse[d] = coord[d]/arg.geo_bs[d];
+    getCoarseCoords(coord_coarse, coord, arg);
 
     //Check to see if we are on the edge of a block.  If adjacent site
     //is in same block, M = X, else M = Y
@@ -1733,6 +1753,75 @@ namespace quda {
     }
   };
 
+  /**
+     @brief Host accumulation of the coarse links for a single
+     aggregate.  Rather than parallelizing over fine-grid sites, where
+     every fine site of an aggregate updates the same coarse site and
+     so the atomic accumulation serializes, we walk the fine sites of
+     the aggregate using the coarse-to-fine map.  Fine sites of both
+     parities contribute to the same coarse links, so both parities
+     are walked by the same thread: each tile of the coarse links of
+     an aggregate is then written by a single thread, and remains in
+     cache while it is accumulated.
+     @param[in] arg Kernel argument
+     @param[in] x_coarse Full coarse-grid spacetime index of the aggregate
+     @param[in] c_row output coarse color row
+     @param[in] c_col output coarse color column
+  */
+  template <int nFace, typename Arg>
+  __host__ inline void computeVUVAggregate(const Arg &arg, int x_coarse, int c_row, int c_col)
+  {
+    if (c_row >= arg.vuvTile.M_tiles) return;
+    if (c_col >= arg.vuvTile.N_tiles) return;
+
+    // assume that coarse_to_fine look up map is ordered as (coarse-block-id + fine-point-id)
+    // and that fine-point-id is parity ordered (see getIndices<true>)
+    const int aggregate_size_cb = arg.fineVolumeCB / arg.coarseVolumeCB / 2;
+    for (int parity = 0; parity < 2; parity++) {
+      const int *fine = arg.coarse_to_fine + (x_coarse * 2 + parity) * aggregate_size_cb;
+      for (int i = 0; i < aggregate_size_cb; i++) {
+        int x_cb = fine[i] - parity * arg.fineVolumeCB;
+        computeVUV<nFace>(arg, parity, x_cb, c_row * arg.vuvTile.M, c_col * arg.vuvTile.N, 0, 0);
+      }
+    }
+  }
+
+  template <typename Arg> struct compute_vuv_aggregate {
+    static constexpr int nFace = 1;
+    const Arg &arg;
+    static constexpr const char *filename() { return KERNEL_FILE; }
+    constexpr compute_vuv_aggregate(const Arg &arg) : arg(arg) { }
+
+    /**
+       3-d parallelism (host only)
+       @param[in] x_coarse coarse-grid spacetime
+       @param[in] c_row output color row
+       @param[in] c_col output coarse color column
+    */
+    __host__ inline void operator()(int x_coarse, int c_row, int c_col)
+    {
+      computeVUVAggregate<nFace>(arg, x_coarse, c_row, c_col);
+    }
+  };
+
+  template <typename Arg> struct compute_vlv_aggregate {
+    static constexpr int nFace = 3;
+    const Arg &arg;
+    static constexpr const char *filename() { return KERNEL_FILE; }
+    constexpr compute_vlv_aggregate(const Arg &arg) : arg(arg) { }
+
+    /**
+       3-d parallelism (host only)
+       @param[in] x_coarse coarse-grid spacetime
+       @param[in] c_row output color row
+       @param[in] c_col output coarse color column
+    */
+    __host__ inline void operator()(int x_coarse, int c_row, int c_col)
+    {
+      computeVUVAggregate<nFace>(arg, x_coarse, c_row, c_col);
+    }
+  };
+
   template <typename Arg> struct compute_coarse_clover {
     static_assert(!Arg::from_coarse, "computeCoarseClover is only defined on the fine grid");
     const Arg &arg;
@@ -1756,7 +1845,7 @@ namespace quda {
       int coord_coarse[QUDA_MAX_DIM];
 
       getCoords(coord, x_cb, arg.x_size, parity);
-      for (int d = 0; d < nDim; d++) coord_coarse[d] = coord[d]/arg.geo_bs[d];
+      getCoarseCoords(coord_coarse, coord, arg);
 
       int coarse_parity = 0;
       for (int d = 0; d < nDim; d++) coarse_parity += coord_coarse[d];
@@ -181,7 +181,7 @@ namespace quda
         int coord_coarse[QUDA_MAX_DIM];
 
         getCoords(coord, x_cb, arg.x_size, parity);
-        for (int d = 0; d < nDim; d++) coord_coarse[d] = coord[d] / arg.geo_bs[d];
+        getCoarseCoords(coord_coarse, coord, arg);
 
         constexpr bool isFromCoarseClover = Arg::dir == QUDA_IN_PLACE;
 
@@ -97,6 +97,42 @@ namespace quda {
     }
   };
 
+  /**
+     @brief Cache-blocked host gauge reordering.  Gauge orders differ
+     in whether the link direction or the site index runs fastest
+     (e.g., MILC is site major whereas QDP is direction major), so
+     there is no single loop order that streams through both the
+     input and output fields.  We instead split the checkerboard into
+     blocks of sites whose input and output links fit in cache, and
+     copy all directions of a block before moving on to the next.
+     OpenMP threads are distributed over the (parity, block) pairs.
+     @param[in] arg Kernel argument struct
+     @param[in] block_bytes The target working-set size of each block
+  */
+  template <typename Arg> void CopyGaugeHost(const Arg &arg, size_t block_bytes = 64 * 1024)
+  {
+    CopyGauge_<Arg> f(arg);
+    const int volume_cb = arg.threads.x;
+    const int geometry = arg.geometry;
+    constexpr int n_row = Arg::fine_grain ? Arg::nColor : 1;
+    const size_t site_bytes
+      = geometry * Arg::length * (sizeof(typename Arg::real_in_t) + sizeof(typename Arg::real_out_t));
+    const int block = std::max(1, static_cast<int>(block_bytes / site_bytes));
+    const int n_block = (volume_cb + block - 1) / block;
+
+#pragma omp parallel for collapse(2) schedule(static)
+    for (int parity = 0; parity < 2; parity++) {
+      for (int b = 0; b < n_block; b++) {
+        const int x_end = std::min((b + 1) * block, volume_cb);
+        for (int d = 0; d < geometry; d++) {
+          for (int x = b * block; x < x_end; x++) {
+            for (int i = 0; i < n_row; i++) f(x, i, parity * geometry + d);
+          }
+        }
+      }
+    }
+  }
+
   /**
      @brief Generic gauge ghost reordering and packing
   */
@@ -538,6 +538,35 @@ namespace quda {
     */
     static void freeGhostBuffer(void);
 
+    /**
+       The static ghost buffers and inter-process communication
+       handlers of a communicator, retained by its owner while another
+       communicator is in use.  The scratch buffers buffer_send_p2p
+       and buffer_recv_p2p are only used transiently, so they are
+       shared between communicators.
+    */
+    struct GhostState {
+      array<void *, 2> send_d, recv_d, pinned_send_h, pinned_recv_h, pinned_send_hd, pinned_recv_hd;
+      array_3d<void *, 2, QUDA_MAX_DIM, 2> remote_send_d;
+      size_t bytes;
+      bool init_ghost;
+      array_3d<MsgHandle *, 2, QUDA_MAX_DIM, 2> mh_recv, mh_send;
+      array_3d<qudaEvent_t, 2, QUDA_MAX_DIM, 2> copy_event, remote_copy_event;
+      bool init_ipc;
+      bool reset;
+    };
+
+    /**
+       @brief Exchange the static ghost buffers and inter-process
+       communication handlers with a retained state.  Swapping on
+       every switch between a pair of communicators keeps the state of
+       both, so that neither reallocates its buffers or recreates its
+       handlers.  The retained state is owned by the caller, which must
+       swap it back in to free it.
+       @param[in,out] state The retained state
+    */
+    static void swapGhostBuffer(GhostState &state);
+
     /**
        Create the communication handlers (both host and device)
        @param[in] no_comms_fill Whether to allocate halo buffers for
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+
+namespace quda
+{
+
+  struct MGParam;
+
+  /**
+     @brief Header written at the start of each multigrid checkpoint
+     file.  This records the information required to validate that a
+     checkpoint is being restored into a compatible hierarchy.
+   */
+  struct MGCheckpointHeader {
+    char magic[8];           /** File identifier */
+    int version;             /** Version of the checkpoint format */
+    int level;               /** The multigrid level this checkpoint corresponds to */
+    int n_level;             /** The number of levels in the hierarchy */
+    int rank;                /** The rank that wrote this file */
+    int comm_dim[4];         /** The process grid */
+    int X[4];                /** The local fine-grid dimensions on this level */
+    uint64_t gauge_checksum; /** Checksum of the fine gauge field (and long links for improved staggered) */
+    uint64_t param_key;      /** Hash of the multigrid and operator parameters that define the hierarchy */
+  };
+
+  /**
+     @brief Each record (field) of a checkpoint is prefixed with its
+     precision and size in bytes, which are checked on restore
+   */
+  struct MGCheckpointRecord {
+    int precision;
+    uint64_t bytes;
+  };
+
+  /**
+     @brief MGCheckpoint is a simple wrapper for saving and restoring
+     the components of a multigrid level (the prolongator V and the
+     coarse link fields Y, X, Xinv and Yhat).  Each rank writes its
+     local data to its own file, so the checkpoint can only be
+     restored using the same process grid that wrote it.  Fields are
+     read and written in the order they are passed, and each record is
+     prefixed with its length to catch any inconsistency on restore.
+   */
+  class MGCheckpoint
+  {
+    const std::string filename;
+    const bool write;
+    FILE *fp = nullptr;
+
+    void write_bytes(const void *data, size_t bytes);
+    void read_bytes(void *data, size_t bytes);
+
+  public:
+    /**
+       @brief Constructor for the MGCheckpoint class
+       @param[in] prefix The filename prefix of the checkpoint
+       @param[in] level The multigrid level we are reading or writing
+       @param[in] write Whether we are writing (true) or reading (false)
+    */
+    MGCheckpoint(const std::string &prefix, int level, bool write);
+
+    /**
+       @brief Destructor closes the underlying file
+    */
+    ~MGCheckpoint();
+
+    MGCheckpoint(const MGCheckpoint &) = delete;
+    MGCheckpoint &operator=(const MGCheckpoint &) = delete;
+
+    /**
+       @return Whether the underlying file was successfully opened
+    */
+    bool is_open() const { return fp != nullptr; }
+
+    /**
+       @return The filename of this checkpoint
+    */
+    const std::string &Filename() const { return filename; }
+
+    /**
+       @brief Write the checkpoint header for the given level
+       @param[in] param The parameters of the level being saved
+    */
+    void save_header(const MGParam &param);
+
+    /**
+       @brief Read and validate the checkpoint header for the given
+       level against the present gauge field and parameters
+       @param[in] param The parameters of the level being restored
+       @return Whether the checkpoint is compatible with param
+    */
+    bool load_header(const MGParam &param);
+
+    /**
+       @brief Save a color-spinor field.  Device fields are saved via
+       a host copy in QUDA_SPACE_SPIN_COLOR_FIELD_ORDER.
+       @param[in] v The field to save
+    */
+    void save(const ColorSpinorField &v);
+
+    /**
+       @brief Restore a color-spinor field
+       @param[in,out] v The field to restore (pre-allocated)
+    */
+    void load(ColorSpinorField &v);
+
+    /**
+       @brief Save a gauge field.  Fields are saved via a host copy in
+       QUDA_MILC_GAUGE_ORDER, excluding any halo region.
+       @param[in] u The field to save
+    */
+    void save(const GaugeField &u);
+
+    /**
+       @brief Restore a gauge field.  Note the halo region is not
+       restored, so the caller must exchange ghosts if required.
+       @param[in,out] u The field to restore (pre-allocated)
+    */
+    void load(GaugeField &u);
+  };
+
+  /**
+     @brief Compute a hash of the parameters that define the coarse
+     operators of a given multigrid level.  This includes the fine
+     operator parameters (e.g., kappa, mass, mu, c_sw) and the
+     coarsening parameters (block size, number of vectors, setup
+     location, etc.) for all levels up to and including this one.
+     The gauge fields, including the long links that carry the Naik
+     term of improved staggered fermions, are validated separately by
+     their checksum.
+     @param[in] param The parameters of the level in question
+     @return The parameter hash
+  */
+  uint64_t mgCheckpointKey(const MGParam &param);
+
+} // namespace quda
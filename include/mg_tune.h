@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <quda.h>
+#include <quda_internal.h>
+
+namespace quda
+{
+
+  /**
+     @brief The multigrid parameters that are varied when tuning,
+     one level at a time
+   */
+  enum class MGTuneKnob { geo_block_size, n_vec, setup_maxiter, nu_pre, nu_post };
+
+  /**
+     @brief The measured performance of a set of multigrid parameters
+   */
+  struct MGTuneResult {
+    double setup_secs = 0.0;               /** Time to set up the multigrid hierarchy */
+    double solve_secs = 0.0;               /** Mean time per probe solve */
+    double iter = 0.0;                     /** Mean number of outer iterations per probe solve */
+    bool converged = false;                /** Whether every probe solve converged */
+    double factor[QUDA_MAX_MG_LEVEL] = {}; /** The convergence factor of each level */
+
+    /**
+       @brief The time to solution for a setup that is reused for
+       n_solve solves, which is infinite if a probe solve did not
+       converge
+       @param[in] n_solve The number of solves the setup is amortized over
+     */
+    double cost(int n_solve) const;
+  };
+
+  /**
+     @brief Return the key under which tuned multigrid parameters are
+     cached: this identifies the ensemble by the global lattice
+     dimensions, the action parameters and the (rounded) plaquette,
+     together with the process grid, the precisions, and the smoother,
+     coarse solver and cycle of each level, since these determine
+     which parameters are fastest.
+     @param[in] mg_param The multigrid parameters
+     @param[in] param The outer solver parameters
+     @param[in] X The local lattice dimensions
+     @param[in] plaquette The plaquette of the gauge field
+     @return The cache key
+   */
+  std::string mgTuneKey(const QudaMultigridParam &mg_param, const QudaInvertParam &param, const lat_dim_t &X,
+                        double plaquette);
+
+  /**
+     @brief Return the candidate parameters that vary a single knob
+     on a single level from the given parameters.  Candidates that
+     cannot be instantiated (block sizes that do not divide the
+     lattice into an even number of blocks, null-space vector counts
+     that are not compiled or exceed the aggregate size) are omitted.
+     @param[in] mg_param The present multigrid parameters
+     @param[in] level The level to vary
+     @param[in] knob The parameter to vary
+     @param[in] X The local fine-grid lattice dimensions
+     @return The candidate parameters
+   */
+  std::vector<QudaMultigridParam> mgTuneCandidates(const QudaMultigridParam &mg_param, int level, MGTuneKnob knob,
+                                                   const lat_dim_t &X);
+
+  /**
+     @brief Look up tuned multigrid parameters in the cache, which
+     is the file mg_tunecache.json in QUDA_RESOURCE_PATH
+     @param[in] key The cache key
+     @param[in,out] mg_param The multigrid parameters, overwritten with the cached ones if found
+     @param[out] result The cached performance of these parameters
+     @return Whether the key was found
+   */
+  bool mgTuneCacheLoad(const std::string &key, QudaMultigridParam &mg_param, MGTuneResult &result);
+
+  /**
+     @brief Add tuned multigrid parameters to the cache
+     @param[in] key The cache key
+     @param[in] mg_param The tuned multigrid parameters
+     @param[in] result The performance of these parameters
+   */
+  void mgTuneCacheSave(const std::string &key, const QudaMultigridParam &mg_param, const MGTuneResult &result);
+
+  /**
+     @brief Write tuned multigrid parameters to a JSON file, in the
+     same format as a cache entry
+     @param[in] filename The file to write
+     @param[in] key The cache key
+     @param[in] mg_param The tuned multigrid parameters
+     @param[in] result The performance of these parameters
+   */
+  void mgTuneWrite(const std::string &filename, const std::string &key, const QudaMultigridParam &mg_param,
+                   const MGTuneResult &result);
+
+} // namespace quda
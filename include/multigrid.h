@@ -6,6 +6,8 @@
 #include <complex_quda.h>
 #include <memory>
 #include <instantiate.h>
+#include <mg_checkpoint.h>
+#include <communicator_quda.h>
 
 // at the moment double-precision multigrid is only enabled when debugging
 #ifdef HOST_DEBUG
@@ -172,6 +174,14 @@ namespace quda {
     /** Whether to use tensor cores (if available) for dslash */
     bool dslash_use_mma;
 
+    /** Checksum of the fine gauge field, used to validate multigrid checkpoints */
+    uint64_t gauge_checksum = 0;
+
+    /** Whether this level may be restored from a checkpoint: this is
+        false if a finer level was rebuilt, since the checkpointed
+        coarse space would then not be consistent with it */
+    bool checkpoint_restore = true;
+
     /**
        This is top level instantiation done when we start creating the multigrid operator.
      */
@@ -242,7 +252,8 @@ namespace quda {
       mg_vec_partfile(param.mg_global.mg_vec_partfile[level]),
       transfer_type(param.mg_global.transfer_type[level]),
       setup_use_mma(param.mg_global.setup_use_mma[level] == QUDA_BOOLEAN_TRUE),
-      dslash_use_mma(param.mg_global.dslash_use_mma[level] == QUDA_BOOLEAN_TRUE)
+      dslash_use_mma(param.mg_global.dslash_use_mma[level] == QUDA_BOOLEAN_TRUE),
+      gauge_checksum(param.gauge_checksum)
     {
       // set the block size
       for (int i = 0; i < QUDA_MAX_DIM; i++) geoBlockSize[i] = param.mg_global.geo_block_size[level][i];
@@ -267,6 +278,9 @@ namespace quda {
     /** This tell to reset() if transfer needs to be rebuilt */
     bool resetTransfer = false;
 
+    /** Convergence factor probed after this level was last built, used to decide on an incremental refresh */
+    double convergence_factor = 0.0;
+
     /** This is the smoother used */
     Solver *presmoother = nullptr;
 
@@ -308,6 +322,36 @@ namespace quda {
     /** Coarse solution vector set */
     std::vector<ColorSpinorField> x_coarse;
 
+    /** Coarse residual vector set after a V-cycle, used by the adaptive cycle */
+    std::vector<ColorSpinorField> y_coarse;
+
+    /** Grid of sub-partitions the next coarser level is agglomerated onto */
+    CommKey agglomerate_key = default_comm_key;
+
+    /** The coarse-grid null-space vectors on the agglomerated grid */
+    std::vector<ColorSpinorField> B_agglomerate;
+
+    /** Coarse residual vector set on the agglomerated grid */
+    std::vector<ColorSpinorField> r_agglomerate;
+
+    /** Coarse solution vector set on the agglomerated grid */
+    std::vector<ColorSpinorField> x_agglomerate;
+
+    /** Host staging fields for the coarse vector set collected onto the agglomerated grid */
+    std::vector<ColorSpinorField> coarse_collected;
+
+    /** Host staging fields for the coarse vector set on the unsplit grid */
+    std::vector<ColorSpinorField> coarse_host;
+
+    /** Ghost buffers and communication handlers retained for whichever
+        of the communicators of this level and the agglomerated grid is
+        not in use */
+    mutable LatticeField::GhostState comm_ghost = {};
+
+    /** Field temporaries retained for whichever of the communicators
+        of this level and the agglomerated grid is not in use */
+    mutable FieldTmp<ColorSpinorField>::cache_t comm_tmp;
+
     /** Kahler-Dirac Xinv */
     std::shared_ptr<GaugeField> xInvKD;
 
@@ -344,6 +388,9 @@ namespace quda {
     /** Parallel hyper-cubic random number generator for generating null-space vectors */
     RNG *rng = nullptr;
 
+    /** Checkpoint from which this level is being restored (only set during construction) */
+    MGCheckpoint *checkpoint = nullptr;
+
     /**
        @brief Helper function called on entry to each MG function
        @param[in] level The level we working on
@@ -355,6 +402,86 @@ namespace quda {
     */
     void popLevel() const;
 
+    /**
+       @return Whether the next coarser level is agglomerated onto a split grid
+    */
+    bool agglomerated() const { return !(agglomerate_key == default_comm_key); }
+
+    /**
+       @brief Switch to the communicator of the next coarser level,
+       which only differs if that level is agglomerated.  The state
+       retained for that communicator is swapped in, so it is only
+       freed by an ordinary switch away from it.
+       @param[in] retain Whether to retain the communication state of
+       this level for reuse, used when switching on every cycle
+    */
+    void pushCoarseCommunicator(bool retain = false) const;
+
+    /**
+       @brief Switch back to the communicator of this level
+       @param[in] retain Whether to retain the communication state of
+       the coarser level for reuse, used when switching on every cycle
+    */
+    void popCoarseCommunicator(bool retain = false) const;
+
+    /**
+       @return Whether the coarse grid of this level is solved with
+       the adaptive cycle, i.e., a V-cycle that is only followed by a
+       flexible Krylov solve (K-cycle) when its residual reduction
+       falls short of the threshold
+    */
+    bool adaptiveCycle() const
+    {
+      return param.cycle_type == QUDA_MG_CYCLE_ADAPTIVE && param.level < param.Nlevel - 2;
+    }
+
+    /**
+       @brief Solve on the next coarser grid, either with the coarse
+       solver, or with the adaptive cycle.  For the latter a single
+       V-cycle is applied, and if it reduced the residual of any
+       right hand side by less than the threshold the remaining error
+       is solved for with the flexible Krylov coarse solver, which
+       itself is preconditioned by the V-cycle.
+       @param[out] x The coarse solution vector set
+       @param[in,out] r The coarse residual vector set, which is
+       overwritten with the adaptive cycle
+    */
+    void coarseCycle(cvector_ref<ColorSpinorField> &x, cvector_ref<ColorSpinorField> &r);
+
+    /**
+       @brief Create the agglomerated copies of the coarse-grid
+       null-space vectors and the coarse residual and solution
+       vectors.  This is called with the communicator of this level.
+    */
+    void createAgglomeratedVectors();
+
+    /**
+       @brief Incrementally refresh this level after the fine operator
+       has changed.  The convergence factor of this level is probed
+       and only if it has degraded are the null-space vectors
+       refreshed and the transfer and coarse operators rebuilt, in
+       place, before recursing to the next level.  Otherwise the
+       coarser levels are left untouched.  Whether each level was
+       rebuilt is returned in mg_global.setup_refresh_rebuilt.
+    */
+    void refreshIncremental();
+
+    /** The number of random error vectors probed for the convergence
+        factor that decides an incremental refresh: a single vector
+        may have little overlap with the modes that have degraded */
+    static constexpr int refresh_n_probe = 4;
+
+    /**
+       @brief Probe the convergence factor of this level: the norm of
+       the error remaining after a single cycle, |e - M A e| / |e|,
+       for a random error vector e.  With an accurate coarse solver
+       this is the two-grid convergence factor.
+       @param[in] n_probe The number of random error vectors, of
+       which the worst factor is returned
+       @return The probed convergence factor
+    */
+    double probeConvergenceFactor(int n_probe = 1);
+
   public:
     /**
        Constructor for MG class
@@ -397,6 +524,16 @@ namespace quda {
     */
     void dumpNullVectors() const;
 
+    /**
+       @brief Checkpoint the multigrid hierarchy to disk: for each
+       level this saves the null-space vectors, the block-orthogonal
+       prolongator and the coarse link fields, together with a hash
+       of the gauge field and parameters used to validate the
+       checkpoint on restore.  Will recurse saving all levels.
+       @param[in] prefix The checkpoint filename prefix
+    */
+    void saveCheckpoint(const std::string &prefix) const;
+
     /**
        @brief Create the smoothers
     */
@@ -409,8 +546,10 @@ namespace quda {
 
     /**
        @brief Create the coarse dirac operator
+       @param[in] in_place Rebuild the existing coarse operator from
+       the updated fine operator, reusing its link storage
     */
-    void createCoarseDirac();
+    void createCoarseDirac(bool in_place = false);
 
     /**
        @brief Create the optimized KD operator
@@ -440,6 +579,15 @@ namespace quda {
      */
     void verify(bool recursively = false);
 
+    /**
+       @brief Probe the convergence factor of this level and of each
+       coarser level that has a cycle of its own, i.e., all but the
+       coarsest.
+       @param[out] factor Array of convergence factors, indexed by level
+       @param[in] n_probe The number of random error vectors per level
+    */
+    void probeConvergenceFactors(double *factor, int n_probe);
+
     /**
        This applies the V-cycle to the residual vector returning the residual vector
        @param out The solution vector
@@ -9,6 +9,14 @@ void read_spinor_field(const char *filename, void *V[], QudaPrecision precision,
 void write_spinor_field(const char *filename, const void *V[], QudaPrecision precision, const int *X,
                         QudaSiteSubset subset, QudaParity parity, int nColor, int nSpin, int Nvec, int argc,
                         char *argv[], bool partfile = false);
+
+/**
+   @brief Return the SciDAC checksum of the last record read or
+   written.  This can be compared against quda::ScidacChecksum to
+   verify the integrity of a field on load.
+   @param[out] checksum The checksum pair {suma, sumb}
+*/
+void get_last_qio_checksum(uint32_t checksum[2]);
 #else
 inline void read_gauge_field(const char *, void *[], QudaPrecision, const int *, int, char *[])
 {
@@ -32,5 +40,10 @@ inline void write_spinor_field(const char *, const void *[], QudaPrecision, cons
   printf("QIO support has not been enabled\n");
   exit(-1);
 }
+inline void get_last_qio_checksum(uint32_t[2])
+{
+  printf("QIO support has not been enabled\n");
+  exit(-1);
+}
 
 #endif
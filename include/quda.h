@@ -152,6 +152,10 @@ extern "C" {
     double reliable_delta; /**< Reliable update tolerance */
     double reliable_delta_refinement; /**< Reliable update tolerance used in post multi-shift solver refinement */
     int use_alternative_reliable; /**< Whether to use alternative reliable updates */
+    QudaBoolean adaptive_precision; /**< Whether to start the sloppy iteration in the preconditioner precision, and
+                                       promote it through the sloppy and full precision as the reliable updates
+                                       detect stagnation (CG only) */
+    int adaptive_promotions; /**< The number of times the sloppy precision was promoted in the solve (output) */
     int use_sloppy_partial_accumulator; /**< Whether to keep the partial solution accumuator in sloppy precision */
 
     /**< This parameter determines how often we accumulate into the
@@ -444,6 +448,18 @@ extern "C" {
     /** Precision to store the chronological basis in */
     QudaPrecision chrono_precision;
 
+    /** The maximum size of the basis of solutions recycled across the
+        sources of a multi-source solve, where each block of sources is
+        seeded with its projection onto the basis (0 = disabled) */
+    int recycle_max_dim;
+
+    /** The number of sources solved together between recycled basis updates */
+    int recycle_block_size;
+
+    /** The number of iterations taken by each block of sources in a
+        multi-source solve with recycling enabled */
+    int recycle_iter[QUDA_MAX_MULTI_SRC];
+
     /** Which external library to use in the linear solvers (Eigen) */
     QudaExtLibType extlib_type;
 
@@ -505,6 +521,33 @@ extern "C" {
         false, but preserve_deflation would be true */
     QudaBoolean preserve_evals;
 
+    /** Whether to keep a preserved deflation space in host memory,
+        rather than device memory, streaming it to the device in
+        tiles when deflating (out-of-core deflation).  This requires
+        preserve_deflation and preserve_evals to be true. */
+    QudaBoolean deflation_out_of_core;
+
+    /** The number of vectors in each tile streamed to the device
+        when deflating with an out-of-core deflation space */
+    int deflation_tile_size;
+    /** Whether to refine a restored deflation space on the present
+        operator, rather than using it as is, falling back to a full
+        eigensolve if the refined eigenpairs do not meet the
+        tolerance.  This is intended for a gauge field that has
+        changed only slightly since the space was computed, e.g.,
+        between HMC trajectories. */
+    QudaBoolean deflation_refine;
+    /** The maximum number of sweeps used to refine a deflation space,
+        or the eigenpairs when using precise_refine */
+    int deflation_refine_sweeps;
+    /** Whether to run the eigensolver with the eigensolver precision
+        (cuda_prec_eigensolver) operator and vectors to the tolerance
+        tol_sloppy, and then refine the converged eigenpairs with the
+        solver precision (cuda_prec) operator to the tolerance tol */
+    QudaBoolean precise_refine;
+    /** The tolerance of the eigensolver when using precise_refine */
+    double tol_sloppy;
+
     /** Whether to use the smeared gauge field for the Dirac operator
         for whose eigenvalues are are computing. */
     bool use_smeared_gauge;
@@ -522,6 +565,10 @@ extern "C" {
     /** Use Eigen routines to eigensolve the upper Hessenberg via QR **/
     QudaBoolean use_eigen_qr;
 
+    /** In TRLM, eigensolve the arrow matrix at each restart with the structured
+        divide-and-conquer solver, else use Eigen's dense solver **/
+    QudaBoolean use_arrow_solver;
+
     /** Performs an MdagM solve, then constructs the left and right SVD. **/
     QudaBoolean compute_svd;
 
@@ -640,6 +687,11 @@ extern "C" {
     /** Spin block sizes to use on each level */
     int spin_block_size[QUDA_MAX_MG_LEVEL];
 
+    /** Grid of sub-partitions onto which each level, and all coarser levels, is agglomerated
+        (as split_grid); the coarse problem is solved redundantly on each sub-partition.  At most
+        one level may be agglomerated, and never the fine grid. **/
+    int agglomerate_grid[QUDA_MAX_MG_LEVEL][QUDA_MAX_DIM];
+
     /** Number of null-space vectors to use on each level */
     int n_vec[QUDA_MAX_MG_LEVEL];
 
@@ -652,6 +704,10 @@ extern "C" {
     /** Whether to do passes at block orthogonalize in fixed point for improved accuracy */
     QudaBoolean block_ortho_two_pass[QUDA_MAX_MG_LEVEL];
 
+    /** Whether to shift the aggregate boundaries by a single global offset in each unpartitioned dimension, fitted to
+        the null-space vectors, rather than aligning them with the lattice origin */
+    QudaBoolean fit_aggregate_offset[QUDA_MAX_MG_LEVEL];
+
     /** Verbosity on each level of the multigrid */
     QudaVerbosity verbosity[QUDA_MAX_MG_LEVEL];
 
@@ -679,6 +735,15 @@ extern "C" {
     /** Maximum number of iterations for refreshing the null-space vectors */
     int setup_maxiter_refresh[QUDA_MAX_MG_LEVEL];
 
+    /** Whether a refresh only rebuilds the levels whose probed convergence factor has degraded */
+    QudaBoolean setup_refresh_incremental;
+
+    /** Relative increase of the probed convergence factor beyond which a level is rebuilt on an incremental refresh */
+    double setup_refresh_tol[QUDA_MAX_MG_LEVEL];
+
+    /** Whether each level was rebuilt by the last incremental refresh (output) */
+    QudaBoolean setup_refresh_rebuilt[QUDA_MAX_MG_LEVEL];
+
     /** Basis to use for CA solver setup */
     QudaCABasis setup_ca_basis[QUDA_MAX_MG_LEVEL];
 
@@ -736,10 +801,16 @@ extern "C" {
     /** Basis to use for CA smoother solvers */
     QudaCABasis smoother_solver_ca_basis[QUDA_MAX_MG_LEVEL];
 
-    /** Minimum eigenvalue for Chebyshev CA smoother basis */
+    /** Minimum eigenvalue for Chebyshev CA smoother basis, or for
+        the Chebyshev smoother where a non-positive value selects a
+        tenth of the maximum eigenvalue.  The Chebyshev smoother
+        bounds refer to M^dag M if the smoother operator M is not
+        Hermitian */
     double smoother_solver_ca_lambda_min[QUDA_MAX_MG_LEVEL];
 
-    /** Maximum eigenvalue for Chebyshev CA smoother basis */
+    /** Maximum eigenvalue for Chebyshev CA smoother basis or the
+        Chebyshev smoother, estimated during setup if less than the
+        minimum */
     double smoother_solver_ca_lambda_max[QUDA_MAX_MG_LEVEL];
 
     /** Over/under relaxation factor for the smoother at each level */
@@ -764,6 +835,16 @@ extern "C" {
     /** The type of multigrid cycle to perform at each level */
     QudaMultigridCycleType cycle_type[QUDA_MAX_MG_LEVEL];
 
+    /** For the adaptive cycle, the residual reduction of a single
+        coarse-grid V-cycle above which the coarse grid is instead
+        solved with the flexible Krylov coarse solver (K-cycle) */
+    double cycle_adaptive_threshold[QUDA_MAX_MG_LEVEL];
+
+    /** For the adaptive cycle, the number of coarse-grid V-cycles on
+        each level since the hierarchy was created that met the
+        threshold, so that the K-cycle was skipped (output) */
+    int cycle_adaptive_skipped[QUDA_MAX_MG_LEVEL];
+
     /** Whether to use global reductions or not for the smoother / solver at each level */
     QudaBoolean global_reduction[QUDA_MAX_MG_LEVEL];
 
@@ -811,6 +892,29 @@ extern "C" {
     /** Whether to store the null-space vectors in singlefile or partfile format */
     QudaBoolean mg_vec_partfile[QUDA_MAX_MG_LEVEL];
 
+    /** Filename prefix from which to restore the multigrid hierarchy
+        (null-space vectors, prolongators and coarse operators).  Any
+        level whose checkpoint does not match the present gauge field
+        and parameters is set up afresh. */
+    char checkpoint_infile[256];
+
+    /** Filename prefix to which to checkpoint the multigrid hierarchy
+        once set up is complete */
+    char checkpoint_outfile[256];
+
+    /** Number of random right-hand sides on which each candidate is measured when tuning the multigrid parameters,
+        and the number of random vectors with which the convergence factors are probed */
+    int tune_n_probe;
+
+    /** Number of solves over which the setup time is amortized when tuning the multigrid parameters */
+    int tune_n_solve;
+
+    /** Filename to which to write the tuned multigrid parameters as JSON */
+    char tune_outfile[256];
+
+    /** Output: the probed convergence factor of the cycle on each level */
+    double convergence_factor[QUDA_MAX_MG_LEVEL];
+
     /** Whether to use and initial guess during coarse grid deflation */
     QudaBoolean coarse_guess;
 
@@ -1138,6 +1242,36 @@ extern "C" {
    */
   void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param);
 
+  /**
+   * Begin prefetching a sequence of gauge configurations (read using
+   * QIO) into pinned host buffers on a background thread, so that
+   * reading the next configuration(s) overlaps with the processing of
+   * the current one.  No other QIO I/O should be done until
+   * endPrefetchGaugeQuda is called.  With more than one process the
+   * configurations are not read ahead, but each is read when loaded.
+   * @param filenames Array of configuration filenames, in the order they will be loaded
+   * @param n_file    Number of configurations
+   * @param depth     Number of configurations to read ahead of the one in use
+   * @param param     Contains the metadata of the host field (cpu_prec and X)
+   */
+  void prefetchGaugeQuda(const char *const *filenames, int n_file, int depth, QudaGaugeParam *param);
+
+  /**
+   * Load the next prefetched configuration with loadGaugeQuda,
+   * waiting for it to be read if necessary.  The host buffer is
+   * handed off to the caller and remains valid until the next call.
+   * @param param Contains all metadata regarding host and device
+   * storage (gauge_order must be QUDA_QDP_GAUGE_ORDER)
+   * @return Base pointer to the QDP-ordered host gauge field, or NULL
+   * if all configurations have been loaded
+   */
+  void *loadNextGaugeQuda(QudaGaugeParam *param);
+
+  /**
+   * Stop any prefetching and free the associated host buffers.
+   */
+  void endPrefetchGaugeQuda(void);
+
   /**
    * Free QUDA's internal copy of the gauge field.
    */
@@ -1273,6 +1407,38 @@ extern "C" {
    */
   void dumpMultigridQuda(void *mg_instance, QudaMultigridParam *param);
 
+  /**
+   * @brief Probe the convergence factor of the multigrid cycle on each
+   * level but the coarsest, |e - M A e| / |e| for random error vectors
+   * e, which approaches the two-grid convergence factor of a level as
+   * the accuracy of its coarse solve increases.
+   * @param[in] mg_instance Pointer to the instance of multigrid_solver
+   * @param[in,out] param Contains all metadata regarding host and device
+   * storage and solver parameters (QudaMultigridParam::tune_n_probe
+   * sets the number of random vectors, and the factors are returned in
+   * QudaMultigridParam::convergence_factor).
+   */
+  void diagnoseMultigridQuda(void *mg_instance, QudaMultigridParam *param);
+
+  /**
+   * @brief Tune the multigrid parameters for the resident gauge field.
+   * Starting from the given parameters, the block size, the number of
+   * null-space vectors, the setup iterations and the smoother steps
+   * are varied one level at a time, keeping each change that reduces
+   * the time to solution.  Each candidate is set up and used to solve
+   * tune_n_probe random right-hand sides with the outer solver, with
+   * the setup time amortized over tune_n_solve solves.  The setup and
+   * solves are timed on a second repetition, so that the autotuning
+   * of the kernels launched by a candidate is not counted.  The result is
+   * cached in QUDA_RESOURCE_PATH, keyed by the lattice and action
+   * parameters and the plaquette, so that later runs on the same
+   * ensemble start from the tuned parameters without tuning.
+   * @param[in,out] mg_param The initial multigrid parameters, which
+   * are overwritten with the tuned ones
+   * @param[in] param The outer solver parameters
+   */
+  void tuneMultigridQuda(QudaMultigridParam *mg_param, QudaInvertParam *param);
+
   /**
    * Apply the Dslash operator (D_{eo} or D_{oe}).
    * @param[out] h_out  Result spinor field
@@ -115,6 +115,36 @@ namespace quda
     __device__ __host__ inline T operator()(T a, T b) const { return apply(a, b); }
   };
 
+  /**
+     xor reducer, used for checksum reductions.  Each element of T
+     holds a 32-bit word stored as an (exactly representable) double,
+     allowing us to reuse the floating-point reduction buffers and
+     completion sentinels
+   */
+  template <typename T> struct checksum_xor {
+    static constexpr bool do_sum = false;
+    using reduce_t = T;
+    using reducer_t = checksum_xor<T>;
+    template <typename U> static inline void comm_reduce(std::vector<U> &a)
+    {
+      for (auto &ai : a) {
+        static_assert(U::N == 2, "checksum reduction expects a pair of 32-bit words");
+        uint64_t c = (static_cast<uint64_t>(ai[1]) << 32) | static_cast<uint64_t>(ai[0]);
+        comm_allreduce_xor(c);
+        ai = {static_cast<double>(c & 0xffffffff), static_cast<double>(c >> 32)};
+      }
+    }
+    __device__ __host__ static inline T init() { return zero<T>(); }
+    __device__ __host__ static inline T apply(T a, T b)
+    {
+#pragma unroll
+      for (int i = 0; i < T::N; i++)
+        a[i] = static_cast<double>(static_cast<uint32_t>(a[i]) ^ static_cast<uint32_t>(b[i]));
+      return a;
+    }
+    __device__ __host__ inline T operator()(T a, T b) const { return apply(a, b); }
+  };
+
   /**
      square transformer, return the L2 norm squared of the input
    */
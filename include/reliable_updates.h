@@ -53,9 +53,9 @@ namespace quda
 
   struct ReliableUpdates {
 
-    const ReliableUpdatesParams params;
+    ReliableUpdatesParams params;
 
-    const double deps;
+    double deps;
     static constexpr double dfac = 1.1;
     double d_new = 0;
     double d = 0;
@@ -117,6 +117,17 @@ namespace quda
      */
     void update_rNorm(double rNorm_) { rNorm = rNorm_; }
 
+    /**
+      @brief Update the lower precision tolerance, following a change
+      of the precision of the sloppy iteration
+      @param u the new lower precision tolerance
+     */
+    void update_u(double u)
+    {
+      params.u = u;
+      deps = sqrt(u);
+    }
+
     /**
       @brief Update maxr_deflate
      */
@@ -141,6 +152,25 @@ namespace quda
       }
     }
 
+    /**
+      @brief Whether the sloppy iteration is stagnating, judged at a
+      reliable update: this is the case when, for any right hand side,
+      the true residual has realized less than half of the orders of
+      magnitude of reduction that the iterated residual claimed since
+      the previous reliable update.
+      @param r2 the true residual norms squared
+      @param r2_iter the iterated residual norms squared
+      @param r2_reliable the true residual norms squared at the previous reliable update
+     */
+    static bool stagnating(const vector<double> &r2, const vector<double> &r2_iter, const vector<double> &r2_reliable)
+    {
+      for (auto i = 0u; i < r2.size(); i++) {
+        if (r2_reliable[i] == 0.0) continue;
+        if (sqrt(r2[i] / r2_reliable[i]) > sqrt(sqrt(r2_iter[i] / r2_reliable[i]))) return true;
+      }
+      return false;
+    }
+
     /**
       @brief Set updateX to 1
      */
@@ -44,12 +44,38 @@ namespace quda
     int n_replicates = product(comm_key);
     std::vector<void *> v_send_buffer_h(n_replicates, nullptr);
     std::vector<MsgHandle *> v_mh_send(n_replicates, nullptr);
+    std::vector<void *> v_recv_buffer_h(n_replicates, nullptr);
+    std::vector<MsgHandle *> v_mh_recv(n_replicates, nullptr);
 
     int n_fields = v_base_field.size();
     if (n_fields == 0) { errorQuda("split_field: input field vec has zero size."); }
 
     const auto &meta = v_base_field[0];
 
+    using param_type = typename Field::param_type;
+    param_type param(meta);
+    Field buffer_field(param);
+
+    CommKey field_dim = {meta.full_dim(0), meta.full_dim(1), meta.full_dim(2), meta.full_dim(3)};
+
+    // Post all the receives first, so that none is waited on before its message is sent; the pinned
+    // buffers come from the pool since multigrid splits its coarse vectors on every cycle
+    for (int i = 0; i < n_replicates; i++) {
+      auto partition_idx
+        = coordinate_from_index(i, comm_key); // Here this means which partition of the field we are working on.
+      auto src_idx
+        = (comm_grid_idx % processor_dim) * partition_dim + partition_idx; // And where does this partition comes from?
+
+      int src_rank = comm_rank_from_coords(src_idx.data());
+      int tag = src_rank * total_rank + rank;
+
+      size_t bytes = buffer_field.TotalBytes();
+
+      v_recv_buffer_h[i] = pool_pinned_malloc(bytes);
+      v_mh_recv[i] = comm_declare_recv_rank(v_recv_buffer_h[i], src_rank, tag, bytes);
+      comm_start(v_mh_recv[i]);
+    }
+
     // Send cycles
     for (int i = 0; i < n_replicates; i++) {
       auto partition_idx = coordinate_from_index(i, comm_key); // Which partition to send to?
@@ -62,7 +88,7 @@ namespace quda
 
       size_t bytes = meta.TotalBytes();
 
-      v_send_buffer_h[i] = pinned_malloc(bytes);
+      v_send_buffer_h[i] = pool_pinned_malloc(bytes);
 
       v_base_field[i % n_fields].copy_to_buffer(v_send_buffer_h[i]);
 
@@ -70,49 +96,28 @@ namespace quda
       comm_start(v_mh_send[i]);
     }
 
-    using param_type = typename Field::param_type;
-    param_type param(meta);
-    Field buffer_field(param);
-
-    CommKey field_dim = {meta.full_dim(0), meta.full_dim(1), meta.full_dim(2), meta.full_dim(3)};
-
     // Receive cycles
     for (int i = 0; i < n_replicates; i++) {
-      auto partition_idx
-        = coordinate_from_index(i, comm_key); // Here this means which partition of the field we are working on.
-      auto src_idx
-        = (comm_grid_idx % processor_dim) * partition_dim + partition_idx; // And where does this partition comes from?
-
-      int src_rank = comm_rank_from_coords(src_idx.data());
-      int tag = src_rank * total_rank + rank;
-
-      size_t bytes = buffer_field.TotalBytes();
-
-      void *recv_buffer_h = pinned_malloc(bytes);
-
-      auto mh_recv = comm_declare_recv_rank(recv_buffer_h, src_rank, tag, bytes);
-
-      comm_start(mh_recv);
-      comm_wait(mh_recv);
+      auto partition_idx = coordinate_from_index(i, comm_key);
 
-      buffer_field.copy_from_buffer(recv_buffer_h);
+      comm_wait(v_mh_recv[i]);
 
-      comm_free(mh_recv);
-      host_free(recv_buffer_h);
+      buffer_field.copy_from_buffer(v_recv_buffer_h[i]);
 
       auto offset = partition_idx * field_dim;
 
       quda::copyFieldOffset(collect_field, buffer_field, offset, pc_type);
     }
 
-    comm_barrier();
+    // only our own sends need to complete before their buffers are released
+    for (auto &mh : v_mh_send) comm_wait(mh);
 
-    for (auto &p : v_send_buffer_h) {
-      if (p) { host_free(p); }
-    };
-    for (auto &p : v_mh_send) {
-      if (p) { comm_free(p); }
-    };
+    for (int i = 0; i < n_replicates; i++) {
+      comm_free(v_mh_recv[i]);
+      pool_pinned_free(v_recv_buffer_h[i]);
+      comm_free(v_mh_send[i]);
+      pool_pinned_free(v_send_buffer_h[i]);
+    }
   }
 
   template <class Field>
@@ -132,6 +137,8 @@ namespace quda
     int n_replicates = product(comm_key);
     std::vector<void *> v_send_buffer_h(n_replicates, nullptr);
     std::vector<MsgHandle *> v_mh_send(n_replicates, nullptr);
+    std::vector<void *> v_recv_buffer_h(n_replicates, nullptr);
+    std::vector<MsgHandle *> v_mh_recv(n_replicates, nullptr);
 
     int n_fields = v_base_field.size();
     if (n_fields == 0) { errorQuda("join_field: output field vec has zero size."); }
@@ -145,6 +152,24 @@ namespace quda
 
     CommKey field_dim = {meta.full_dim(0), meta.full_dim(1), meta.full_dim(2), meta.full_dim(3)};
 
+    // Post all the receives first, as in split_field
+    for (int i = 0; i < n_replicates; i++) {
+
+      auto partition_idx = coordinate_from_index(i, comm_key);
+      auto processor_idx = comm_grid_idx / partition_dim;
+
+      auto src_idx = partition_idx * processor_dim + processor_idx;
+
+      int src_rank = comm_rank_from_coords(src_idx.data());
+      int tag = src_rank * total_rank + rank;
+
+      size_t bytes = buffer_field.TotalBytes();
+
+      v_recv_buffer_h[i] = pool_pinned_malloc(bytes);
+      v_mh_recv[i] = comm_declare_recv_rank(v_recv_buffer_h[i], src_rank, tag, bytes);
+      comm_start(v_mh_recv[i]);
+    }
+
     // Send cycles
     for (int i = 0; i < n_replicates; i++) {
 
@@ -159,7 +184,7 @@ namespace quda
       auto offset = partition_idx * field_dim;
       quda::copyFieldOffset(buffer_field, collect_field, offset, pc_type);
 
-      v_send_buffer_h[i] = pinned_malloc(bytes);
+      v_send_buffer_h[i] = pool_pinned_malloc(bytes);
       buffer_field.copy_to_buffer(v_send_buffer_h[i]);
 
       v_mh_send[i] = comm_declare_send_rank(v_send_buffer_h[i], dst_rank, tag, bytes);
@@ -169,34 +194,18 @@ namespace quda
 
     // Receive cycles
     for (int i = 0; i < n_replicates; i++) {
-
-      auto partition_idx = coordinate_from_index(i, comm_key);
-      auto processor_idx = comm_grid_idx / partition_dim;
-
-      auto src_idx = partition_idx * processor_dim + processor_idx;
-
-      int src_rank = comm_rank_from_coords(src_idx.data());
-      int tag = src_rank * total_rank + rank;
-
-      size_t bytes = buffer_field.TotalBytes();
-
-      void *recv_buffer_h = pinned_malloc(bytes);
-
-      auto mh_recv = comm_declare_recv_rank(recv_buffer_h, src_rank, tag, bytes);
-
-      comm_start(mh_recv);
-      comm_wait(mh_recv);
-
-      v_base_field[i % n_fields].copy_from_buffer(recv_buffer_h);
-
-      comm_free(mh_recv);
-      host_free(recv_buffer_h);
+      comm_wait(v_mh_recv[i]);
+      v_base_field[i % n_fields].copy_from_buffer(v_recv_buffer_h[i]);
     }
 
-    comm_barrier();
+    for (auto &mh : v_mh_send) comm_wait(mh);
 
-    for (auto &p : v_send_buffer_h) { host_free(p); };
-    for (auto &p : v_mh_send) { comm_free(p); };
+    for (int i = 0; i < n_replicates; i++) {
+      comm_free(v_mh_recv[i]);
+      pool_pinned_free(v_recv_buffer_h[i]);
+      comm_free(v_mh_send[i]);
+      pool_pinned_free(v_send_buffer_h[i]);
+    }
   }
 
 } // namespace quda
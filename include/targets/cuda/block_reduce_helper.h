@@ -125,6 +125,7 @@ namespace quda
   template <typename T, typename U> constexpr auto get_reducer(const plus<U> &) { return plus<T>(); }
   template <typename T, typename U> constexpr auto get_reducer(const maximum<U> &) { return maximum<T>(); }
   template <typename T, typename U> constexpr auto get_reducer(const minimum<U> &) { return minimum<T>(); }
+  template <typename T, typename U> constexpr auto get_reducer(const checksum_xor<U> &) { return checksum_xor<T>(); }
 
   template <typename T, typename U> constexpr auto get_cg_reducer(const plus<U> &) { return cg::plus<T>(); }
   template <typename T, typename U> constexpr auto get_cg_reducer(const maximum<U> &) { return cg::greater<T>(); }
@@ -7,11 +7,16 @@ namespace quda
 
   template <template <typename> class Functor, typename Arg> auto Reduction2D_host(const Arg &arg)
   {
+#pragma omp declare reduction(reduce_2d                                                                                \
+                              : typename Functor <Arg>::reduce_t                                                       \
+                              : omp_out = Functor <Arg>::apply(omp_out, omp_in))                                       \
+  initializer(omp_priv = Functor <Arg>::init())
+
     using reduce_t = typename Functor<Arg>::reduce_t;
     Functor<Arg> t(arg);
 
     reduce_t value = t.init();
-#pragma omp parallel for collapse(2) reduction(Functor <Arg>::apply : value)
+#pragma omp parallel for collapse(2) reduction(reduce_2d : value)
     for (int j = 0; j < static_cast<int>(arg.threads.y); j++) {
       for (int i = 0; i < static_cast<int>(arg.threads.x); i++) { value = t(value, i, j); }
     }
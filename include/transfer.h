@@ -16,6 +16,26 @@
 
 namespace quda {
 
+  class MGCheckpoint;
+
+  /**
+   * @brief Fit a single global shift of the aggregate boundaries to a
+   * null-space density.  In each unpartitioned dimension, all block
+   * boundaries are shifted by the same offset in [0, geo_bs), the one
+   * that minimizes the null-space coupling cut by the boundary
+   * planes, measured as the sum of sqrt(rho(x) rho(x+mu)) across each
+   * plane.  The coarse lattice remains regular, so the coarse stencil
+   * is unchanged.  Offsets that do not reduce the cut beyond rounding
+   * keep the lattice-aligned blocking, and partitioned dimensions are
+   * not shifted since blocks cannot wrap around them.
+   * @param[out] offset The fitted offset in each dimension
+   * @param[in] rho The null-space density on each local site, summed
+   * over the vectors, in lexicographical order
+   * @param[in] X The local lattice dimensions
+   * @param[in] geo_bs The block size in each dimension
+   */
+  void fitAggregateOffset(int offset[4], const std::vector<double> &rho, const int *X, const int *geo_bs);
+
   /**
      The transfer class defines the inter-grid operators that connect
      fine and coarse grids.  This implements both restriction and
@@ -61,6 +81,15 @@ namespace quda {
     /** The geometrical coase grid blocking */
     int *geo_bs = nullptr;
 
+    /** The per-dimension offset of the aggregate boundaries from the
+        lattice origin, which is non-zero only when the aggregates have
+        been fitted to the null-space vectors */
+    int geo_offset[QUDA_MAX_DIM] = {};
+
+    /** Whether the offset is fitted to the null-space vectors, and
+        refitted on each reset */
+    bool fit_offset = false;
+
     /** The mapping onto coarse sites from fine sites.  This has
 	length equal to the fine-grid volume, and is sorted into
 	lexicographical fine-grid order, with each value corresponding
@@ -139,6 +168,15 @@ namespace quda {
      */
     void createGeoMap(int *geo_bs);
 
+    /**
+     * @brief Fit the aggregate offset to the present null-space
+     * vectors with fitAggregateOffset and recreate the map between
+     * fine and coarse grids.  The environment variable
+     * QUDA_MG_AGGREGATE_OFFSET="x y z t" overrides the fitted offset
+     * in the unpartitioned dimensions.
+     */
+    void fitGeoMap();
+
     /**
      * @brief Creates the map between fine spin and parity to coarse spin dimensions
      * @param spin_bs The spin block size
@@ -164,18 +202,40 @@ namespace quda {
      * @param parity For single-parity fields are these QUDA_EVEN_PARITY or QUDA_ODD_PARITY
      * @param null_precision The precision to store the null-space basis vectors in
      * @param enable_gpu Whether to enable this to run on GPU (as well as CPU)
+     * @param checkpoint Optional checkpoint from which to restore the
+     * block-orthogonalized vectors, in which case the block
+     * orthogonalization is skipped
+     * @param fit_offset Whether to shift the aggregate boundaries by
+     * an offset fitted to the null-space vectors rather than aligning
+     * them with the lattice origin
      */
     Transfer(const std::vector<ColorSpinorField> &B, int Nvec, int NblockOrtho, bool blockOrthoTwoPass, int *geo_bs,
-             int spin_bs, QudaPrecision null_precision, const QudaTransferType transfer_type);
+             int spin_bs, QudaPrecision null_precision, const QudaTransferType transfer_type,
+             MGCheckpoint *checkpoint = nullptr, bool fit_offset = false);
 
     /** The destructor for Transfer */
     virtual ~Transfer();
 
     /**
-     @brief for resetting the Transfer when the null vectors have changed
+     @brief for resetting the Transfer when the null vectors have
+     changed, which refits a fitted aggregate offset to them
      */
     void reset();
 
+    /**
+       @brief Save the block-orthogonalized vectors to a checkpoint
+       @param[in] checkpoint The checkpoint we are writing
+    */
+    void save(MGCheckpoint &checkpoint) const;
+
+    /**
+       @brief Restore the block-orthogonalized vectors from a
+       checkpoint, in lieu of block orthogonalizing the null-space
+       vectors
+       @param[in] checkpoint The checkpoint we are reading
+    */
+    void load(MGCheckpoint &checkpoint);
+
     /**
      * Apply the prolongator
      * @param out The resulting field on the fine lattice
@@ -230,6 +290,12 @@ namespace quda {
      */
     const int *Geo_bs() const {return geo_bs;}
 
+    /**
+     * Returns the offset of the aggregate boundaries from the lattice origin
+     * @return geo_offset
+     */
+    const int *Geo_offset() const { return geo_offset; }
+
     /**
      * Returns the transfer type; used to inform staggered-type coarsenings
      * @return transfer_type
@@ -0,0 +1,115 @@
+#include <algorithm>
+
+#include <blas_quda.h>
+#include <eigen_helper.h>
+
+namespace quda
+{
+
+  namespace blas
+  {
+
+    namespace block
+    {
+
+      /**
+         @brief Orthonormalize v[begin, end) against the orthonormal
+         set v[0, begin) and amongst itself with classical Gram-Schmidt
+         with re-orthogonalization.  This is the fallback for a single
+         vector, and for blocks whose Cholesky factorization fails.
+      */
+      static void orthonormalize_cgs2(cvector_ref<ColorSpinorField> &v, size_t begin, size_t end)
+      {
+        for (auto i = begin; i < end; i++) {
+          if (i > 0) {
+            cvector_ref<const ColorSpinorField> q {v.begin(), v.begin() + i};
+            for (int pass = 0; pass < 2; pass++) {
+              std::vector<Complex> alpha(i);
+              cDotProduct(alpha, q, v[i]);
+              for (auto &a : alpha) a = -a;
+              caxpy(alpha, q, v[i]);
+            }
+          }
+          double nrm2 = norm2(v[i]);
+          if (sqrt(nrm2) > 1e-16)
+            ax(1.0 / sqrt(nrm2), v[i]);
+          else
+            errorQuda("Cannot normalize %lu vector (nrm=%e)", i, sqrt(nrm2));
+        }
+      }
+
+      /**
+         @brief Orthonormalize v[begin, end) against the orthonormal
+         set v[0, begin) and amongst itself.  Each of the two passes
+         uses a single block reduction to form both the projection
+         coefficients C = Q^dag V and the Gram matrix G = V^dag V, from
+         which the Cholesky factor R of the projected Gram matrix
+         G - C^dag C = R^dag R follows, and the update
+         V = (V - Q C) R^{-1}.  Since R^{-1} is upper triangular, the
+         update is applied in place from the last vector of the block
+         down, with one multi-blas caxpy per vector, so no temporary
+         fields are needed.  Blocks whose factorization fails, or that
+         lose too many digits to cancellation, are bisected.
+      */
+      static void orthonormalize_block(cvector_ref<ColorSpinorField> &v, size_t begin, size_t end)
+      {
+        const auto n = end - begin;
+        if (n == 1) {
+          orthonormalize_cgs2(v, begin, end);
+          return;
+        }
+
+        cvector_ref<const ColorSpinorField> qv {v.begin(), v.begin() + end};
+        cvector_ref<ColorSpinorField> v_ {v.begin() + begin, v.begin() + end};
+
+        for (int pass = 0; pass < 2; pass++) {
+          std::vector<Complex> A(end * n);
+          cDotProduct(A, qv, v_);
+          MatrixXcd A_ = Map<Matrix<Complex, Dynamic, Dynamic, RowMajor>>(A.data(), end, n);
+
+          MatrixXcd C = A_.topRows(begin);
+          MatrixXcd G = A_.bottomRows(n);
+          MatrixXcd S = G - C.adjoint() * C;
+          S = 0.5 * (S + S.adjoint());
+
+          LLT<MatrixXcd> llt(S);
+          bool breakdown = llt.info() != Success;
+          for (auto i = 0u; i < n && !breakdown; i++) breakdown = S(i, i).real() <= 1e-8 * G(i, i).real();
+          if (breakdown) {
+            logQuda(QUDA_DEBUG_VERBOSE, "Bisecting orthonormalization block [%lu, %lu)\n", begin, end);
+            auto mid = begin + n / 2;
+            orthonormalize_block(v, begin, mid);
+            orthonormalize_block(v, mid, end);
+            return;
+          }
+
+          // column j of V R^{-1} - Q C R^{-1} only reads v[0, begin + j],
+          // which have not been updated yet when going down the block
+          MatrixXcd R_inv = llt.matrixU().solve(MatrixXcd::Identity(n, n));
+          MatrixXcd M = -C * R_inv;
+          for (auto j = n; j-- > 0;) {
+            ax(R_inv(j, j).real(), v_[j]);
+            auto k = begin + j;
+            if (k == 0) continue;
+            std::vector<Complex> a(k);
+            for (auto i = 0u; i < begin; i++) a[i] = M(i, j);
+            for (auto i = 0u; i < j; i++) a[begin + i] = R_inv(i, j);
+            caxpy(a, {v.begin(), v.begin() + k}, v[k]);
+          }
+        }
+      }
+
+      void orthonormalize(cvector_ref<ColorSpinorField> &v, unsigned int block_size)
+      {
+        if (v.size() == 0) return;
+        if (block_size == 0) errorQuda("Invalid block size %u", block_size);
+
+        for (size_t begin = 0; begin < v.size(); begin += block_size)
+          orthonormalize_block(v, begin, std::min(begin + block_size, v.size()));
+      }
+
+    } // namespace block
+
+  } // namespace blas
+
+} // namespace quda
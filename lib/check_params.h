@@ -168,6 +168,7 @@ void printQudaEigParam(QudaEigParam *param) {
 
 #if defined INIT_PARAM
   P(use_eigen_qr, QUDA_BOOLEAN_FALSE);
+  P(use_arrow_solver, QUDA_BOOLEAN_TRUE);
   P(use_poly_acc, QUDA_BOOLEAN_FALSE);
   P(poly_deg, 0);
   P(a_min, 0.0);
@@ -175,6 +176,12 @@ void printQudaEigParam(QudaEigParam *param) {
   P(preserve_deflation, QUDA_BOOLEAN_FALSE);
   P(preserve_deflation_space, 0);
   P(preserve_evals, QUDA_BOOLEAN_TRUE);
+  P(deflation_out_of_core, QUDA_BOOLEAN_FALSE);
+  P(deflation_tile_size, 64);
+  P(deflation_refine, QUDA_BOOLEAN_FALSE);
+  P(deflation_refine_sweeps, 4);
+  P(precise_refine, QUDA_BOOLEAN_FALSE);
+  P(tol_sloppy, 1e-6);
   P(use_smeared_gauge, false);
   P(use_dagger, QUDA_BOOLEAN_FALSE);
   P(use_norm_op, QUDA_BOOLEAN_FALSE);
@@ -202,12 +209,19 @@ void printQudaEigParam(QudaEigParam *param) {
   P(partfile, QUDA_BOOLEAN_FALSE);
 #else
   P(use_eigen_qr, QUDA_BOOLEAN_INVALID);
+  P(use_arrow_solver, QUDA_BOOLEAN_INVALID);
   P(use_poly_acc, QUDA_BOOLEAN_INVALID);
   P(poly_deg, INVALID_INT);
   P(a_min, INVALID_DOUBLE);
   P(a_max, INVALID_DOUBLE);
   P(preserve_deflation, QUDA_BOOLEAN_INVALID);
   P(preserve_evals, QUDA_BOOLEAN_INVALID);
+  P(deflation_out_of_core, QUDA_BOOLEAN_INVALID);
+  P(deflation_tile_size, INVALID_INT);
+  P(deflation_refine, QUDA_BOOLEAN_INVALID);
+  P(deflation_refine_sweeps, INVALID_INT);
+  P(precise_refine, QUDA_BOOLEAN_INVALID);
+  P(tol_sloppy, INVALID_DOUBLE);
   P(use_dagger, QUDA_BOOLEAN_INVALID);
   P(use_norm_op, QUDA_BOOLEAN_INVALID);
   P(compute_svd, QUDA_BOOLEAN_INVALID);
@@ -432,6 +446,8 @@ void printQudaInvertParam(QudaInvertParam *param) {
 
 #ifdef INIT_PARAM
   P(use_alternative_reliable, 0); /**< Default is to not use alternative relative updates, e.g., use delta to determine reliable trigger */
+  P(adaptive_precision, QUDA_BOOLEAN_FALSE); /**< Default is to use a fixed sloppy precision */
+  P(adaptive_promotions, 0);
   P(use_sloppy_partial_accumulator, 0); /**< Default is to use a high-precision accumulator (not yet supported in all solvers) */
   P(solution_accumulator_pipeline, 1); /**< Default is solution accumulator depth of 1 */
   P(max_res_increase, 1); /**< Default is to allow one consecutive residual increase */
@@ -441,6 +457,7 @@ void printQudaInvertParam(QudaInvertParam *param) {
   P(heavy_quark_check, 10); /**< Default is to update heavy quark residual after 10 iterations */
  #else
   P(use_alternative_reliable, INVALID_INT);
+  P(adaptive_precision, QUDA_BOOLEAN_INVALID);
   P(use_sloppy_partial_accumulator, INVALID_INT);
   P(solution_accumulator_pipeline, INVALID_INT);
   P(max_res_increase, INVALID_INT);
@@ -747,6 +764,15 @@ void printQudaInvertParam(QudaInvertParam *param) {
   if (param->chrono_precision == QUDA_INVALID_PRECISION) param->chrono_precision = param->cuda_prec;
 #endif
 
+#if defined INIT_PARAM
+  P(recycle_max_dim, 0);
+  P(recycle_block_size, 1);
+  for (int i = 0; i < QUDA_MAX_MULTI_SRC; i++) P(recycle_iter[i], 0);
+#else
+  P(recycle_max_dim, INVALID_INT);
+  P(recycle_block_size, INVALID_INT);
+#endif
+
 #if defined INIT_PARAM
   P(extlib_type, QUDA_EIGEN_EXTLIB);
 #else
@@ -810,6 +836,10 @@ void printQudaInvertParam(QudaInvertParam *param) {
   if (param->chrono_make_resident && param->chrono_max_dim < 1) {
     errorQuda("Cannot chrono_make_resident with chrono_max_dim %i", param->chrono_max_dim);
   }
+
+  if (param->recycle_max_dim > 0 && param->recycle_block_size < 1) {
+    errorQuda("Invalid recycle_block_size %d", param->recycle_block_size);
+  }
 #endif
 }
 
@@ -865,6 +895,12 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
   P(post_orthonormalize, QUDA_BOOLEAN_INVALID);
 #endif
 
+#ifdef INIT_PARAM
+  P(setup_refresh_incremental, QUDA_BOOLEAN_FALSE);
+#else
+  P(setup_refresh_incremental, QUDA_BOOLEAN_INVALID);
+#endif
+
   for (int i=0; i<n_level; i++) {
 #ifdef INIT_PARAM
     P(verbosity[i], QUDA_SILENT);
@@ -901,10 +937,13 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
     P(setup_tol[i], 5e-6);
     P(setup_maxiter[i], 500);
     P(setup_maxiter_refresh[i], 0);
+    P(setup_refresh_tol[i], 0.1);
+    P(setup_refresh_rebuilt[i], QUDA_BOOLEAN_FALSE);
 #else
     P(setup_tol[i], INVALID_DOUBLE);
     P(setup_maxiter[i], INVALID_INT);
     P(setup_maxiter_refresh[i], INVALID_INT);
+    P(setup_refresh_tol[i], INVALID_DOUBLE);
 #endif
 
 #ifdef INIT_PARAM
@@ -922,9 +961,11 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
 #ifdef INIT_PARAM
     P(n_block_ortho[i], 1);
     P(block_ortho_two_pass[i], QUDA_BOOLEAN_TRUE);
+    P(fit_aggregate_offset[i], QUDA_BOOLEAN_FALSE);
 #else
     P(n_block_ortho[i], INVALID_INT);
     P(block_ortho_two_pass[i], QUDA_BOOLEAN_INVALID);
+    P(fit_aggregate_offset[i], QUDA_BOOLEAN_INVALID);
 #endif
 
     P(coarse_solver[i], QUDA_INVALID_INVERTER);
@@ -952,6 +993,16 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
     P(smoother_schwarz_cycle[i], INVALID_INT);
 #endif
 
+#ifdef INIT_PARAM
+    for (int j = 0; j < 4; j++) P(agglomerate_grid[i][j], 1);
+#else
+    for (int j = 0; j < 4; j++) P(agglomerate_grid[i][j], INVALID_INT);
+#endif
+
+#ifdef INIT_PARAM
+    P(convergence_factor[i], 0.0);
+#endif
+
     // these parameters are not set for the bottom grid
     if (i<n_level-1) {
       for (int j=0; j<4; j++) P(geo_block_size[i][j], INVALID_INT);
@@ -962,6 +1013,12 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
       P(precision_null[i], INVALID_INT);
 #endif
       P(cycle_type[i], QUDA_MG_CYCLE_INVALID);
+#ifdef INIT_PARAM
+      P(cycle_adaptive_threshold[i], 0.25);
+      P(cycle_adaptive_skipped[i], 0);
+#else
+      P(cycle_adaptive_threshold[i], INVALID_DOUBLE);
+#endif
       P(nu_pre[i], INVALID_INT);
       P(nu_post[i], INVALID_INT);
       P(coarse_grid_solution_type[i], QUDA_INVALID_SOLUTION);
@@ -1086,6 +1143,20 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
   P(thin_update_only, QUDA_BOOLEAN_INVALID);
 #endif
 
+#ifdef INIT_PARAM
+  P(checkpoint_infile[0], '\0');
+  P(checkpoint_outfile[0], '\0');
+#endif
+
+#ifdef INIT_PARAM
+  P(tune_n_probe, 2);
+  P(tune_n_solve, 12);
+  P(tune_outfile[0], '\0');
+#else
+  P(tune_n_probe, INVALID_INT);
+  P(tune_n_solve, INVALID_INT);
+#endif
+
 #ifdef INIT_PARAM
   return ret;
 #endif
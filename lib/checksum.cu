@@ -1,86 +1,218 @@
-#include <gauge_field_order.h>
+#include <gauge_field.h>
+#include <color_spinor_field.h>
+#include <clover_field.h>
+#include <instantiate.h>
+#include <tunable_reduction.h>
+#include <kernels/checksum.cuh>
 
 namespace quda {
 
-  template <typename T, QudaGaugeFieldOrder order, int Nc>
-  struct ChecksumArg {
-    static constexpr int nColor = Nc;
-    typedef typename mapper<T>::type real;
-    typedef typename gauge_order_mapper<T,order,Nc>::type G;
-    const G U;
-    const int volumeCB;
-    ChecksumArg(const GaugeField &U, bool mini) : U(U), volumeCB(mini ? 1 : U.VolumeCB()) { }
-  };
+  /**
+     @brief Generic checksum reduction.  This runs on the location of
+     the field: on the device as a regular reduction kernel and on the
+     host as an OpenMP reduction.
+   */
+  template <template <typename> class Functor, typename Arg> class ChecksumReduce : TunableReduction2D
+  {
+    Arg &arg;
+    const LatticeField &field;
+    checksum_t &checksum;
 
-  template <typename Arg>
-  __device__ __host__ inline uint64_t siteChecksum(const Arg &arg, int d, int parity, int x_cb) {
-    const Matrix<complex<typename Arg::real>,Arg::nColor> u = arg.U(d, x_cb, parity);
-    return u.checksum(); 
-  }
+  public:
+    ChecksumReduce(Arg &arg, const LatticeField &field, checksum_t &checksum) :
+      TunableReduction2D(field, arg.threads.y), arg(arg), field(field), checksum(checksum)
+    {
+      strcat(aux, Arg::scidac ? ",scidac" : ",xor");
+      if (arg.threads.x == 1) strcat(aux, ",mini");
+      apply(device::get_default_stream());
+    }
 
-  template <typename Arg>
-  uint64_t ChecksumCPU(const Arg &arg)
+    void apply(const qudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      launch<Functor, true>(checksum, tp, stream, arg);
+    }
+
+    long long bytes() const { return (field.Bytes() / field.VolumeCB()) * arg.threads.x; }
+  };
+
+  template <typename Float, int nColor, typename G, bool scidac>
+  void checksum(const GaugeField &u, bool mini, checksum_t &checksum)
   {
-    uint64_t checksum_ = 0;
-    for (int parity=0; parity<2; parity++)
-      for (int x_cb=0; x_cb<arg.volumeCB; x_cb++)
-	for (int d=0; d<arg.U.geometry; d++)
-	  checksum_ ^= siteChecksum(arg, d, parity, x_cb);
-    return checksum_;
+    GaugeChecksumArg<Float, nColor, G, scidac> arg(u, mini);
+    ChecksumReduce<GaugeChecksum, decltype(arg)>(arg, u, checksum);
   }
 
-  template <typename T, int Nc>
-  uint64_t Checksum(const GaugeField &u, bool mini)
+  template <typename Float, int nColor, bool scidac>
+  void checksum(const GaugeField &u, bool mini, checksum_t &checksum_)
   {
-    uint64_t checksum = 0;
-    if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_QDP_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+    if (u.isNative()) {
+      // compressed fields are checksummed on the reconstructed links
+      switch (u.Reconstruct()) {
+      case QUDA_RECONSTRUCT_NO:
+        checksum<Float, nColor, typename gauge_mapper<Float, QUDA_RECONSTRUCT_NO>::type, scidac>(u, mini, checksum_);
+        break;
+      case QUDA_RECONSTRUCT_12:
+        if constexpr (is_enabled<QUDA_RECONSTRUCT_12>())
+          checksum<Float, nColor, typename gauge_mapper<Float, QUDA_RECONSTRUCT_12>::type, scidac>(u, mini, checksum_);
+        else
+          errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-12", QUDA_RECONSTRUCT);
+        break;
+      case QUDA_RECONSTRUCT_8:
+        if constexpr (is_enabled<QUDA_RECONSTRUCT_8>())
+          checksum<Float, nColor, typename gauge_mapper<Float, QUDA_RECONSTRUCT_8>::type, scidac>(u, mini, checksum_);
+        else
+          errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-8", QUDA_RECONSTRUCT);
+        break;
+      default: errorQuda("Unsupported reconstruct %d", u.Reconstruct());
+      }
+    } else if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
+      checksum<Float, nColor, typename gauge_order_mapper<Float, QUDA_QDP_GAUGE_ORDER, nColor>::type, scidac>(u, mini, checksum_);
     } else if (u.Order() == QUDA_QDPJIT_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_QDPJIT_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum<Float, nColor, typename gauge_order_mapper<Float, QUDA_QDPJIT_GAUGE_ORDER, nColor>::type, scidac>(u, mini, checksum_);
     } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_MILC_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum<Float, nColor, typename gauge_order_mapper<Float, QUDA_MILC_GAUGE_ORDER, nColor>::type, scidac>(u, mini, checksum_);
     } else if (u.Order() == QUDA_BQCD_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_BQCD_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum<Float, nColor, typename gauge_order_mapper<Float, QUDA_BQCD_GAUGE_ORDER, nColor>::type, scidac>(u, mini, checksum_);
     } else if (u.Order() == QUDA_TIFR_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_TIFR_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum<Float, nColor, typename gauge_order_mapper<Float, QUDA_TIFR_GAUGE_ORDER, nColor>::type, scidac>(u, mini, checksum_);
     } else if (u.Order() == QUDA_TIFR_PADDED_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_TIFR_PADDED_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum<Float, nColor, typename gauge_order_mapper<Float, QUDA_TIFR_PADDED_GAUGE_ORDER, nColor>::type, scidac>(u, mini, checksum_);
     } else {
-      errorQuda("Checksum not implemented");
-    }    
+      errorQuda("Checksum not implemented for gauge order %d", u.Order());
+    }
+  }
 
-    return checksum;
+  template <bool scidac> checksum_t checksum(const GaugeField &u, bool mini)
+  {
+    if (u.Ncolor() != 3) errorQuda("Unsupported nColor = %d", u.Ncolor());
+    checksum_t checksum_ = {};
+    switch (u.Precision()) {
+    case QUDA_DOUBLE_PRECISION: checksum<double, 3, scidac>(u, mini, checksum_); break;
+    case QUDA_SINGLE_PRECISION: checksum<float, 3, scidac>(u, mini, checksum_); break;
+    default: errorQuda("Unsupported precision = %d", u.Precision());
+    }
+    return checksum_;
+  }
+
+  template <typename Float, int nSpin, int nColor, typename V, bool scidac>
+  void checksum(const ColorSpinorField &v, bool mini, checksum_t &checksum)
+  {
+    SpinorChecksumArg<Float, nSpin, nColor, V, scidac> arg(v, mini);
+    ChecksumReduce<SpinorChecksum, decltype(arg)>(arg, v, checksum);
   }
 
-  template <typename T>
-  uint64_t Checksum(const GaugeField &u, bool mini)
+  template <typename Float, int nSpin, int nColor, bool scidac>
+  void checksum(const ColorSpinorField &v, bool mini, checksum_t &checksum_)
   {
-    uint64_t checksum = 0;
-    switch (u.Ncolor()) {
-    case 3: checksum = Checksum<T,3>(u,mini); break;
-    default: errorQuda("Unsupported nColor = %d", u.Ncolor());
+    if (v.isNative()) {
+      checksum<Float, nSpin, nColor, typename colorspinor_mapper<Float, nSpin, nColor>::type, scidac>(v, mini, checksum_);
+    } else if constexpr (std::is_same_v<Float, double> || std::is_same_v<Float, float>) {
+      if (v.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
+        using V = typename colorspinor_order_mapper<Float, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER, nSpin, nColor>::type;
+        checksum<Float, nSpin, nColor, V, scidac>(v, mini, checksum_);
+      } else if (v.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
+        using V = typename colorspinor_order_mapper<Float, QUDA_SPACE_COLOR_SPIN_FIELD_ORDER, nSpin, nColor>::type;
+        checksum<Float, nSpin, nColor, V, scidac>(v, mini, checksum_);
+      } else {
+        errorQuda("Checksum not implemented for field order %d", v.FieldOrder());
+      }
+    } else {
+      errorQuda("Checksum not implemented for field order %d", v.FieldOrder());
     }
-    return checksum;
   }
 
-  uint64_t Checksum(const GaugeField &u, bool mini)
+  template <typename Float, bool scidac>
+  void checksum(const ColorSpinorField &v, bool mini, checksum_t &checksum_)
   {
-    uint64_t checksum = 0;
-    switch (u.Precision()) {
-    case QUDA_DOUBLE_PRECISION: checksum = Checksum<double>(u,mini); break;
-    case QUDA_SINGLE_PRECISION: checksum = Checksum<float>(u,mini); break;
-    default: errorQuda("Unsupported precision = %d", u.Precision());
+    if (v.Ncolor() != 3) errorQuda("Unsupported nColor = %d", v.Ncolor());
+    if (!is_enabled_spin(v.Nspin())) errorQuda("nSpin = %d has not been built", v.Nspin());
+
+    if (v.Nspin() == 4) {
+      if constexpr (is_enabled_spin(4)) checksum<Float, 4, 3, scidac>(v, mini, checksum_);
+    } else if (v.Nspin() == 2) {
+      if constexpr (is_enabled_spin(2)) checksum<Float, 2, 3, scidac>(v, mini, checksum_);
+    } else if (v.Nspin() == 1) {
+      if constexpr (is_enabled_spin(1)) checksum<Float, 1, 3, scidac>(v, mini, checksum_);
+    } else {
+      errorQuda("Unsupported nSpin = %d", v.Nspin());
+    }
+  }
+
+  template <bool scidac> checksum_t checksum(const ColorSpinorField &v, bool mini)
+  {
+    checksum_t checksum_ = {};
+    switch (v.Precision()) {
+    case QUDA_DOUBLE_PRECISION: checksum<double, scidac>(v, mini, checksum_); break;
+    case QUDA_SINGLE_PRECISION: checksum<float, scidac>(v, mini, checksum_); break;
+    case QUDA_HALF_PRECISION:
+      if constexpr (is_enabled(QUDA_HALF_PRECISION)) checksum<short, scidac>(v, mini, checksum_);
+      else errorQuda("QUDA_PRECISION=%d does not enable half precision", QUDA_PRECISION);
+      break;
+    default: errorQuda("Unsupported precision = %d", v.Precision());
     }
+    return checksum_;
+  }
 
-    comm_allreduce_xor(checksum);
+  template <typename Float, typename C> void checksum(const CloverField &c, bool inverse, bool mini, checksum_t &checksum)
+  {
+    CloverChecksumArg<Float, C> arg(c, inverse, mini);
+    ChecksumReduce<CloverChecksum, decltype(arg)>(arg, c, checksum);
+  }
 
-    return checksum;
+  template <typename Float> void checksum(const CloverField &c, bool inverse, bool mini, checksum_t &checksum_)
+  {
+    if (c.isNative()) {
+      if (c.Reconstruct()) {
+        checksum<Float, typename clover_mapper<Float, 72, false, true>::type>(c, inverse, mini, checksum_);
+      } else {
+        checksum<Float, typename clover_mapper<Float, 72, false, false>::type>(c, inverse, mini, checksum_);
+      }
+    } else if (c.Order() == QUDA_PACKED_CLOVER_ORDER) {
+      checksum<Float, clover::QDPOrder<Float>>(c, inverse, mini, checksum_);
+    } else {
+      errorQuda("Checksum not implemented for clover order %d", c.Order());
+    }
+  }
+
+  /**
+     @brief Combine the pair of 32-bit words back into the 64-bit checksum
+   */
+  inline uint64_t checksum_join(const checksum_t &c)
+  {
+    return (static_cast<uint64_t>(c[1]) << 32) | static_cast<uint64_t>(c[0]);
+  }
+
+  uint64_t Checksum(const GaugeField &u, bool mini) { return checksum_join(checksum<false>(u, mini)); }
+
+  std::array<uint32_t, 2> ScidacChecksum(const GaugeField &u)
+  {
+    for (int d = 0; d < u.Ndim(); d++)
+      if (u.R()[d]) errorQuda("SciDAC checksum not supported for extended fields");
+    auto c = checksum<true>(u, false);
+    return {static_cast<uint32_t>(c[0]), static_cast<uint32_t>(c[1])};
+  }
+
+  uint64_t Checksum(const ColorSpinorField &v, bool mini) { return checksum_join(checksum<false>(v, mini)); }
+
+  std::array<uint32_t, 2> ScidacChecksum(const ColorSpinorField &v)
+  {
+    if (v.SiteSubset() != QUDA_FULL_SITE_SUBSET) errorQuda("SciDAC checksum requires a full-parity field");
+    if (v.Precision() < QUDA_SINGLE_PRECISION) errorQuda("SciDAC checksum requires a single or double precision field");
+    auto c = checksum<true>(v, false);
+    return {static_cast<uint32_t>(c[0]), static_cast<uint32_t>(c[1])};
+  }
+
+  uint64_t Checksum(const CloverField &c, bool inverse, bool mini)
+  {
+    if (!c.data(inverse)) errorQuda("requested clover is_inverse=%d, but not allocated", inverse);
+    checksum_t checksum_ = {};
+    switch (c.Precision()) {
+    case QUDA_DOUBLE_PRECISION: checksum<double>(c, inverse, mini, checksum_); break;
+    case QUDA_SINGLE_PRECISION: checksum<float>(c, inverse, mini, checksum_); break;
+    default: errorQuda("Unsupported precision = %d", c.Precision());
+    }
+    return checksum_join(checksum_);
   }
 
-}
+} // namespace quda
@@ -190,6 +190,8 @@ namespace quda {
     if (aux_string.size() >= TuneKey::aux_n / 2) errorQuda("Aux string too large %lu", aux_string.size());
   }
 
+  uint64_t CloverField::checksum(bool inverse, bool mini) const { return Checksum(*this, inverse, mini); }
+
   void CloverField::backup(bool which) const
   {
     qudaMemcpy(backup_h[which], which ? cloverInv : clover, bytes, qudaMemcpyDefault);
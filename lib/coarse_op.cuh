@@ -272,6 +272,37 @@ namespace quda {
       strcat(aux, comm_dim_partitioned_string());
     }
 
+    /**
+       @brief Whether the host coarse-link accumulation can be
+       parallelized over aggregates rather than fine-grid sites.  This
+       requires the coarse-to-fine map, and aggregates that contain an
+       equal number of even and odd fine sites.  Setting
+       QUDA_ENABLE_COARSE_AGGREGATE_PARALLEL=0 forces the fine-site
+       accumulation, e.g., to verify the aggregate accumulation.
+    */
+    bool aggregateParallel() const
+    {
+      char *enable_env = getenv("QUDA_ENABLE_COARSE_AGGREGATE_PARALLEL");
+      if (enable_env && strcmp(enable_env, "0") == 0) return false;
+      return arg.coarse_to_fine && arg.fineVolumeCB % arg.coarseVolumeCB == 0
+        && (arg.fineVolumeCB / arg.coarseVolumeCB) % 2 == 0;
+    }
+
+    /**
+       @brief Launch the host coarse-link accumulation over aggregates:
+       one thread per coarse site and coarse-link tile, which walks the
+       fine sites of both parities
+    */
+    template <template <typename> class Functor> void launchAggregate(const TuneParam &tp, const qudaStream_t &stream)
+    {
+      auto threads = arg.threads;
+      arg.threads.x = 2 * arg.coarseVolumeCB;
+      arg.threads.y = arg.vuvTile.M_tiles;
+      arg.threads.z = arg.vuvTile.N_tiles;
+      launch_host<Functor>(tp, stream, arg);
+      arg.threads = threads;
+    }
+
     /**
        @brief Launcher for CPU instantiations of coarse-link construction
     */
@@ -336,12 +367,20 @@ namespace quda {
         errorQuda("Staggered dslash has not been built");
 #endif
       } else if (type == COMPUTE_VUV) {
-        launch_host<compute_vuv>(tp, stream, arg);
+        if (aggregateParallel()) {
+          launchAggregate<compute_vuv_aggregate>(tp, stream);
+        } else {
+          launch_host<compute_vuv>(tp, stream, arg);
+        }
       } else if (type == COMPUTE_VLV) {
         if (fineSpin != 1) errorQuda("compute_vlv should only be called for a staggered operator");
 
 #if defined(GPU_STAGGERED_DIRAC) && defined(STAGGEREDCOARSE)
-        else launch_host<compute_vlv>(tp, stream, arg);
+        if (aggregateParallel()) {
+          launchAggregate<compute_vlv_aggregate>(tp, stream);
+        } else {
+          launch_host<compute_vlv>(tp, stream, arg);
+        }
 #else
         errorQuda("Staggered dslash has not been built");
 #endif
@@ -965,6 +1004,9 @@ namespace quda {
      @param matpc[in] The type of preconditioning of the source fine-grid operator
      @param need_bidirectional[in] If we need to force bi-directional build or not. Required
      if some previous level was preconditioned, even if this one isn't
+     @param fine_to_coarse[in] Fine-to-coarse site map
+     @param coarse_to_fine[in] Coarse-to-fine site map
+     @param geo_offset[in] Offset of the aggregates from the origin
    */
   template <bool use_mma, QudaFieldLocation location, bool from_coarse, typename Float, int fineSpin, int fineColor, int coarseSpin,
             int coarseColor, typename avSpinor, typename uvSpinor, typename vSpinor, typename coarseGauge, typename coarseGaugeAtomic,
@@ -974,7 +1016,7 @@ namespace quda {
                   GaugeField &Y_atomic_, GaugeField &X_atomic_, ColorSpinorField &uv, ColorSpinorField &av,
                   const ColorSpinorField &v, double kappa, double mass, double mu,
                   double mu_factor, bool allow_truncation, QudaDiracType dirac, QudaMatPCType matpc, bool need_bidirectional,
-                  const int *fine_to_coarse, const int *coarse_to_fine)
+                  const int *fine_to_coarse, const int *coarse_to_fine, const int *geo_offset)
   {
     // For coarsening un-preconditioned operators we use uni-directional
     // coarsening to reduce the set up code.  For debugging we can force
@@ -1039,7 +1081,8 @@ namespace quda {
 
     using Arg = CalculateYArg<from_coarse, Float,fineSpin,coarseSpin,fineColor,coarseColor,coarseGauge,coarseGaugeAtomic,fineGauge,avSpinor,uvSpinor,vSpinor,fineClover>;
     Arg arg(Y, X, Y_atomic, X_atomic, UV, AV, G, L, K, V, C, Cinv, v, kappa, mass,
-	    mu, mu_factor, x_size, xc_size, spin_bs, fine_to_coarse, coarse_to_fine, bidirectional_links);
+	    mu, mu_factor, x_size, xc_size, spin_bs, fine_to_coarse, coarse_to_fine, geo_offset,
+            bidirectional_links);
     arg.max_h = static_cast<Float*>(pool_pinned_malloc(sizeof(Float)));
     arg.max_d = static_cast<Float*>(pool_device_malloc(sizeof(Float)));
 
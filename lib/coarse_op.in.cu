@@ -67,7 +67,7 @@ namespace quda {
 	(yAccessor, xAccessor, yAccessorAtomic, xAccessorAtomic, uvAccessor,
 	 avAccessor, vAccessor, gAccessor, gAccessor, gAccessor, cAccessor, cInvAccessor, Y, X, Yatomic, Xatomic, uv, av, v,
          kappa, mass, mu, mu_factor, staggered_allow_truncation, dirac, matpc, need_bidirectional,
-	 T.fineToCoarse(location), T.coarseToFine(location));
+	 T.fineToCoarse(location), T.coarseToFine(location), T.Geo_offset());
 
     } else {
 
@@ -103,7 +103,7 @@ namespace quda {
         (yAccessor, xAccessor, yAccessorAtomic, xAccessorAtomic, uvAccessor,
          avAccessor, vAccessor, gAccessor, gAccessor, gAccessor, cAccessor, cInvAccessor, Y, X, Yatomic, Xatomic, uv, av, v,
          kappa, mass, mu, mu_factor, staggered_allow_truncation, dirac, matpc, need_bidirectional,
-         T.fineToCoarse(location), T.coarseToFine(location));
+         T.fineToCoarse(location), T.coarseToFine(location), T.Geo_offset());
     }
 
   }
@@ -1553,6 +1553,8 @@ namespace quda
     genericPrintVector(*this, parity, x_cb, rank);
   }
 
+  uint64_t ColorSpinorField::checksum(bool mini) const { return Checksum(*this, mini); }
+
   int ColorSpinorField::Compare(const ColorSpinorField &a, const ColorSpinorField &b, const int tol)
   {
     if (checkLocation(a, b) == QUDA_CUDA_FIELD_LOCATION) errorQuda("device field not implemented");
@@ -47,23 +47,25 @@ namespace quda
     return search->second;
   }
 
-  void push_communicator(const CommKey &split_key)
+  void push_communicator(const CommKey &split_key, bool retain)
   {
     if (comm_nvshmem_enabled())
       errorQuda("Split-grid is currently not supported with NVSHMEM. Set QUDA_ENABLE_NVSHMEM=0 to disable NVSHMEM.");
 
     // if reverting to global, we will need to join the tunecaches
-    bool join_tune_cache = split_key == default_comm_key;
+    bool join_tune_cache = split_key == default_comm_key && !retain;
     int local_rank = comm_rank();
     int local_tune_rank = 0;
 
     // used to store the size of the tunecache at the point of splitting
     static size_t tune_cache_size = 0;
 
-    // destroy any message handles associate with the prior communicator
-    LatticeField::freeGhostBuffer();
-    ColorSpinorField::freeGhostBuffer();
-    FieldTmp<ColorSpinorField>::destroy();
+    // destroy any message handles associate with the prior communicator, unless the caller retains them for reuse
+    if (!retain) {
+      LatticeField::freeGhostBuffer();
+      ColorSpinorField::freeGhostBuffer();
+      FieldTmp<ColorSpinorField>::destroy();
+    }
 
     auto search = communicator_stack.find(split_key);
     if (search == communicator_stack.end()) {
@@ -99,7 +101,7 @@ namespace quda
         // we now have a list of all the global tune ranks so we can join them
         joinTuneCache(global_tune_ranks);
       }
-    } else if (!join_tune_cache) {
+    } else if (!retain) {
       // record size of tunecache when first splitting the grid
       tune_cache_size = getTuneCache().size();
     }
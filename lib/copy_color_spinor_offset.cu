@@ -64,6 +64,18 @@ namespace quda
   {
     checkPrecision(out, in);
     checkLocation(out, in); // check all locations match
+
+    // multigrid fields are copied site by site on the host
+    if (in.Ncolor() != 3) {
+      if (in.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Multigrid fields must be copied on the host");
+      if (in.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER || out.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+        errorQuda("Unsupported field orders in = %d out = %d", in.FieldOrder(), out.FieldOrder());
+      if (pc_type != QUDA_4D_PC) errorQuda("Multigrid fields must use 4-d even-odd preconditioning");
+      size_t site_bytes = 2 * in.Nspin() * in.Ncolor() * in.Precision();
+      copy_field_offset_sites(out, in, offset, site_bytes, out.data(), in.data());
+      return;
+    }
+
     instantiate<CopyColorSpinorOffset>(out, in, offset, pc_type);
   }
 
@@ -1,3 +1,4 @@
+#include <cstring>
 #include <kernels/copy_field_offset.cuh>
 #include <tunable_nd.h>
 
@@ -42,4 +43,60 @@ namespace quda
     }
   };
 
+  /**
+     @brief Host-side offset copy that moves each site as an opaque
+     block of bytes.  This is used for host fields that store each
+     site contiguously and whose number of colors is not instantiated
+     by the kernel above, e.g., the multigrid fields that are
+     agglomerated onto a split grid.  Only full fields with 4-d
+     even-odd ordering are supported.
+     @param[in] out Output field
+     @param[in] in Input field
+     @param[in] offset Offset of the smaller field within the larger
+     @param[in] site_bytes Number of bytes per site
+     @param[out] out_data Base pointer of the output field
+     @param[in] in_data Base pointer of the input field
+  */
+  inline void copy_field_offset_sites(const LatticeField &out, const LatticeField &in, CommKey offset,
+                                      size_t site_bytes, void *out_data, const void *in_data)
+  {
+    if (in.SiteSubset() != QUDA_FULL_SITE_SUBSET || out.SiteSubset() != QUDA_FULL_SITE_SUBSET)
+      errorQuda("Only full fields are supported");
+    if ((offset[0] + offset[1] + offset[2] + offset[3]) % 2 == 1)
+      errorQuda("Offset (%d,%d,%d,%d) not supported", offset[0], offset[1], offset[2], offset[3]);
+
+    bool collect = out.VolumeCB() > in.VolumeCB();
+    const LatticeField &small = collect ? in : out;
+    const LatticeField &large = collect ? out : in;
+    int X[4], Y[4];
+    for (int d = 0; d < 4; d++) {
+      X[d] = small.full_dim(d);
+      Y[d] = large.full_dim(d);
+    }
+
+    auto out_ptr = static_cast<char *>(out_data);
+    auto in_ptr = static_cast<const char *>(in_data);
+
+    for (int parity = 0; parity < 2; parity++) {
+      for (int x_cb = 0; x_cb < small.VolumeCB(); x_cb++) {
+        int za = x_cb / (X[0] / 2);
+        int zb = za / X[1];
+        int x1 = za - zb * X[1];
+        int x3 = zb / X[2];
+        int x2 = zb - x3 * X[2];
+        int x0 = 2 * (x_cb - za * (X[0] / 2)) + ((x1 + x2 + x3 + parity) & 1);
+
+        // the offset is even so the parity is unchanged
+        int y_cb = ((((x3 + offset[3]) * Y[2] + x2 + offset[2]) * Y[1] + x1 + offset[1]) * Y[0] + x0 + offset[0]) / 2;
+
+        size_t small_idx = (parity * static_cast<size_t>(small.VolumeCB()) + x_cb) * site_bytes;
+        size_t large_idx = (parity * static_cast<size_t>(large.VolumeCB()) + y_cb) * site_bytes;
+        if (collect)
+          memcpy(out_ptr + large_idx, in_ptr + small_idx, site_bytes);
+        else
+          memcpy(out_ptr + small_idx, in_ptr + large_idx, site_bytes);
+      }
+    }
+  }
+
 } // namespace quda
@@ -51,8 +51,14 @@ namespace quda
 
     void apply(const qudaStream_t &stream) override
     {
-      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       arg.threads.x = size;
+      if (location == QUDA_CPU_FIELD_LOCATION && !is_ghost) {
+        // the host body copy is cache blocked rather than following the device thread decomposition
+        CopyGaugeHost(arg);
+        return;
+      }
+
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       constexpr bool enable_host = true;
       if (!is_ghost)
         launch<CopyGauge_, enable_host>(tp, stream, arg);
@@ -119,6 +119,16 @@ namespace quda
       errorQuda("Field geometries %d %d do not match", out.Geometry(), in.Geometry());
     }
 
+    // coarse link fields are copied site by site on the host
+    if (in.LinkType() == QUDA_COARSE_LINKS) {
+      if (in.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Coarse link fields must be copied on the host");
+      if (in.Order() != QUDA_MILC_GAUGE_ORDER || out.Order() != QUDA_MILC_GAUGE_ORDER)
+        errorQuda("Unsupported field orders in = %d out = %d", in.Order(), out.Order());
+      size_t site_bytes = 2 * in.Geometry() * in.Ncolor() * in.Ncolor() * in.Precision();
+      copy_field_offset_sites(out, in, offset, site_bytes, out.data(), in.data());
+      return;
+    }
+
     instantiate<CopyGaugeOffset>(out, in, offset);
   }
 
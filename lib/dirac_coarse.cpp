@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <transfer.h>
 #include <blas_quda.h>
+#include <mg_checkpoint.h>
+#include <split_grid.h>
 
 namespace quda {
 
@@ -26,7 +28,7 @@ namespace quda {
     init_cpu(!gpu_setup),
     mapped(mapped)
   {
-    initializeCoarse();
+    initializeCoarse(param.checkpoint);
   }
 
   DiracCoarse::DiracCoarse(const DiracParam &param, std::shared_ptr<GaugeField> Y_h, std::shared_ptr<GaugeField> X_h,
@@ -226,16 +228,22 @@ namespace quda {
       Xinv_h = std::make_shared<GaugeField>(gParam);
   }
 
-  void DiracCoarse::initializeCoarse()
+  void DiracCoarse::initializeCoarse(MGCheckpoint *checkpoint)
   {
-    createY(gpu_setup, mapped);
+    if (checkpoint) {
+      load(*checkpoint);
+      return;
+    }
+
+    // the link fields are reused if they already exist, e.g., when updating
+    if (!(gpu_setup ? Y_d : Y_h)) createY(gpu_setup, mapped);
 
     if (!gpu_setup) {
 
       dirac->createCoarseOp(*Y_h, *X_h, *transfer, kappa, mass, Mu(), MuFactor(), AllowTruncation());
       if (getVerbosity() >= QUDA_VERBOSE) printfQuda("About to build the preconditioned coarse clover\n");
 
-      createYhat(gpu_setup);
+      if (!Yhat_h) createYhat(gpu_setup);
 
       if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Finished building the preconditioned coarse clover\n");
       if (getVerbosity() >= QUDA_VERBOSE) printfQuda("About to create the preconditioned coarse op\n");
@@ -254,7 +262,7 @@ namespace quda {
 
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("About to build the preconditioned coarse clover\n");
 
-        createYhat(gpu_setup);
+        if (!Yhat_d) createYhat(gpu_setup);
 
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Finished building the preconditioned coarse clover\n");
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("About to create the preconditioned coarse op\n");
@@ -284,7 +292,7 @@ namespace quda {
 
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("About to build the preconditioned coarse clover\n");
 
-        createYhat(gpu_setup);
+        if (!Yhat_d) createYhat(gpu_setup);
 
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Finished building the preconditioned coarse clover\n");
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("About to create the preconditioned coarse op\n");
@@ -311,6 +319,89 @@ namespace quda {
     }
   }
 
+  void DiracCoarse::updateCoarseOp(const Dirac *dirac)
+  {
+    if (!(gpu_setup ? init_gpu : init_cpu)) errorQuda("Only the instance that built the coarse fields can update them");
+    this->dirac = dirac;
+
+    // rebuild in the setup location, in place
+    initializeCoarse();
+
+    // refresh any copy lazily created in the other memory space
+    if (gpu_setup && enable_cpu) {
+      Y_h->copy(*Y_d);
+      Yhat_h->copy(*Yhat_d);
+      X_h->copy(*X_d);
+      Xinv_h->copy(*Xinv_d);
+    } else if (!gpu_setup && enable_gpu) {
+      Y_d->copy(*Y_h);
+      if (need_aos_gauge_copy) { Y_aos_d->copy(*Y_d); }
+      Yhat_d->copy(*Yhat_h);
+      if (need_aos_gauge_copy) {
+        Yhat_aos_d->copy(*Yhat_d);
+        Yhat_aos_d->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+      }
+      X_d->copy(*X_h);
+      if (need_aos_gauge_copy) { X_aos_d->copy(*X_d); }
+      Xinv_d->copy(*Xinv_h);
+      if (need_aos_gauge_copy) { Xinv_aos_d->copy(*Xinv_d); }
+    }
+  }
+
+  DiracCoarse *DiracCoarse::agglomerate(const DiracParam &param, const CommKey &split_key) const
+  {
+    // use the fields from the memory space where the setup was done
+    bool gpu = gpu_setup ? enable_gpu : !enable_cpu;
+    std::vector<const GaugeField *> fields = {gpu ? Y_d.get() : Y_h.get(), gpu ? X_d.get() : X_h.get(),
+                                              gpu ? Xinv_d.get() : Xinv_h.get(), gpu ? Yhat_d.get() : Yhat_h.get()};
+
+    // collect each field on the host, where the sites are stored contiguously
+    std::vector<GaugeField> collected;
+    collected.reserve(fields.size());
+    for (auto &f : fields) {
+      GaugeFieldParam host_param(*f);
+      host_param.location = QUDA_CPU_FIELD_LOCATION;
+      host_param.order = QUDA_MILC_GAUGE_ORDER;
+      host_param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+      host_param.nFace = 0;
+      host_param.pad = 0;
+      host_param.create = QUDA_NULL_FIELD_CREATE;
+      host_param.mem_type = QUDA_MEMORY_DEVICE;
+      GaugeField host(host_param);
+      host.copy(*f);
+
+      for (int d = 0; d < CommKey::n_dim; d++) host_param.x[d] *= split_key[d];
+      collected.emplace_back(host_param);
+      split_field(collected.back(), {host}, split_key);
+    }
+
+    push_communicator(split_key);
+
+    std::vector<std::shared_ptr<GaugeField>> split(fields.size());
+    for (auto i = 0u; i < fields.size(); i++) {
+      GaugeFieldParam split_param(*fields[i]);
+      split_param.location = QUDA_CUDA_FIELD_LOCATION;
+      split_param.order = QUDA_FLOAT2_GAUGE_ORDER;
+      split_param.create = QUDA_NULL_FIELD_CREATE;
+      split_param.mem_type = QUDA_MEMORY_DEVICE;
+      auto &x = split_param.x;
+      for (int d = 0; d < CommKey::n_dim; d++) x[d] *= split_key[d];
+      int pad = std::max({(x[0] * x[1] * x[2]) / 2, (x[1] * x[2] * x[3]) / 2, (x[0] * x[2] * x[3]) / 2,
+                          (x[0] * x[1] * x[3]) / 2});
+      split_param.pad = split_param.nFace * pad * 2; // bi-directional ghost zone
+
+      split[i] = std::make_shared<GaugeField>(split_param);
+      split[i]->copy(collected[i]);
+      if (split_param.nFace > 0) split[i]->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+    }
+
+    auto dirac = new DiracCoarse(param, nullptr, nullptr, nullptr, nullptr, split[0], split[1], split[2], split[3]);
+
+    push_communicator(default_comm_key);
+
+    return dirac;
+  }
+
   // we only copy to host or device lazily on demand
   void DiracCoarse::initializeLazy(QudaFieldLocation location) const
   {
@@ -350,6 +441,55 @@ namespace quda {
     }
   }
 
+  void DiracCoarse::save(MGCheckpoint &checkpoint) const
+  {
+    // save from the memory space where the setup was done
+    bool gpu = gpu_setup ? enable_gpu : !enable_cpu;
+    checkpoint.save(gpu ? *Y_d : *Y_h);
+    checkpoint.save(gpu ? *X_d : *X_h);
+    checkpoint.save(gpu ? *Xinv_d : *Xinv_h);
+    checkpoint.save(gpu ? *Yhat_d : *Yhat_h);
+  }
+
+  void DiracCoarse::load(MGCheckpoint &checkpoint)
+  {
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Restoring coarse op from %s\n", checkpoint.Filename().c_str());
+
+    createY(gpu_setup, mapped);
+    createYhat(gpu_setup);
+
+    auto &Y = gpu_setup ? *Y_d : *Y_h;
+    auto &X = gpu_setup ? *X_d : *X_h;
+    auto &Xinv = gpu_setup ? *Xinv_d : *Xinv_h;
+    auto &Yhat = gpu_setup ? *Yhat_d : *Yhat_h;
+
+    checkpoint.load(Y);
+    checkpoint.load(X);
+    checkpoint.load(Xinv);
+    checkpoint.load(Yhat);
+
+    // the halos are not stored in the checkpoint so regenerate them
+    Y.exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+    Yhat.exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+
+    if (gpu_setup && need_aos_gauge_copy) {
+      Y_aos_d->copy(*Y_d);
+      Y_aos_d->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+      X_aos_d->copy(*X_d);
+      Yhat_aos_d->copy(*Yhat_d);
+      Yhat_aos_d->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+      Xinv_aos_d->copy(*Xinv_d);
+    }
+
+    if (gpu_setup) {
+      enable_gpu = true;
+      init_gpu = true;
+    } else {
+      enable_cpu = true;
+      init_cpu = true;
+    }
+  }
+
   bool DiracCoarse::apply_mma(cvector_ref<ColorSpinorField> &f, bool use_mma) { return (f.size() > 1) && use_mma; }
 
   void DiracCoarse::createPreconditionedCoarseOp(GaugeField &Yhat, GaugeField &Xinv, const GaugeField &Y, const GaugeField &X) {
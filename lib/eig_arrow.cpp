@@ -0,0 +1,379 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <util_quda.h>
+#include <eig_arrow.h>
+#include <eigen_helper.h>
+
+namespace quda
+{
+
+  namespace arrow
+  {
+
+    using Matrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+    using Vector = Eigen::VectorXd;
+
+    /** Tridiagonal blocks at or below this size are solved directly */
+    constexpr int leaf_size = 32;
+
+    /** Maximum number of iterations for each secular root */
+    constexpr int max_secular_iter = 200;
+
+    constexpr double eps = std::numeric_limits<double>::epsilon();
+
+    /** Givens rotation used to deflate a pair of close poles */
+    struct Rotation {
+      int p;
+      int j;
+      double c;
+      double s;
+    };
+
+    /**
+       @brief Eigen-decomposition of the arrowhead matrix H = [diag(d)
+       z; z^T a] of dimension n + 1.  Row n of U corresponds to the
+       corner element.  Eigenvalues are returned in ascending order.
+       @param[out] evals The eigenvalues
+       @param[out] U The eigenvectors (columns)
+       @param[in] d The diagonal (poles)
+       @param[in] z The arrow (couplings)
+       @param[in] a The corner element
+    */
+    void arrowhead(Vector &evals, Matrix &U, const Vector &d, const Vector &z, double a)
+    {
+      const int n = d.size();
+      const int N = n + 1;
+      evals.resize(N);
+      U = Matrix::Zero(N, N);
+
+      double scale = std::abs(a);
+      for (int i = 0; i < n; i++) scale = std::max(scale, std::max(std::abs(d[i]), std::abs(z[i])));
+      const double tol = 8.0 * eps * scale;
+
+      std::vector<double> dd(d.data(), d.data() + n);
+      std::vector<double> zz(z.data(), z.data() + n);
+      std::vector<int> perm(n);
+      std::iota(perm.begin(), perm.end(), 0);
+      std::stable_sort(perm.begin(), perm.end(), [&](int i, int j) { return dd[i] < dd[j]; });
+
+      // Deflation: a negligible coupling leaves (d_i, e_i) as an
+      // eigenpair, and a pair of close poles can be rotated such that
+      // one of the couplings vanishes
+      std::vector<int> nd;
+      std::vector<int> deflated;
+      std::vector<Rotation> rotations;
+      for (auto i : perm) {
+        if (std::abs(zz[i]) <= tol) {
+          deflated.push_back(i);
+          continue;
+        }
+        if (!nd.empty()) {
+          int p = nd.back();
+          double r = std::hypot(zz[p], zz[i]);
+          double c = zz[p] / r;
+          double s = zz[i] / r;
+          if (std::abs(c * s * (dd[i] - dd[p])) <= tol) {
+            double dp = c * c * dd[p] + s * s * dd[i];
+            double di = s * s * dd[p] + c * c * dd[i];
+            dd[p] = dp;
+            dd[i] = di;
+            zz[p] = r;
+            zz[i] = 0.0;
+            rotations.push_back({p, i, c, s});
+            deflated.push_back(i);
+            continue;
+          }
+        }
+        nd.push_back(i);
+      }
+
+      // The non-deflated problem, with the poles in ascending order
+      const int m = nd.size();
+      std::vector<double> ds(m), zs(m);
+      double znorm = 0.0;
+      for (int k = 0; k < m; k++) {
+        ds[k] = dd[nd[k]];
+        zs[k] = zz[nd[k]];
+        znorm += zs[k] * zs[k];
+      }
+      znorm = std::sqrt(znorm);
+
+      // Each root is stored as an offset tau from its nearest pole
+      // (origin), such that differences lambda_k - d_j are computed
+      // without cancellation
+      std::vector<int> origin(m + 1);
+      std::vector<double> tau(m + 1);
+      std::vector<double> lambda(m + 1);
+
+      auto secular = [&](int o, double t, double &f, double &fp, double &f_abs) {
+        f = a - ds[o] - t;
+        fp = -1.0;
+        f_abs = std::abs(a) + std::abs(ds[o] + t);
+        for (int j = 0; j < m; j++) {
+          double inv = 1.0 / ((ds[j] - ds[o]) - t);
+          double term = zs[j] * zs[j] * inv;
+          f -= term;
+          fp -= term * inv;
+          f_abs += std::abs(term);
+        }
+      };
+
+      if (m == 0) {
+        // fully deflated: the corner is an eigenvalue
+        lambda[0] = a;
+      } else {
+#pragma omp parallel for schedule(dynamic, 8)
+        for (int k = 0; k <= m; k++) {
+          // the interval containing root k, relative to its origin
+          int o;
+          double t_lo, t_hi;
+          if (k == 0) {
+            o = 0;
+            t_lo = std::min(ds[0], a) - ds[0] - 1.01 * znorm - tol;
+            t_hi = 0.0;
+          } else if (k == m) {
+            o = m - 1;
+            t_lo = 0.0;
+            t_hi = std::max(ds[m - 1], a) - ds[m - 1] + 1.01 * znorm + tol;
+          } else {
+            double h = ds[k] - ds[k - 1];
+            double f, fp, f_abs;
+            secular(k - 1, 0.5 * h, f, fp, f_abs);
+            if (f > 0) {
+              // the root lies in the upper half of the interval
+              o = k;
+              t_lo = -0.5 * h;
+              t_hi = 0.0;
+            } else {
+              o = k - 1;
+              t_lo = 0.0;
+              t_hi = 0.5 * h;
+            }
+          }
+
+          // Newton iteration, safeguarded by bisection; the secular
+          // function is monotonically decreasing on the interval
+          double t = 0.5 * (t_lo + t_hi);
+          for (int iter = 0; iter < max_secular_iter; iter++) {
+            double f, fp, f_abs;
+            secular(o, t, f, fp, f_abs);
+            if (std::abs(f) <= 4.0 * eps * f_abs) break;
+            if (f > 0)
+              t_lo = t;
+            else
+              t_hi = t;
+
+            double t_new = t - f / fp;
+            if (!(t_new > t_lo && t_new < t_hi)) t_new = 0.5 * (t_lo + t_hi);
+            if (t_new == t || t_hi - t_lo <= 2.0 * eps * std::max(std::abs(t_lo), std::abs(t_hi))) {
+              t = t_new;
+              break;
+            }
+            t = t_new;
+          }
+
+          origin[k] = o;
+          tau[k] = t;
+          lambda[k] = ds[o] + t;
+        }
+      }
+
+      // lambda_k - d_j
+      auto diff = [&](int k, int j) { return (ds[origin[k]] - ds[j]) + tau[k]; };
+
+      // Recompute the couplings from the computed roots (Loewner), such
+      // that the computed roots are the exact eigenvalues of a nearby
+      // arrowhead and the eigenvectors are orthogonal
+      std::vector<double> zhat(m);
+#pragma omp parallel for schedule(static)
+      for (int i = 0; i < m; i++) {
+        double prod = -diff(i, i) * diff(i + 1, i);
+        for (int k = 0; k < i; k++) prod *= diff(k, i) / (ds[k] - ds[i]);
+        for (int k = i + 1; k < m; k++) prod *= diff(k + 1, i) / (ds[k] - ds[i]);
+        zhat[i] = std::copysign(std::sqrt(std::abs(prod)), zs[i]);
+      }
+
+      // Eigenvectors of the non-deflated problem
+      Matrix V(m + 1, m + 1);
+#pragma omp parallel for schedule(static)
+      for (int k = 0; k <= m; k++) {
+        for (int j = 0; j < m; j++) V(j, k) = zhat[j] / diff(k, j);
+        V(m, k) = 1.0;
+        V.col(k).normalize();
+      }
+
+      // Merge the non-deflated and deflated eigenpairs in ascending order
+      std::vector<std::pair<double, int>> order;
+      order.reserve(N);
+      for (int k = 0; k <= m; k++) order.push_back({lambda[k], k});
+      for (auto i : deflated) order.push_back({dd[i], -1 - i});
+      std::stable_sort(order.begin(), order.end(),
+                       [](const std::pair<double, int> &x, const std::pair<double, int> &y) { return x.first < y.first; });
+
+#pragma omp parallel for schedule(static)
+      for (int col = 0; col < N; col++) {
+        evals[col] = order[col].first;
+        int k = order[col].second;
+        if (k >= 0) {
+          for (int j = 0; j < m; j++) U(nd[j], col) = V(j, k);
+          U(n, col) = V(m, k);
+        } else {
+          U(-1 - k, col) = 1.0;
+        }
+      }
+
+      // Undo the deflating rotations, last first
+      for (auto r = rotations.rbegin(); r != rotations.rend(); r++) {
+        Eigen::RowVectorXd up = U.row(r->p);
+        Eigen::RowVectorXd uj = U.row(r->j);
+        U.row(r->p) = r->c * up - r->s * uj;
+        U.row(r->j) = r->s * up + r->c * uj;
+      }
+    }
+
+    /**
+       @brief Merge two eigen-decomposed blocks through a coupling
+       element.  The matrix is block diagonal [B1, a, B2], where the
+       corner element a couples to B1 and B2 through z1 and z2
+       (expressed in the eigenbases of the blocks).  The merged
+       eigenbasis is returned in the original basis.
+       @param[out] evals The eigenvalues of the merged matrix
+       @param[out] Q The eigenvectors of the merged matrix
+       @param[in] e1 The eigenvalues of B1
+       @param[in] Q1 The eigenvectors of B1, or nullptr if B1 is diagonal
+       @param[in] z1 The coupling of a to B1
+       @param[in] a The corner element
+       @param[in] e2 The eigenvalues of B2
+       @param[in] Q2 The eigenvectors of B2
+       @param[in] z2 The coupling of a to B2
+    */
+    void merge(Vector &evals, Matrix &Q, const Vector &e1, const Matrix *Q1, const Vector &z1, double a,
+               const Vector &e2, const Matrix &Q2, const Vector &z2)
+    {
+      const int n1 = e1.size();
+      const int n2 = e2.size();
+      const int N = n1 + n2 + 1;
+
+      Vector d(n1 + n2), z(n1 + n2);
+      d << e1, e2;
+      z << z1, z2;
+
+      Matrix U;
+      arrowhead(evals, U, d, z, a);
+
+      // back transformation: rows of U are ordered [B1, B2, a]
+      Q.resize(N, N);
+      if (Q1)
+        Q.topRows(n1).noalias() = (*Q1) * U.topRows(n1);
+      else
+        Q.topRows(n1) = U.topRows(n1);
+      Q.row(n1) = U.row(n1 + n2);
+      Q.bottomRows(n2).noalias() = Q2 * U.middleRows(n1, n2);
+    }
+
+    /**
+       @brief Divide-and-conquer eigen-decomposition of a symmetric
+       tridiagonal matrix
+       @param[out] evals The eigenvalues in ascending order
+       @param[out] Q The eigenvectors (columns)
+       @param[in] diag The diagonal (length n)
+       @param[in] offdiag The sub-diagonal (length n - 1)
+       @param[in] n The dimension
+    */
+    void tridiagonal(Vector &evals, Matrix &Q, const double *diag, const double *offdiag, int n)
+    {
+      if (n == 0) {
+        evals.resize(0);
+        Q.resize(0, 0);
+      } else if (n == 1) {
+        evals = Vector::Constant(1, diag[0]);
+        Q = Matrix::Identity(1, 1);
+      } else if (n <= leaf_size) {
+        SelfAdjointEigenSolver<Matrix> eigensolver;
+        Vector d = Eigen::Map<const Vector>(diag, n);
+        Vector e = Eigen::Map<const Vector>(offdiag, n - 1);
+        eigensolver.computeFromTridiagonal(d, e, ComputeEigenvectors);
+        evals = eigensolver.eigenvalues();
+        Q = eigensolver.eigenvectors();
+      } else {
+        // split about the middle row, which becomes the corner of the arrowhead
+        const int m = n / 2;
+        Vector e1, e2;
+        Matrix Q1, Q2;
+        tridiagonal(e1, Q1, diag, offdiag, m);
+        tridiagonal(e2, Q2, diag + m + 1, offdiag + m + 1, n - m - 1);
+
+        Vector z1 = offdiag[m - 1] * Q1.row(m - 1).transpose();
+        Vector z2 = offdiag[m] * Q2.row(0).transpose();
+        merge(evals, Q, e1, &Q1, z1, diag[m], e2, Q2, z2);
+      }
+    }
+
+  } // namespace arrow
+
+  void arrowEigensolve(double *evals, double *evecs, const double *diag, const double *offdiag, int dim, int arrow_pos)
+  {
+    if (dim <= 0) errorQuda("Invalid dimension %d", dim);
+    if (arrow_pos < 0 || arrow_pos >= dim) errorQuda("Invalid arrow position %d for dimension %d", arrow_pos, dim);
+
+    // The leading arrow_pos x arrow_pos block is diagonal, so the
+    // matrix is already the merge of that block with the trailing
+    // tridiagonal block through the arrow row
+    const int n2 = dim - arrow_pos - 1;
+    arrow::Vector e2;
+    arrow::Matrix Q2;
+    arrow::tridiagonal(e2, Q2, diag + arrow_pos + 1, offdiag + arrow_pos + 1, n2);
+
+    arrow::Vector e1 = Eigen::Map<const arrow::Vector>(diag, arrow_pos);
+    arrow::Vector z1 = Eigen::Map<const arrow::Vector>(offdiag, arrow_pos);
+    arrow::Vector z2 = n2 > 0 ? arrow::Vector(offdiag[arrow_pos] * Q2.row(0).transpose()) : arrow::Vector(0);
+
+    arrow::Vector lambda;
+    arrow::Matrix Q;
+    arrow::merge(lambda, Q, e1, nullptr, z1, diag[arrow_pos], e2, Q2, z2);
+
+    for (int i = 0; i < dim; i++) evals[i] = lambda[i];
+    Eigen::Map<arrow::Matrix>(evecs, dim, dim) = Q;
+  }
+
+  void arrowEigensolveDense(double *evals, double *evecs, const double *diag, const double *offdiag, int dim,
+                            int arrow_pos)
+  {
+    arrow::Matrix A = arrow::Matrix::Zero(dim, dim);
+
+    // Construct arrow mat A_{dim,dim}
+    for (int i = 0; i < dim; i++) {
+
+      // alpha populates the diagonal
+      A(i, i) = diag[i];
+    }
+
+    for (int i = 0; i < arrow_pos; i++) {
+
+      // beta populates the arrow
+      A(i, arrow_pos) = offdiag[i];
+      A(arrow_pos, i) = offdiag[i];
+    }
+
+    for (int i = arrow_pos; i < dim - 1; i++) {
+
+      // beta populates the sub-diagonal
+      A(i, i + 1) = offdiag[i];
+      A(i + 1, i) = offdiag[i];
+    }
+
+    // Eigensolve the arrow matrix
+    Eigen::SelfAdjointEigenSolver<arrow::Matrix> eigensolver;
+    eigensolver.compute(A);
+
+    for (int i = 0; i < dim; i++) {
+      evals[i] = eigensolver.eigenvalues()[i];
+      for (int j = 0; j < dim; j++) evecs[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
+    }
+  }
+
+} // namespace quda
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <quda_internal.h>
+#include <util_quda.h>
+#include <eig_hessenberg.h>
+#include <eigen_helper.h>
+
+namespace quda
+{
+
+  /**
+     @brief Givens rotation G = [c s; -conj(s) c] with real c, such
+     that G [x; y] = [r; 0]
+  */
+  struct Givens {
+    double c = 1.0;
+    Complex s = 0.0;
+
+    Givens() = default;
+    Givens(const Complex &x, const Complex &y)
+    {
+      double ax = abs(x);
+      double rho = sqrt(norm(x) + norm(y));
+      if (rho == 0.0) return;
+      if (ax == 0.0) {
+        c = 0.0;
+        s = conj(y) / abs(y);
+      } else {
+        c = ax / rho;
+        s = (x / ax) * conj(y) / rho;
+      }
+    }
+  };
+
+  /**
+     @brief State of one bulge in the multi-shift sweep
+  */
+  struct Bulge {
+    Complex shift = 0.0; /** The shift applied by this bulge */
+    int pos = 0;         /** The row of the next rotation */
+    bool chase = false;  /** Whether we are chasing (true) or starting a new block (false) */
+    bool apply = false;  /** Whether the rotation at this step is applied */
+    Givens G;            /** The rotation at this step */
+  };
+
+  void hessenbergQRShifts(std::vector<std::vector<Complex>> &H, std::vector<std::vector<Complex>> &Q,
+                          const std::vector<Complex> &shifts, int num_shifts, double tol)
+  {
+    const int n_kr = H.size();
+    if (num_shifts > static_cast<int>(shifts.size()))
+      errorQuda("Requested %d shifts but only %lu given", num_shifts, shifts.size());
+
+    // Reset Q to the identity
+    Q.resize(n_kr);
+    for (auto &row : Q) row.resize(n_kr);
+    for (int i = 0; i < n_kr; i++)
+      for (int j = 0; j < n_kr; j++) Q[i][j] = (i == j) ? 1.0 : 0.0;
+
+    // Each shift is applied as an implicit single-shift QR step: a
+    // bulge introduced at the top of the upper Hessenberg matrix is
+    // chased to the bottom with Givens rotations.  Bulges spaced three
+    // rows apart act on disjoint rows and columns, so we chase all the
+    // shifts as a pipelined wave, with the rotations of the bulges in
+    // flight applied in parallel.  A sub-diagonal element below
+    // tol splits the matrix, in which case the bulge is restarted
+    // below the split, as in the explicit QR iteration.
+    const int spacing = 3;
+
+    std::vector<Bulge> bulges(num_shifts);
+    for (int k = 0; k < num_shifts; k++) {
+      bulges[k].shift = shifts[k];
+      bulges[k].pos = -spacing * k; // bulge k enters the matrix at step spacing * k
+    }
+
+    int first = 0; // the leading bulge still in flight
+    while (first < num_shifts) {
+      // the bulges in flight at this step
+      int last = first;
+      while (last < num_shifts && bulges[last].pos >= 0) last++;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        // compute the rotations
+#ifdef _OPENMP
+#pragma omp for schedule(static, 1)
+#endif
+        for (int k = first; k < last; k++) {
+          auto &b = bulges[k];
+          int i = b.pos;
+          b.apply = false;
+          if (!b.chase) {
+            if (abs(H[i + 1][i]) < tol) {
+              H[i + 1][i] = 0.0;
+            } else {
+              b.G = Givens(H[i][i] - b.shift, H[i + 1][i]);
+              b.apply = true;
+            }
+          } else {
+            // the bulge at H(i+1, i-1) and the sub-diagonal H(i+1, i)
+            // are the original sub-diagonal element scaled by the
+            // previous rotation, so if both are small this is a split
+            if (sqrt(norm(H[i + 1][i]) + norm(H[i + 1][i - 1])) < tol) {
+              H[i + 1][i] = 0.0;
+              H[i + 1][i - 1] = 0.0;
+              b.chase = false;
+            } else {
+              b.G = Givens(H[i][i - 1], H[i + 1][i - 1]);
+              b.apply = true;
+            }
+          }
+        }
+
+        // apply the rotations to the rows of H
+#ifdef _OPENMP
+#pragma omp for schedule(static, 1)
+#endif
+        for (int k = first; k < last; k++) {
+          auto &b = bulges[k];
+          if (!b.apply) continue;
+          int i = b.pos;
+          double c = b.G.c;
+          Complex s = b.G.s;
+          for (int j = std::max(i - 1, 0); j < n_kr; j++) {
+            Complex t = H[i][j];
+            H[i][j] = c * t + s * H[i + 1][j];
+            H[i + 1][j] = -conj(s) * t + c * H[i + 1][j];
+          }
+          if (b.chase) H[i + 1][i - 1] = 0.0;
+        }
+
+        // apply the rotations to the columns of H and Q
+#ifdef _OPENMP
+#pragma omp for schedule(static, 1)
+#endif
+        for (int k = first; k < last; k++) {
+          auto &b = bulges[k];
+          if (!b.apply) continue;
+          int i = b.pos;
+          double c = b.G.c;
+          Complex s = b.G.s;
+          for (int j = 0; j < std::min(i + 3, n_kr); j++) {
+            Complex t = H[j][i];
+            H[j][i] = c * t + conj(s) * H[j][i + 1];
+            H[j][i + 1] = -s * t + c * H[j][i + 1];
+          }
+          for (int j = 0; j < n_kr; j++) {
+            Complex t = Q[j][i];
+            Q[j][i] = c * t + conj(s) * Q[j][i + 1];
+            Q[j][i + 1] = -s * t + c * Q[j][i + 1];
+          }
+        }
+      }
+
+      // advance the wave; a rotation either starts or continues a chase
+      for (int k = first; k < num_shifts; k++) {
+        auto &b = bulges[k];
+        if (b.pos >= 0 && b.apply) b.chase = true;
+        b.pos++;
+      }
+      while (first < num_shifts && bulges[first].pos >= n_kr - 1) first++;
+    }
+  }
+
+  void triangularEigensolve(Complex *evals, Complex *evecs, const Complex *T_, int n)
+  {
+    Eigen::Map<const MatrixXcd> T(T_, n, n);
+    const double small = std::numeric_limits<double>::epsilon() * T.cwiseAbs().colwise().sum().maxCoeff();
+    MatrixXcd V = MatrixXcd::Zero(n, n);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 8)
+#endif
+    for (int k = 0; k < n; k++) {
+      // solve (T - lambda_k) x = 0 with x_k = 1 and x_j = 0 for j > k
+      const Complex lambda = T(k, k);
+      VectorXcd r = -T.col(k).head(k);
+      V(k, k) = 1.0;
+      for (int j = k - 1; j >= 0; j--) {
+        Complex z = T(j, j) - lambda;
+        if (z == 0.0) z = small;
+        V(j, k) = r(j) / z;
+        r.head(j) -= V(j, k) * T.col(j).head(j);
+      }
+      V.col(k).normalize();
+    }
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int i, int j) { return abs(T(i, i)) < abs(T(j, j)); });
+
+    Eigen::Map<MatrixXcd> X(evecs, n, n);
+    for (int k = 0; k < n; k++) {
+      evals[k] = T(order[k], order[k]);
+      X.col(k) = V.col(order[k]);
+    }
+  }
+
+} // namespace quda
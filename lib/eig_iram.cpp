@@ -13,6 +13,7 @@
 #include <util_quda.h>
 #include <tune_quda.h>
 #include <eigen_helper.h>
+#include <eig_hessenberg.h>
 
 namespace quda
 {
@@ -184,32 +185,9 @@ namespace quda
 
   void IRAM::qrShifts(const std::vector<Complex> evals, const int num_shifts)
   {
-    // This isn't really Eigen, but it's morally equivalent
-    getProfile().TPSTART(QUDA_PROFILE_HOST_COMPUTE);
-
-    // Reset Q to the identity, copy upper Hessenberg
-    MatrixXcd UHcopy = MatrixXcd::Zero(n_kr, n_kr);
-    for (int i = 0; i < n_kr; i++) {
-      for (int j = 0; j < n_kr; j++) {
-        if (i == j)
-          Qmat[i][j] = 1.0;
-        else
-          Qmat[i][j] = 0.0;
-        UHcopy(i, j) = upperHess[i][j];
-      }
-    }
-
-    for (int shift = 0; shift < num_shifts; shift++) {
-
-      // Shift the eigenvalue
-      for (int i = 0; i < n_kr; i++) upperHess[i][i] -= evals[shift];
-
-      qrIteration(Qmat, upperHess);
-
-      for (int i = 0; i < n_kr; i++) upperHess[i][i] += evals[shift];
-    }
-
-    getProfile().TPSTOP(QUDA_PROFILE_HOST_COMPUTE);
+    getProfile().TPSTART(QUDA_PROFILE_EIGENQR);
+    hessenbergQRShifts(upperHess, Qmat, evals, num_shifts, eig_param->qr_tol);
+    getProfile().TPSTOP(QUDA_PROFILE_EIGENQR);
   }
 
   void IRAM::qrIteration(std::vector<std::vector<Complex>> &Q, std::vector<std::vector<Complex>> &R)
@@ -316,21 +294,21 @@ namespace quda
       getProfile().TPSTART(QUDA_PROFILE_EIGENEV);
       // Extract the upper triangular matrix, eigensolve, then
       // get the eigenvectors of the upper Hessenberg
-      MatrixXcd matUpper = MatrixXcd::Zero(n_kr, n_kr);
-      matUpper = schurUH.matrixT().triangularView<Eigen::Upper>();
-      matUpper.conservativeResize(n_kr, n_kr);
-      Eigen::ComplexEigenSolver<MatrixXcd> eigenSolver(matUpper);
-      Q = schurUH.matrixU() * eigenSolver.eigenvectors();
+      MatrixXcd matUpper = schurUH.matrixT().triangularView<Eigen::Upper>();
+      VectorXcd eigenvalues(n_kr);
+      MatrixXcd eigenvectors(n_kr, n_kr);
+      triangularEigensolve(eigenvalues.data(), eigenvectors.data(), matUpper.data(), n_kr);
+      Q.noalias() = schurUH.matrixU() * eigenvectors;
 
       // Update eigenvalues, residuia, and the Q matrix
       for (int i = 0; i < n_kr; i++) {
-        evals[i] = eigenSolver.eigenvalues()[i];
+        evals[i] = eigenvalues[i];
         residua[i] = abs(beta * Q.col(i)[n_kr - 1]);
         for (int j = 0; j < n_kr; j++) Qmat[i][j] = Q(i, j);
       }
       getProfile().TPSTOP(QUDA_PROFILE_EIGENEV);
     } else {
-      getProfile().TPSTART(QUDA_PROFILE_HOST_COMPUTE);
+      getProfile().TPSTART(QUDA_PROFILE_EIGENQR);
       // Copy the upper Hessenberg matrix into Rmat, and set Qmat to the identity
       for (int i = 0; i < n_kr; i++) {
         for (int j = 0; j < n_kr; j++) {
@@ -384,7 +362,7 @@ namespace quda
           iter++;
         }
       }
-      getProfile().TPSTOP(QUDA_PROFILE_HOST_COMPUTE);
+      getProfile().TPSTOP(QUDA_PROFILE_EIGENQR);
 
       getProfile().TPSTART(QUDA_PROFILE_EIGENEV);
       // Compute the eigevectors of the origial upper Hessenberg
@@ -399,15 +377,15 @@ namespace quda
         }
       }
 
-      MatrixXcd matUpper = MatrixXcd::Zero(n_kr, n_kr);
-      matUpper = R.triangularView<Eigen::Upper>();
-      matUpper.conservativeResize(n_kr, n_kr);
-      Eigen::ComplexEigenSolver<MatrixXcd> eigenSolver(matUpper);
-      Q *= eigenSolver.eigenvectors();
+      MatrixXcd matUpper = R.triangularView<Eigen::Upper>();
+      VectorXcd eigenvalues(n_kr);
+      MatrixXcd eigenvectors(n_kr, n_kr);
+      triangularEigensolve(eigenvalues.data(), eigenvectors.data(), matUpper.data(), n_kr);
+      Q = Q * eigenvectors;
 
       // Update eigenvalues, residuia, and the Q matrix
       for (int i = 0; i < n_kr; i++) {
-        evals[i] = eigenSolver.eigenvalues()[i];
+        evals[i] = eigenvalues[i];
         residua[i] = abs(beta * Q.col(i)[n_kr - 1]);
         for (int j = 0; j < n_kr; j++) Qmat[i][j] = Q(i, j);
       }
@@ -0,0 +1,422 @@
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <eigensolve_quda.h>
+#include <invert_quda.h>
+#include <multigrid.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <util_quda.h>
+#include <eigen_helper.h>
+
+namespace quda
+{
+
+  /**
+     @brief Return the leading n vectors of a set
+  */
+  static vector_ref<ColorSpinorField> head(std::vector<ColorSpinorField> &v, int n)
+  {
+    return vector_ref<ColorSpinorField> {v.begin(), v.begin() + n};
+  }
+
+  LOBPCG::LOBPCG(const DiracMatrix &mat, QudaEigParam *eig_param) : EigenSolver(mat, eig_param)
+  {
+    getProfile().TPSTART(QUDA_PROFILE_INIT);
+
+    if (!(eig_param->spectrum == QUDA_SPECTRUM_LR_EIG || eig_param->spectrum == QUDA_SPECTRUM_SR_EIG)) {
+      errorQuda("Only real spectrum type (LR or SR) can be passed to the LOBPCG solver");
+    }
+
+    getProfile().TPSTOP(QUDA_PROFILE_INIT);
+  }
+
+  LOBPCG::~LOBPCG() = default;
+
+  void LOBPCG::operator()(std::vector<ColorSpinorField> &kSpace, std::vector<Complex> &evals)
+  {
+    // The Ritz vectors are iterated as a single block of n_ev vectors
+    block_size = n_ev;
+    const int nb = n_ev;
+
+    // Pre-launch checks and preparation
+    //---------------------------------------------------------------------------
+    queryPrec(kSpace[0].Precision());
+    // Check to see if we are loading eigenvectors
+    if (strcmp(eig_param->vec_infile, "") != 0) {
+      logQuda(QUDA_VERBOSE, "Loading evecs from file name %s\n", eig_param->vec_infile);
+      loadFromFile(kSpace, evals);
+      return;
+    }
+
+    // Room for the block, the temporaries used by the Chebyshev
+    // estimate and the singular vectors, trimmed before exit
+    auto size = std::max(nb + 3, compute_svd ? 2 * n_conv : 0);
+    if (static_cast<int>(kSpace.size()) < size) resize(kSpace, size, QUDA_ZERO_FIELD_CREATE);
+    evals.resize(nb, 0.0);
+
+    // Any vectors passed in are kept as the initial guess, the rest
+    // are populated with rands, then all are orthonormalised
+    prepareInitialGuess(kSpace);
+
+    // Check for Chebyshev maximum estimation
+    checkChebyOpMax(kSpace);
+
+    // Workspace: the residuals are kept in r, and T is a temporary
+    std::vector<ColorSpinorField> AX, W, AW, P, AP, T;
+    resize(r, nb, QUDA_ZERO_FIELD_CREATE, kSpace[0]);
+    for (auto v : {&AX, &W, &AW, &P, &AP, &T}) resize(*v, nb, QUDA_ZERO_FIELD_CREATE, kSpace[0]);
+
+    createPreconditioner(kSpace[0]);
+
+    // Convergence criteria
+    double mat_norm = 0.0;
+    bool largest = spectrum[0] == 'L';
+
+    // Print Eigensolver params
+    printEigensolverSetup();
+    //---------------------------------------------------------------------------
+
+    // Begin LOBPCG Eigensolver computation
+    //---------------------------------------------------------------------------
+    getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+
+    auto X = head(kSpace, nb);
+    std::vector<double> theta(nb);
+
+    // Solve the Rayleigh-Ritz problem for the projected operator G,
+    // returning the rotation to the wanted nb Ritz vectors ordered
+    // from the most wanted
+    auto rayleighRitz = [&](const MatrixXcd &G) -> MatrixXcd {
+      Eigen::SelfAdjointEigenSolver<MatrixXcd> eig(0.5 * (G + G.adjoint()));
+      MatrixXcd C(G.rows(), nb);
+      for (int i = 0; i < nb; i++) {
+        int k = largest ? G.rows() - 1 - i : i;
+        theta[i] = eig.eigenvalues()[k];
+        C.col(i) = eig.eigenvectors().col(k);
+      }
+      return C;
+    };
+
+    // Initial Ritz vectors from the span of the initial guess
+    chebyOp(AX, X);
+    iter += nb;
+    {
+      MatrixXcd C = rayleighRitz(gram(X, AX));
+      rotate(W, X, C, false);
+      rotate(AW, AX, C, false);
+      for (int i = 0; i < nb; i++) {
+        std::swap(kSpace[i], W[i]);
+        std::swap(AX[i], AW[i]);
+      }
+    }
+
+    vector_ref<ColorSpinorField> none;
+    int np = 0; // the number of search directions
+    std::vector<int> active;
+    active.reserve(nb);
+
+    while (restart_iter < max_restarts && !converged) {
+
+      // r = AX - X * theta
+      blas::copy(r, AX);
+      std::vector<Complex> minus_theta(nb);
+      for (int i = 0; i < nb; i++) {
+        minus_theta[i] = -theta[i];
+        mat_norm = std::max(mat_norm, std::abs(theta[i]));
+      }
+      auto r2 = blas::caxpyNorm(minus_theta, X, r);
+
+      // Convergence check: the leading converged vectors count towards
+      // n_conv, and every converged vector is dropped from the active set
+      auto check_norm = [&](double sr_norm) -> double {
+        return eig_param->spectrum == QUDA_SPECTRUM_LR_EIG ? mat_norm : sr_norm;
+      };
+
+      num_converged = 0;
+      active.clear();
+      for (int i = 0; i < nb; i++) {
+        residua[i] = sqrt(r2[i]);
+        if (residua[i] < tol * check_norm(std::abs(theta[i]))) {
+          if (static_cast<int>(active.size()) == 0) num_converged++;
+        } else {
+          active.push_back(i);
+        }
+        logQuda(QUDA_DEBUG_VERBOSE, "Ritz[%d] = %.16e residual[%d] = %.16e\n", i, theta[i], i, residua[i]);
+      }
+
+      logQuda(QUDA_VERBOSE, "%04d converged eigenvalues at iter %04d\n", num_converged, restart_iter + 1);
+
+      if (num_converged >= n_conv) {
+        converged = true;
+        break;
+      }
+
+      // W = K * r for the active vectors, then make W orthonormal and
+      // orthogonal to X.  Projecting twice is enough.
+      int nw = active.size();
+      vector_ref<const ColorSpinorField> r_active;
+      for (auto i : active) r_active.push_back(r[i]);
+      precondition(head(W, nw), r_active);
+
+      for (int k = 0; k < 2 && nw > 0; k++) {
+        project(head(W, nw), none, X, AX);
+        nw = svqb(head(W, nw), none, head(T, nw), none);
+      }
+
+      if (nw == 0 && np == 0) {
+        warningQuda("LOBPCG search space has collapsed at iteration %d", restart_iter + 1);
+        break;
+      }
+
+      // AW = A * W as a single batched application
+      if (nw > 0) chebyOp(head(AW, nw), head(W, nw));
+      iter += nw;
+
+      // Make P orthonormal and orthogonal to both X and W
+      for (int k = 0; k < 2 && np > 0; k++) {
+        project(head(P, np), head(AP, np), X, AX);
+        project(head(P, np), head(AP, np), head(W, nw), head(AW, nw));
+        np = svqb(head(P, np), head(AP, np), head(T, np), head(r, np));
+      }
+
+      // Rayleigh-Ritz on the orthonormal basis S = [X, W, P]
+      vector_ref<ColorSpinorField> S = X;
+      vector_ref<ColorSpinorField> AS = head(AX, nb);
+      S.insert(S.end(), W.begin(), W.begin() + nw);
+      S.insert(S.end(), P.begin(), P.begin() + np);
+      AS.insert(AS.end(), AW.begin(), AW.begin() + nw);
+      AS.insert(AS.end(), AP.begin(), AP.begin() + np);
+
+      getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+      getProfile().TPSTART(QUDA_PROFILE_EIGENEV);
+      MatrixXcd C = rayleighRitz(gram(S, AS));
+      getProfile().TPSTOP(QUDA_PROFILE_EIGENEV);
+      getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+
+      MatrixXcd Cx = C.topRows(nb);
+      MatrixXcd Cw = C.middleRows(nb, nw);
+      MatrixXcd Cp = C.bottomRows(np);
+
+      // New search directions P = W * Cw + P * Cp, held in T and r;
+      // W may have collapsed, but then P has not
+      if (nw > 0) {
+        rotate(T, head(W, nw), Cw, false);
+        rotate(r, head(AW, nw), Cw, false);
+      } else {
+        blas::zero(T);
+        blas::zero(r);
+      }
+      if (np > 0) {
+        rotate(T, head(P, np), Cp, true);
+        rotate(r, head(AP, np), Cp, true);
+      }
+
+      // New Ritz vectors X = X * Cx + P, held in W
+      blas::copy(W, T);
+      blas::copy(AW, r);
+      rotate(W, X, Cx, true);
+      rotate(AW, head(AX, nb), Cx, true);
+
+      for (int i = 0; i < nb; i++) {
+        std::swap(kSpace[i], W[i]);
+        std::swap(AX[i], AW[i]);
+        std::swap(P[i], T[i]);
+        std::swap(AP[i], r[i]);
+      }
+      np = nb;
+
+      restart_iter++;
+    }
+
+    getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    // Post computation report
+    //---------------------------------------------------------------------------
+    if (!converged) {
+      if (eig_param->require_convergence) {
+        errorQuda("LOBPCG failed to compute the requested %d vectors with a %d search space in %d iterations. Exiting.",
+                  n_conv, n_ev, max_restarts);
+      } else {
+        warningQuda("LOBPCG failed to compute the requested %d vectors with a %d search space in %d iterations. "
+                    "Continuing with current Ritz vectors.",
+                    n_conv, n_ev, max_restarts);
+      }
+    } else {
+      logQuda(QUDA_SUMMARIZE, "LOBPCG computed the requested %d vectors in %d iterations and %d OP*x operations.\n",
+              n_conv, restart_iter, iter);
+
+      // Dump all Ritz values and residua
+      for (int i = 0; i < n_conv; i++) {
+        logQuda(QUDA_SUMMARIZE, "RitzValue[%04d]: (%+.16e, %+.16e) residual %.16e\n", i, theta[i], 0.0, residua[i]);
+      }
+
+      // Compute eigenvalues/singular values
+      computeEvals(kSpace, evals);
+      if (compute_svd) computeSVD(kSpace, evals);
+    }
+
+    K_in.clear();
+    K_out.clear();
+
+    // Local clean-up
+    cleanUpEigensolver(kSpace, evals);
+  }
+
+  void LOBPCG::createPreconditioner(const ColorSpinorField &meta)
+  {
+    QudaInvertParam *inv_param = eig_param->invert_param;
+    QudaInverterType type = inv_param->inv_type_precondition;
+    if (type == QUDA_INVALID_INVERTER || K) return;
+
+    // The preconditioner approximates the inverse of the operator,
+    // which only accelerates convergence to the low modes
+    if (eig_param->use_poly_acc || eig_param->spectrum != QUDA_SPECTRUM_SR_EIG) {
+      warningQuda("LOBPCG preconditioning is only applied for the SR spectrum without polynomial acceleration");
+      return;
+    }
+
+    if (type == QUDA_MG_INVERTER) {
+      if (!inv_param->preconditioner) errorQuda("Multigrid preconditioning requested but no multigrid instance is set");
+      if (meta.SiteSubset() != QUDA_FULL_SITE_SUBSET || meta.Nspin() != 4)
+        errorQuda("Multigrid preconditioning of LOBPCG requires a full-parity Wilson-type operator");
+
+      // the multigrid instance is not owned by the eigensolver
+      K = std::shared_ptr<Solver>(static_cast<multigrid_solver *>(inv_param->preconditioner)->mg, [](Solver *) {});
+      K_mg = true;
+
+      ColorSpinorParam param(meta);
+      param.create = QUDA_NULL_FIELD_CREATE;
+      param.setPrecision(inv_param->cuda_prec_precondition, inv_param->cuda_prec_precondition, true);
+      resize(K_in, n_ev, param);
+      resize(K_out, n_ev, param);
+      logQuda(QUDA_VERBOSE, "LOBPCG preconditioned with multigrid\n");
+    } else {
+      K_param = std::make_unique<SolverParam>(*inv_param);
+      K_param->inv_type = type;
+      K_param->inv_type_precondition = QUDA_INVALID_INVERTER;
+      K_param->preconditioner = nullptr;
+      K_param->deflate = false;
+      K_param->tol = inv_param->tol_precondition;
+      K_param->maxiter = inv_param->maxiter_precondition;
+      K_param->delta = 1e-20; // no reliable updates within the inner solver
+      K_param->residual_type = QUDA_L2_RELATIVE_RESIDUAL;
+      K_param->use_init_guess = QUDA_USE_INIT_GUESS_NO;
+      K_param->is_preconditioner = true;
+      K_param->compute_true_res = false;
+      K_param->sloppy_converge = true;
+      K_param->precision = meta.Precision();
+      K_param->precision_sloppy = meta.Precision();
+      K_param->precision_precondition = meta.Precision();
+      if (type == QUDA_CA_GCR_INVERTER || type == QUDA_CA_CG_INVERTER) {
+        K_param->Nkrylov = K_param->maxiter / std::max(K_param->precondition_cycle, 1);
+        K_param->ca_basis = K_param->ca_basis_precondition;
+        K_param->ca_lambda_min = K_param->ca_lambda_min_precondition;
+        K_param->ca_lambda_max = K_param->ca_lambda_max_precondition;
+      } else {
+        K_param->Nsteps = K_param->precondition_cycle;
+      }
+
+      K = std::shared_ptr<Solver>(Solver::create(*K_param, mat, mat, mat, mat));
+      logQuda(QUDA_VERBOSE, "LOBPCG preconditioned with inner solver %d\n", type);
+    }
+  }
+
+  void LOBPCG::precondition(cvector_ref<ColorSpinorField> &w, cvector_ref<const ColorSpinorField> &r)
+  {
+    if (!K) {
+      blas::copy(w, r);
+      return;
+    }
+
+    pushVerbosity(eig_param->invert_param->verbosity_precondition);
+    if (!K_mg) {
+      (*K)(w, r);
+    } else {
+      // Multigrid approximates M^{-1}, and the inverse of the
+      // operator is formed using the gamma5-Hermiticity of M
+      auto in = head(K_in, r.size());
+      auto out = head(K_out, r.size());
+      blas::copy(in, r);
+      if (eig_param->use_norm_op && !eig_param->use_dagger) {
+        // (M^dag M)^{-1} = M^{-1} gamma5 M^{-1} gamma5
+        gamma5(in, in);
+        (*K)(out, in);
+        gamma5(in, out);
+        (*K)(out, in);
+      } else if (eig_param->use_norm_op && eig_param->use_dagger) {
+        // (M M^dag)^{-1} = gamma5 M^{-1} gamma5 M^{-1}
+        (*K)(out, in);
+        gamma5(in, out);
+        (*K)(out, in);
+        gamma5(out, out);
+      } else if (eig_param->use_dagger) {
+        // M^{-dag} = gamma5 M^{-1} gamma5
+        gamma5(in, in);
+        (*K)(out, in);
+        gamma5(out, out);
+      } else if (eig_param->compute_gamma5) {
+        // (gamma5 M)^{-1} = M^{-1} gamma5
+        gamma5(in, in);
+        (*K)(out, in);
+      } else {
+        (*K)(out, in);
+      }
+      blas::copy(w, out);
+    }
+    popVerbosity();
+  }
+
+  void LOBPCG::project(cvector_ref<ColorSpinorField> &v, cvector_ref<ColorSpinorField> &av,
+                       cvector_ref<const ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &ax)
+  {
+    if (v.size() == 0 || x.size() == 0) return;
+
+    // v = v - x * (x^dag v), av = av - ax * (x^dag v)
+    std::vector<Complex> s(x.size() * v.size());
+    blas::block::cDotProduct(s, x, v);
+    for (auto &si : s) si = -si;
+    blas::block::caxpy(s, x, v);
+    if (av.size() > 0) blas::block::caxpy(s, ax, av);
+  }
+
+  int LOBPCG::svqb(cvector_ref<ColorSpinorField> &v, cvector_ref<ColorSpinorField> &av,
+                   cvector_ref<ColorSpinorField> &tmp, cvector_ref<ColorSpinorField> &atmp)
+  {
+    const int m = v.size();
+    if (m == 0) return 0;
+
+    // Scale the Gram matrix to unit diagonal and eigensolve it
+    MatrixXcd G = gram(v, v);
+    VectorXd d(m);
+    for (int i = 0; i < m; i++) d(i) = G(i, i).real() > 0.0 ? 1.0 / sqrt(G(i, i).real()) : 0.0;
+    G = d.asDiagonal() * (0.5 * (G + G.adjoint())) * d.asDiagonal();
+    Eigen::SelfAdjointEigenSolver<MatrixXcd> eig(G);
+
+    // Drop the directions that are numerically linearly dependent
+    const auto &lambda = eig.eigenvalues();
+    const double cutoff = 10.0 * setEpsilon(v[0].Precision()) * lambda[m - 1];
+    int k = 0;
+    while (k < m && lambda[m - 1 - k] > cutoff) k++;
+    if (k < m) logQuda(QUDA_DEBUG_VERBOSE, "SVQB dropped %d of %d directions\n", m - k, m);
+    if (k == 0) return 0;
+
+    // v = v * D * U * Lambda^{-1/2}, keeping the k largest directions
+    MatrixXcd C = d.asDiagonal() * eig.eigenvectors().rightCols(k);
+    for (int j = 0; j < k; j++) C.col(j) /= sqrt(lambda[m - k + j]);
+
+    auto tmp_k = vector_ref<ColorSpinorField> {tmp.begin(), tmp.begin() + k};
+    rotate(tmp_k, v, C, false);
+    for (int i = 0; i < k; i++) std::swap(v[i], tmp[i]);
+
+    if (av.size() > 0) {
+      auto atmp_k = vector_ref<ColorSpinorField> {atmp.begin(), atmp.begin() + k};
+      rotate(atmp_k, av, C, false);
+      for (int i = 0; i < k; i++) std::swap(av[i], atmp[i]);
+    }
+
+    return k;
+  }
+
+} // namespace quda
@@ -13,6 +13,7 @@
 #include <util_quda.h>
 #include <tune_quda.h>
 #include <eigen_helper.h>
+#include <eig_arrow.h>
 
 namespace quda
 {
@@ -252,13 +253,12 @@ namespace quda
 
   void TRLM::eigensolveFromArrowMat()
   {
-    getProfile().TPSTART(QUDA_PROFILE_EIGEN);
+    getProfile().TPSTART(QUDA_PROFILE_EIGENEV);
     int dim = n_kr - num_locked;
     int arrow_pos = num_keep - num_locked;
 
-    // Eigen objects
-    MatrixXd A = MatrixXd::Zero(dim, dim);
     ritz_mat.resize(dim * dim, 0.0);
+    std::vector<double> evals(dim);
 
     // Invert the spectrum due to chebyshev
     if (reverse) {
@@ -269,39 +269,30 @@ namespace quda
       alpha[n_kr - 1] *= -1.0;
     }
 
-    // Construct arrow mat A_{dim,dim}
-    for (int i = 0; i < dim; i++) {
-
-      // alpha populates the diagonal
-      A(i, i) = alpha[i + num_locked];
-    }
-
-    for (int i = 0; i < arrow_pos; i++) {
-
-      // beta populates the arrow
-      A(i, arrow_pos) = beta[i + num_locked];
-      A(arrow_pos, i) = beta[i + num_locked];
-    }
-
-    for (int i = arrow_pos; i < dim - 1; i++) {
-
-      // beta populates the sub-diagonal
-      A(i, i + 1) = beta[i + num_locked];
-      A(i + 1, i) = beta[i + num_locked];
+    if (eig_param->use_arrow_solver) {
+      // Structured divide-and-conquer eigensolve of the arrow matrix
+      arrowEigensolve(evals.data(), ritz_mat.data(), alpha.data() + num_locked, beta.data() + num_locked, dim, arrow_pos);
+
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
+        // verify against the dense solver
+        std::vector<double> evals_ref(dim);
+        std::vector<double> evecs_ref(dim * dim);
+        arrowEigensolveDense(evals_ref.data(), evecs_ref.data(), alpha.data() + num_locked, beta.data() + num_locked,
+                             dim, arrow_pos);
+        double max_dev = 0.0;
+        for (int i = 0; i < dim; i++) max_dev = std::max(max_dev, fabs(evals[i] - evals_ref[i]));
+        logQuda(QUDA_DEBUG_VERBOSE, "Arrow eigensolve dim = %d arrow = %d max eigenvalue deviation from dense = %e\n",
+                dim, arrow_pos, max_dev);
+      }
+    } else {
+      arrowEigensolveDense(evals.data(), ritz_mat.data(), alpha.data() + num_locked, beta.data() + num_locked, dim,
+                           arrow_pos);
     }
 
-    // Eigensolve the arrow matrix
-    SelfAdjointEigenSolver<MatrixXd> eigensolver;
-    eigensolver.compute(A);
-
-    // repopulate ritz matrix
-    for (int i = 0; i < dim; i++)
-      for (int j = 0; j < dim; j++) ritz_mat[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
-
     for (int i = 0; i < dim; i++) {
-      residua[i + num_locked] = fabs(beta[n_kr - 1] * eigensolver.eigenvectors().col(i)[dim - 1]);
+      residua[i + num_locked] = fabs(beta[n_kr - 1] * ritz_mat[dim * i + dim - 1]);
       // Update the alpha array
-      alpha[i + num_locked] = eigensolver.eigenvalues()[i];
+      alpha[i + num_locked] = evals[i];
     }
 
     // Put spectrum back in order
@@ -309,7 +300,7 @@ namespace quda
       for (int i = num_locked; i < n_kr; i++) { alpha[i] *= -1.0; }
     }
 
-    getProfile().TPSTOP(QUDA_PROFILE_EIGEN);
+    getProfile().TPSTOP(QUDA_PROFILE_EIGENEV);
   }
 
   void TRLM::computeKeptRitz(std::vector<ColorSpinorField> &kSpace)
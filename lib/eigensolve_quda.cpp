@@ -5,6 +5,7 @@
 #include <vector>
 #include <algorithm>
 #include <cfloat>
+#include <limits>
 
 #include <quda_internal.h>
 #include <eigensolve_quda.h>
@@ -14,8 +15,11 @@
 #include <blas_quda.h>
 #include <util_quda.h>
 #include <tune_quda.h>
+#include <device.h>
 #include <vector_io.h>
 #include <eigen_helper.h>
+#include <blas_lapack.h>
+#include <malloc_quda.h>
 
 namespace quda
 {
@@ -112,6 +116,10 @@ namespace quda
       logQuda(QUDA_VERBOSE, "Creating Block TR Lanczos eigensolver\n");
       eig_solver = new BLKTRLM(mat, eig_param);
       break;
+    case QUDA_EIG_LOBPCG:
+      logQuda(QUDA_VERBOSE, "Creating LOBPCG eigensolver\n");
+      eig_solver = new LOBPCG(mat, eig_param);
+      break;
     default: errorQuda("Invalid eig solver type");
     }
 
@@ -258,6 +266,106 @@ namespace quda
     logQuda(QUDA_SUMMARIZE, "********************************\n");
   }
 
+  /**
+     @brief Policy tuner for the number of vectors passed to each
+     application of the Chebyshev polynomial.  Larger blocks amortize
+     the gauge field reads of the multi-RHS operator over more
+     vectors, but need larger temporaries and can exceed the
+     operator's multi-RHS limit, so the optimum is found by tuning.
+     The block size is stored in aux.x.
+   */
+  template <typename Apply> class ChebyBlockTune : public Tunable
+  {
+    Apply &apply_block;
+    cvector_ref<ColorSpinorField> &out;
+    cvector_ref<const ColorSpinorField> &in;
+    const int max_block;
+
+    void apply_blocked(int block)
+    {
+      for (auto i = 0u; i < in.size(); i += block) {
+        auto n = std::min(static_cast<size_t>(block), in.size() - i);
+        apply_block({out.begin() + i, out.begin() + i + n}, {in.begin() + i, in.begin() + i + n});
+      }
+    }
+
+  public:
+    ChebyBlockTune(Apply &apply_block, cvector_ref<ColorSpinorField> &out, cvector_ref<const ColorSpinorField> &in,
+                   int poly_deg) :
+      apply_block(apply_block), out(out), in(in), max_block(in.size())
+    {
+      strcpy(aux, "policy,");
+      strcat(aux, in.AuxString().c_str());
+      strcat(aux, ",n=");
+      char size[16];
+      u64toa(size, in.size());
+      strcat(aux, size);
+      strcat(aux, ",deg=");
+      i32toa(size, poly_deg);
+      strcat(aux, size);
+      strcat(aux, ",max_multi_rhs=");
+      u32toa(size, get_max_multi_rhs());
+      strcat(aux, size);
+
+      // ensure the constituent kernels are tuned for every block size
+      // before tuning the policy, since we cannot do nested tuning
+      if (!tuned()) {
+        disableProfileCount();
+        for (int block = 1; block <= max_block; block *= 2) apply_blocked(block);
+        if (max_block & (max_block - 1)) apply_blocked(max_block);
+        enableProfileCount();
+        setPolicyTuning(true);
+      }
+
+      apply(device::get_default_stream());
+    }
+
+    virtual ~ChebyBlockTune() { setPolicyTuning(false); }
+
+    void apply(const qudaStream_t &) override
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      apply_blocked(tp.aux.x);
+    }
+
+    // aux.x is the block size: powers of two up to the maximum, then the maximum
+    bool advanceAux(TuneParam &param) const override
+    {
+      if (2 * param.aux.x <= max_block) {
+        param.aux.x *= 2;
+        return true;
+      } else if (param.aux.x != max_block) {
+        param.aux.x = max_block;
+        return true;
+      } else {
+        param.aux.x = 1;
+        return false;
+      }
+    }
+
+    bool advanceTuneParam(TuneParam &param) const override { return advanceAux(param); }
+
+    void initTuneParam(TuneParam &param) const override
+    {
+      Tunable::initTuneParam(param);
+      param.aux = make_int4(1, 0, 0, 0);
+    }
+
+    void defaultTuneParam(TuneParam &param) const override
+    {
+      Tunable::defaultTuneParam(param);
+      param.aux = make_int4(max_block, 0, 0, 0);
+    }
+
+    TuneKey tuneKey() const override { return TuneKey(in.VolString().c_str(), typeid(*this).name(), aux); }
+
+    long long bytes() const override { return 0; }
+
+    // the input is not overwritten, so no backup is needed
+    void preTune() override { }
+    void postTune() override { }
+  };
+
   void EigenSolver::chebyOp(cvector_ref<ColorSpinorField> &out,
                             cvector_ref<const ColorSpinorField> &in)
   {
@@ -269,6 +377,18 @@ namespace quda
 
     if (eig_param->poly_deg == 0) errorQuda("Polynomial acceleration requested with zero polynomial degree");
 
+    if (in.size() == 1) {
+      chebyOpBlock(out, in);
+    } else {
+      auto apply_block = [&](cvector_ref<ColorSpinorField> &out, cvector_ref<const ColorSpinorField> &in) {
+        chebyOpBlock(out, in);
+      };
+      ChebyBlockTune<decltype(apply_block)> cheby(apply_block, out, in, eig_param->poly_deg);
+    }
+  }
+
+  void EigenSolver::chebyOpBlock(cvector_ref<ColorSpinorField> &out, cvector_ref<const ColorSpinorField> &in)
+  {
     // Compute the polynomial accelerated operator.
     double a = eig_param->a_min;
     double b = eig_param->a_max;
@@ -395,6 +515,26 @@ namespace quda
     }
   }
 
+  MatrixXcd EigenSolver::gram(cvector_ref<const ColorSpinorField> &a, cvector_ref<const ColorSpinorField> &b)
+  {
+    std::vector<Complex> s(a.size() * b.size());
+    blas::block::cDotProduct(s, a, b);
+    MatrixXcd G(a.size(), b.size());
+    for (auto i = 0u; i < a.size(); i++)
+      for (auto j = 0u; j < b.size(); j++) G(i, j) = s[i * b.size() + j];
+    return G;
+  }
+
+  void EigenSolver::rotate(cvector_ref<ColorSpinorField> &y, cvector_ref<const ColorSpinorField> &x, const MatrixXcd &C,
+                           bool accumulate)
+  {
+    std::vector<Complex> s(x.size() * y.size());
+    for (auto i = 0u; i < x.size(); i++)
+      for (auto j = 0u; j < y.size(); j++) s[i * y.size() + j] = C(i, j);
+    if (!accumulate) blas::zero(y);
+    blas::block::caxpy(s, x, y);
+  }
+
   // Orthogonalise r[0:] against V_[0:j]
   void EigenSolver::blockOrthogonalizeHMGS(std::vector<ColorSpinorField> &vecs, std::vector<ColorSpinorField> &rvecs, int h_block_size, int i)
   {
@@ -562,6 +702,12 @@ namespace quda
 
     logQuda(QUDA_VERBOSE, "Deflating %d left and right singular vectors\n", n_defl);
 
+    if (evecs[0].Location() == QUDA_CPU_FIELD_LOCATION) {
+      deflateOutOfCore(sol, src, {evecs.begin() + eig_param->n_conv, evecs.begin() + eig_param->n_conv + n_defl},
+                       {evecs.begin(), evecs.begin() + n_defl}, evals, accumulate);
+      return;
+    }
+
     // Perform Sum_i R_i * (\sigma_i)^{-1} * L_i^dag * vec = vec_defl
     // for all i computed eigenvectors and values.
 
@@ -627,6 +773,110 @@ namespace quda
     }
   }
 
+  bool EigenSolver::refine(std::vector<ColorSpinorField> &evecs, std::vector<Complex> &evals)
+  {
+    if (!mat.hermitian()) errorQuda("Eigenspace refinement requires a Hermitian operator");
+    if (static_cast<int>(evecs.size()) < n_conv)
+      errorQuda("Requesting refinement of %d eigenvectors with only %lu passed", n_conv, evecs.size());
+
+    const int n = n_conv;
+    vector_ref<ColorSpinorField> V {evecs.begin(), evecs.begin() + n};
+
+    // Nothing to refine if the space is not populated
+    auto norm = blas::norm2(V);
+    for (auto ni : norm)
+      if (!std::isfinite(ni) || ni == 0.0) return false;
+
+    getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+
+    std::vector<ColorSpinorField> AV, W, AW, T;
+    for (auto v : {&AV, &W, &AW, &T}) resize(*v, n, QUDA_NULL_FIELD_CREATE, evecs[0]);
+
+    mat(AV, V);
+    int n_w = 0;
+    bool refined = false;
+    const bool largest = eig_param->spectrum == QUDA_SPECTRUM_LR_EIG;
+    std::vector<double> theta(n);
+    std::vector<Complex> minus_theta(n);
+
+    for (int sweep = 0; sweep <= eig_param->deflation_refine_sweeps; sweep++) {
+      // Rayleigh-Ritz on S = [V, W], which need not be orthonormal
+      vector_ref<ColorSpinorField> S = V;
+      vector_ref<ColorSpinorField> AS {AV.begin(), AV.end()};
+      S.insert(S.end(), W.begin(), W.begin() + n_w);
+      AS.insert(AS.end(), AW.begin(), AW.begin() + n_w);
+
+      MatrixXcd G = gram(S, AS);
+      MatrixXcd B = gram(S, S);
+      GeneralizedSelfAdjointEigenSolver<MatrixXcd> eig(0.5 * (G + G.adjoint()), 0.5 * (B + B.adjoint()));
+      if (eig.info() != Success) {
+        logQuda(QUDA_VERBOSE, "Refinement basis is numerically rank deficient at sweep %d\n", sweep);
+        break;
+      }
+
+      MatrixXcd C(n + n_w, n);
+      for (int i = 0; i < n; i++) {
+        int k = largest ? n + n_w - 1 - i : i;
+        theta[i] = eig.eigenvalues()[k];
+        minus_theta[i] = -theta[i];
+        C.col(i) = eig.eigenvectors().col(k);
+      }
+
+      // V = S * C, AV = AS * C
+      rotate(T, S, C, false);
+      for (int i = 0; i < n; i++) std::swap(V[i], T[i]);
+      rotate(T, AS, C, false);
+      for (int i = 0; i < n; i++) std::swap(AV[i], T[i]);
+
+      // Residuals W = AV - V * theta, compacted to those that are unconverged
+      blas::copy(W, AV);
+      auto r2 = blas::caxpyNorm(minus_theta, V, W);
+      double mat_norm = 0.0;
+      for (auto t : theta) mat_norm = std::max(mat_norm, std::abs(t));
+
+      n_w = 0;
+      for (int i = 0; i < n; i++) {
+        residua[i] = sqrt(r2[i]);
+        if (residua[i] >= tol * (largest ? mat_norm : std::abs(theta[i]))) {
+          if (i != n_w) std::swap(W[n_w], W[i]);
+          n_w++;
+        }
+      }
+      logQuda(QUDA_VERBOSE, "Refinement sweep %d: %d of %d eigenpairs converged\n", sweep, n - n_w, n);
+
+      if (n_w == 0) {
+        refined = true;
+        break;
+      }
+      if (sweep == eig_param->deflation_refine_sweeps) break;
+
+      // Make the residuals orthogonal to V and normalize them
+      vector_ref<ColorSpinorField> W_ {W.begin(), W.begin() + n_w};
+      for (int k = 0; k < 2; k++) {
+        std::vector<Complex> s(n * n_w);
+        blas::block::cDotProduct(s, V, W_);
+        for (auto &si : s) si = -si;
+        blas::block::caxpy(s, V, W_);
+      }
+      auto w2 = blas::norm2(W_);
+      for (auto &wi : w2) wi = 1.0 / sqrt(wi);
+      blas::ax(w2, W_);
+
+      mat({AW.begin(), AW.begin() + n_w}, W_);
+    }
+
+    getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    if (static_cast<int>(evals.size()) < n) evals.resize(n);
+    for (int i = 0; i < n; i++) {
+      evals[i] = theta[i];
+      logQuda(QUDA_VERBOSE, "Eval[%04d] = (%+.16e,%+.16e) Residual = %+.16e\n", i, theta[i], 0.0, residua[i]);
+    }
+
+    logQuda(QUDA_SUMMARIZE, "Refinement of %d eigenpairs %s\n", n, refined ? "converged" : "did not converge");
+    return refined;
+  }
+
   // Deflate vec, place result in vec_defl
   void EigenSolver::deflate(cvector_ref<ColorSpinorField> &sol, cvector_ref<const ColorSpinorField> &src,
                             cvector_ref<const ColorSpinorField> &evecs, const std::vector<Complex> &evals,
@@ -641,6 +891,12 @@ namespace quda
     int n_defl = n_ev_deflate;
     logQuda(QUDA_VERBOSE, "Deflating %d vectors\n", n_defl);
 
+    if (evecs[0].Location() == QUDA_CPU_FIELD_LOCATION) {
+      deflateOutOfCore(sol, src, {evecs.begin(), evecs.begin() + n_defl}, {evecs.begin(), evecs.begin() + n_defl},
+                       evals, accumulate);
+      return;
+    }
+
     // Perform Sum_i V_i * (L_i)^{-1} * (V_i)^dag * vec = vec_defl
     // for all i computed eigenvectors and values.
 
@@ -657,6 +913,94 @@ namespace quda
     blas::block::caxpy(s, {evecs.begin(), evecs.begin() + n_defl}, {sol.begin(), sol.end()});
   }
 
+  void EigenSolver::deflateOutOfCore(cvector_ref<ColorSpinorField> &sol, cvector_ref<const ColorSpinorField> &src,
+                                     cvector_ref<const ColorSpinorField> &left,
+                                     cvector_ref<const ColorSpinorField> &right, const std::vector<Complex> &evals,
+                                     bool accumulate) const
+  {
+    const int n_defl = left.size();
+    const bool svd = &left[0] != &right[0];
+    const int tile = std::min(eig_param->deflation_tile_size, n_defl);
+    if (tile <= 0) errorQuda("Invalid deflation tile size %d", eig_param->deflation_tile_size);
+    const int n_tile = (n_defl + tile - 1) / tile;
+    logQuda(QUDA_VERBOSE, "Streaming %d %s vectors from host in %d tiles of %d\n", n_defl,
+            svd ? "singular" : "eigen", n_tile, tile);
+
+    // double-buffered device staging area for the current and next tile, which keeps the host
+    // field order so that the transfers are raw copies
+    ColorSpinorParam param(left[0]);
+    param.location = QUDA_CUDA_FIELD_LOCATION;
+    param.mem_type = QUDA_MEMORY_DEVICE;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    std::vector<ColorSpinorField> left_h[2], right_h[2];
+    for (int b = 0; b < std::min(2, n_tile); b++) {
+      resize(left_h[b], tile, param);
+      if (svd) resize(right_h[b], tile, param);
+    }
+
+    // the tile being applied, reordered into the native field order on the compute stream
+    param.setPrecision(left[0].Precision(), QUDA_INVALID_PRECISION, true);
+    std::vector<ColorSpinorField> left_d, right_d;
+    resize(left_d, tile, param);
+    if (svd) resize(right_d, tile, param);
+
+    // transfers are issued on a separate stream and synchronized with events
+    const auto copy_stream = device::get_stream(0);
+    const auto compute_stream = device::get_default_stream();
+    qudaEvent_t copied[2] = {qudaEventCreate(), qudaEventCreate()};
+    qudaEvent_t computed[2] = {qudaEventCreate(), qudaEventCreate()};
+
+    auto prefetch = [&](int t) {
+      const int b = t % 2;
+      // do not overwrite the buffer until the work on the tile that last used it is complete
+      qudaStreamWaitEvent(copy_stream, computed[b], 0);
+      for (int i = 0; i < std::min(tile, n_defl - t * tile); i++) {
+        auto &l = left[t * tile + i];
+        qudaMemcpyAsync(left_h[b][i].data(), l.data(), l.Bytes(), qudaMemcpyHostToDevice, copy_stream);
+        if (svd) {
+          auto &r = right[t * tile + i];
+          qudaMemcpyAsync(right_h[b][i].data(), r.data(), r.Bytes(), qudaMemcpyHostToDevice, copy_stream);
+        }
+      }
+      qudaEventRecord(copied[b], copy_stream);
+    };
+
+    if (!accumulate) blas::zero(sol);
+
+    prefetch(0);
+    for (int t = 0; t < n_tile; t++) {
+      const int b = t % 2;
+      const int n = std::min(tile, n_defl - t * tile);
+      if (t + 1 < n_tile) prefetch(t + 1);
+      qudaStreamWaitEvent(compute_stream, copied[b], 0);
+      for (int i = 0; i < n; i++) {
+        left_d[i].copy(left_h[b][i]);
+        if (svd) right_d[i].copy(right_h[b][i]);
+      }
+
+      auto &r_buf = svd ? right_d : left_d;
+      cvector_ref<const ColorSpinorField> l_d {left_d.begin(), left_d.begin() + n};
+      cvector_ref<const ColorSpinorField> r_d {r_buf.begin(), r_buf.begin() + n};
+
+      // Since the projections onto each tile are independent, we
+      // can apply the full deflation (projection, rescaling and
+      // accumulation) for one tile before moving on to the next
+      std::vector<Complex> s(n * src.size());
+      blas::block::cDotProduct(s, l_d, {src.begin(), src.end()});
+      for (auto j = 0u; j < src.size(); j++)
+        for (int i = 0; i < n; i++) { s[i * src.size() + j] /= evals[t * tile + i].real(); }
+      blas::block::caxpy(s, r_d, {sol.begin(), sol.end()});
+
+      qudaEventRecord(computed[b], compute_stream);
+    }
+
+    qudaStreamSynchronize(compute_stream);
+    for (int b = 0; b < 2; b++) {
+      qudaEventDestroy(copied[b]);
+      qudaEventDestroy(computed[b]);
+    }
+  }
+
   void EigenSolver::loadFromFile(std::vector<ColorSpinorField> &kSpace,
                                  std::vector<Complex> &evals)
   {
@@ -794,12 +1138,141 @@ namespace quda
   template <> struct eigen_matrix_map<Complex> { using type = MatrixXcd; };
   template <class T> using eigen_matrix_t = typename eigen_matrix_map<T>::type;
 
+  /**
+     @brief Rotate the Krylov space in place with a native GEMM, treating
+     the vectors kSpace[locked, locked + dim) as the columns of a
+     tall-skinny matrix.  The vectors are processed in tiles of
+     consecutive elements, so the only temporaries are a tile of the
+     input and output vectors, which together take the memory of
+     tile_vecs vectors.  The field data is rotated as raw complex
+     numbers, so this is only applicable to single and double
+     precision device fields.  If the memory budget only allows tiles
+     so small that the per-vector gather and scatter copies would
+     dominate, the rotation is left to the multi-blas path.
+     @param[in,out] kSpace The Krylov space; the rotated vectors are
+     written to kSpace[locked, locked + keep), as in the multi-blas
+     path, and kSpace[offset, end) is left untouched
+     @param[in] rot_array The rotation matrix, stored as rot_array[i * keep + j]
+     @param[in] offset The position of the start of unused vectors in kSpace
+     @param[in] dim The number of rows in the rotation array
+     @param[in] keep The number of columns in the rotation array
+     @param[in] locked The number of locked vectors in kSpace
+     @param[in] tile_vecs The temporary memory budget in units of vectors
+     @return Whether the rotation was applied
+  */
+  template <typename T>
+  static bool rotateVecsGEMM(std::vector<ColorSpinorField> &kSpace, const std::vector<T> &rot_array, int offset,
+                             int dim, int keep, int locked, int tile_vecs)
+  {
+    // the unused vectors are the multi-blas workspace, so they must
+    // not overlap the vectors being rotated
+    if (offset < locked + std::max(dim, keep))
+      errorQuda("Rotation workspace offset %d overlaps the rotated vectors [%d, %d)", offset, locked,
+                locked + std::max(dim, keep));
+
+#ifdef NATIVE_LAPACK_LIB
+    if (!blas_lapack::use_native()) return false;
+    const auto &v0 = kSpace[locked];
+    if (v0.Location() != QUDA_CUDA_FIELD_LOCATION) return false;
+    if (v0.Precision() != QUDA_DOUBLE_PRECISION && v0.Precision() != QUDA_SINGLE_PRECISION) return false;
+    for (int i = 0; i < dim; i++)
+      if (kSpace[locked + i].Bytes() != v0.Bytes() || kSpace[locked + i].Precision() != v0.Precision()) return false;
+
+    const size_t elem_bytes = 2 * v0.Precision();
+    const size_t n_elem = v0.Bytes() / elem_bytes;
+    const size_t max_tile = std::numeric_limits<int>::max() / std::max(dim, keep);
+    const size_t tile = std::min({n_elem, max_tile, std::max(size_t(1), tile_vecs * n_elem / (dim + keep))});
+
+    // each tile costs dim + keep copies, so below this size the copy
+    // latency outweighs the GEMM and the multi-blas rotation is faster
+    constexpr size_t min_tile_bytes = 1 << 20;
+    if (tile < n_elem && tile * elem_bytes < min_tile_bytes) {
+      logQuda(QUDA_DEBUG_VERBOSE, "Rotation tile of %lu bytes is too small for the GEMM rotation\n", tile * elem_bytes);
+      return false;
+    }
+
+    // the rotation matrix in column-major order, in the field precision
+    std::vector<char> rot_h(dim * keep * elem_bytes);
+    for (int j = 0; j < keep; j++) {
+      for (int i = 0; i < dim; i++) {
+        Complex r = rot_array[i * keep + j];
+        if (v0.Precision() == QUDA_DOUBLE_PRECISION)
+          reinterpret_cast<std::complex<double> *>(rot_h.data())[j * dim + i] = r;
+        else
+          reinterpret_cast<std::complex<float> *>(rot_h.data())[j * dim + i] = std::complex<float>(r);
+      }
+    }
+
+    void *rot_d = pool_device_malloc(rot_h.size());
+    void *in_d = pool_device_malloc(tile * dim * elem_bytes);
+    void *out_d = pool_device_malloc(tile * keep * elem_bytes);
+    qudaMemcpy(rot_d, rot_h.data(), rot_h.size(), qudaMemcpyHostToDevice);
+
+    QudaBLASParam blas_param = newQudaBLASParam();
+    blas_param.blas_type = QUDA_BLAS_GEMM;
+    blas_param.trans_a = QUDA_BLAS_OP_N;
+    blas_param.trans_b = QUDA_BLAS_OP_N;
+    blas_param.n = keep;
+    blas_param.k = dim;
+    blas_param.ldb = dim;
+    blas_param.a_offset = 0;
+    blas_param.b_offset = 0;
+    blas_param.c_offset = 0;
+    blas_param.a_stride = 0;
+    blas_param.b_stride = 0;
+    blas_param.c_stride = 0;
+    blas_param.alpha = 1.0;
+    blas_param.beta = 0.0;
+    blas_param.batch_count = 1;
+    blas_param.data_type = v0.Precision() == QUDA_DOUBLE_PRECISION ? QUDA_BLAS_DATATYPE_Z : QUDA_BLAS_DATATYPE_C;
+    blas_param.data_order = QUDA_BLAS_DATAORDER_COL;
+
+    const auto &stream = device::get_default_stream();
+    for (size_t start = 0; start < n_elem; start += tile) {
+      const size_t len = std::min(tile, n_elem - start);
+      const size_t bytes = len * elem_bytes;
+
+      // gather the tile of each input vector into a column of in_d
+      for (int i = 0; i < dim; i++)
+        qudaMemcpyAsync(static_cast<char *>(in_d) + i * tile * elem_bytes,
+                        kSpace[locked + i].data<char *>() + start * elem_bytes, bytes, qudaMemcpyDeviceToDevice, stream);
+      qudaStreamSynchronize(stream);
+
+      // out = in * rot
+      blas_param.m = len;
+      blas_param.lda = tile;
+      blas_param.ldc = tile;
+      blas_lapack::native::stridedBatchGEMM(in_d, rot_d, out_d, blas_param, QUDA_CUDA_FIELD_LOCATION);
+
+      // the input tile has been consumed, so scatter the result in place
+      for (int j = 0; j < keep; j++)
+        qudaMemcpyAsync(kSpace[locked + j].data<char *>() + start * elem_bytes,
+                        static_cast<char *>(out_d) + j * tile * elem_bytes, bytes, qudaMemcpyDeviceToDevice, stream);
+    }
+    qudaStreamSynchronize(stream);
+
+    pool_device_free(out_d);
+    pool_device_free(in_d);
+    pool_device_free(rot_d);
+    return true;
+#else
+    return false;
+#endif
+  }
+
   template <typename T>
   void EigenSolver::rotateVecs(std::vector<ColorSpinorField> &kSpace, const std::vector<T> &rot_array, int offset,
                                int dim, int keep, int locked)
   {
     using matrix_t = eigen_matrix_t<T>;
 
+    // Use a tiled GEMM if possible, which needs only a tile of temporary memory
+    getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+    bool rotated
+      = rotateVecsGEMM(kSpace, rot_array, offset, dim, keep, locked, batched_rotate > 0 ? batched_rotate : keep);
+    getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+    if (rotated) return;
+
     // If we have memory available, do the entire rotation
     if (batched_rotate <= 0 || batched_rotate >= keep) {
       if ((int)kSpace.size() < offset + keep) {
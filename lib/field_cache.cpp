@@ -3,7 +3,7 @@
 
 namespace quda {
 
-  template <typename T> std::map<FieldKey<T>, std::stack<T>> FieldTmp<T>::cache;
+  template <typename T> typename FieldTmp<T>::cache_t FieldTmp<T>::cache;
 
   template <typename T> FieldTmp<T>::FieldTmp(const T &a) : key(FieldKey(a))
   {
@@ -62,5 +62,7 @@ namespace quda {
     cache.clear();
   }
 
+  template <typename T> void FieldTmp<T>::swap(cache_t &other) { cache.swap(other); }
+
   template class FieldTmp<ColorSpinorField>;
 }
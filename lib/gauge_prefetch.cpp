@@ -0,0 +1,130 @@
+#include <gauge_prefetch.h>
+#include <malloc_quda.h>
+#include <qio_field.h>
+#include <comm_quda.h>
+#include <util_quda.h>
+#include <timer.h>
+
+namespace quda
+{
+
+  GaugePrefetcher::GaugePrefetcher(const std::vector<std::string> &filenames, int depth, const QudaGaugeParam &param) :
+    filenames(filenames),
+    precision(param.cpu_prec),
+    // the QIO reads are collective on the global communicator, which the main thread continues to use
+    synchronous(comm_size() > 1),
+    slots(synchronous ? 1 : std::max(depth, 1) + 1)
+  {
+    if (filenames.empty()) errorQuda("No gauge configurations to prefetch");
+    if (precision != QUDA_DOUBLE_PRECISION && precision != QUDA_SINGLE_PRECISION)
+      errorQuda("Unsupported prefetch precision %d", precision);
+    if (synchronous)
+      warningQuda("Gauge prefetching is not supported with %d processes, reading each configuration when loaded",
+                  comm_size());
+
+    size_t volume = 1;
+    for (int d = 0; d < 4; d++) {
+      X[d] = param.X[d];
+      volume *= X[d];
+    }
+    const size_t bytes = volume * 18 * precision;
+
+    for (auto &slot : slots) {
+      for (int d = 0; d < 4; d++) slot.gauge[d] = pinned_malloc(bytes);
+      free_slots.push_back(&slot);
+    }
+
+    if (synchronous) return;
+
+    logQuda(QUDA_SUMMARIZE, "Prefetching %lu gauge configurations with depth %lu (%.2f GiB pinned host memory)\n",
+            filenames.size(), slots.size() - 1, slots.size() * 4 * bytes / static_cast<double>(1 << 30));
+
+    reader = std::thread(&GaugePrefetcher::read_loop, this);
+  }
+
+  GaugePrefetcher::~GaugePrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    cv.notify_all();
+    if (reader.joinable()) reader.join();
+
+    for (auto &slot : slots)
+      for (int d = 0; d < 4; d++) host_free(slot.gauge[d]);
+  }
+
+  void GaugePrefetcher::read(int i, Slot &slot)
+  {
+    host_timer_t timer;
+    timer.start();
+    read_gauge_field(filenames[i].c_str(), slot.gauge, precision, X, 0, nullptr);
+    timer.stop();
+    logQuda(QUDA_VERBOSE, "Read %s in %.3f seconds\n", filenames[i].c_str(), timer.last());
+    slot.index = i;
+  }
+
+  void GaugePrefetcher::read_loop()
+  {
+    for (auto i = 0u; i < filenames.size(); i++) {
+      Slot *slot = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return stop || !free_slots.empty(); });
+        if (stop) return;
+        slot = free_slots.front();
+        free_slots.pop_front();
+      }
+
+      read(i, *slot);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready_slots.push_back(slot);
+      }
+      cv.notify_all();
+    }
+  }
+
+  void **GaugePrefetcher::next()
+  {
+    if (synchronous) {
+      if (consumed == static_cast<int>(filenames.size())) {
+        current = nullptr;
+        return nullptr;
+      }
+      current = &slots[0];
+      read(consumed++, *current);
+      return current->gauge;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // return the buffer in use to the ring
+    if (current) {
+      free_slots.push_back(current);
+      current = nullptr;
+      cv.notify_all();
+    }
+
+    if (consumed == static_cast<int>(filenames.size())) return nullptr;
+
+    if (ready_slots.empty()) {
+      logQuda(QUDA_VERBOSE, "Waiting for prefetch of %s\n", filenames[consumed].c_str());
+      cv.wait(lock, [&] { return !ready_slots.empty(); });
+    }
+
+    current = ready_slots.front();
+    ready_slots.pop_front();
+    consumed++;
+    return current->gauge;
+  }
+
+  const std::string &GaugePrefetcher::filename() const
+  {
+    if (!current) errorQuda("No gauge configuration has been handed off");
+    return filenames[current->index];
+  }
+
+} // namespace quda
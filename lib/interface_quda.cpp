@@ -30,9 +30,11 @@
 #include <mpi_comm_handle.h>
 
 #include <multigrid.h>
+#include <mg_tune.h>
 #include <deflation.h>
 
 #include <gauge_backup.h>
+#include <gauge_prefetch.h>
 #include <clover_backup.h>
 #include <split_grid.h>
 
@@ -139,6 +141,9 @@ static TimeProfile profileInvert("invertQuda");
 //!< Profiler for invertMultiSrcQuda
 static TimeProfile profileInvertMultiSrc("invertMultiSrcQuda");
 
+//!< Profiler for tuneMultigridQuda
+static TimeProfile profileTuneMultigrid("tuneMultigridQuda");
+
 //!< Profiler for invertMultiShiftQuda
 static TimeProfile profileMulti("invertMultiShiftQuda");
 
@@ -996,6 +1001,33 @@ void freeSloppyGaugeQuda()
                                gaugeFatEigensolver);
 }
 
+static std::unique_ptr<GaugePrefetcher> gauge_prefetcher;
+
+void prefetchGaugeQuda(const char *const *filenames, int n_file, int depth, QudaGaugeParam *param)
+{
+  if (!initialized) errorQuda("QUDA not initialized");
+  if (gauge_prefetcher) errorQuda("Gauge prefetching already active");
+
+  std::vector<std::string> files(filenames, filenames + n_file);
+  gauge_prefetcher = std::make_unique<GaugePrefetcher>(files, depth, *param);
+}
+
+void *loadNextGaugeQuda(QudaGaugeParam *param)
+{
+  if (!gauge_prefetcher) errorQuda("Gauge prefetching not active");
+  if (param->gauge_order != QUDA_QDP_GAUGE_ORDER)
+    errorQuda("Prefetched gauge fields are in QDP order, requested order %d", param->gauge_order);
+
+  auto gauge = gauge_prefetcher->next();
+  if (!gauge) return nullptr;
+
+  logQuda(QUDA_SUMMARIZE, "Loading prefetched gauge field %s\n", gauge_prefetcher->filename().c_str());
+  loadGaugeQuda(gauge, param);
+  return gauge;
+}
+
+void endPrefetchGaugeQuda(void) { gauge_prefetcher.reset(); }
+
 void freeGaugeQuda(void)
 {
   if (!initialized) errorQuda("QUDA not initialized");
@@ -1343,6 +1375,7 @@ void endQuda(void)
   {
     auto profile = pushProfile(profileEnd);
 
+    endPrefetchGaugeQuda();
     freeGaugeQuda();
     freeCloverQuda();
 
@@ -1617,7 +1650,15 @@ namespace quda {
                 inv_param->cuda_prec_precondition);
   }
 
-  void setDiracEigParam(DiracParam &diracParam, QudaInvertParam *inv_param, bool pc, bool use_smeared_gauge)
+  /**
+     @brief Set the parameters of the eigensolver operator.  With
+     precise set the operator is built at the outer precision cuda_prec
+     from the precise gauge and clover fields (or the smeared gauge
+     field, which is kept at that precision), as used to refine the
+     eigenpairs of a sloppy eigensolve
+  */
+  void setDiracEigParam(DiracParam &diracParam, QudaInvertParam *inv_param, bool pc, bool use_smeared_gauge,
+                        bool precise = false)
   {
     setDiracParam(diracParam, inv_param, pc);
 
@@ -1639,12 +1680,12 @@ namespace quda {
       } else {
         errorQuda("Smeared gauge field not supported for operator %d", inv_param->dslash_type);
       }
-    } else {
+    } else if (!precise) {
       diracParam.gauge = inv_param->dslash_type == QUDA_ASQTAD_DSLASH ? gaugeFatEigensolver : gaugeEigensolver;
       diracParam.fatGauge = gaugeFatEigensolver;
       diracParam.longGauge = gaugeLongEigensolver;
     }
-    diracParam.clover = cloverEigensolver;
+    diracParam.clover = precise ? cloverPrecise : cloverEigensolver;
 
     for (int i = 0; i < 4; i++) { diracParam.commDim[i] = 1; }
 
@@ -1652,12 +1693,12 @@ namespace quda {
     if (inv_param->inv_type == QUDA_PCG_INVERTER && inv_param->dslash_type == QUDA_ASQTAD_DSLASH
         && inv_param->dslash_type_precondition == QUDA_STAGGERED_DSLASH) {
       diracParam.type = pc ? QUDA_STAGGEREDPC_DIRAC : QUDA_STAGGERED_DIRAC;
-      diracParam.gauge = gaugeFatEigensolver;
+      diracParam.gauge = precise ? gaugeFatPrecise : gaugeFatEigensolver;
     }
 
-    if (diracParam.gauge->Precision() != inv_param->cuda_prec_eigensolver)
-      errorQuda("Gauge precision %d does not match requested precision %d\n", diracParam.gauge->Precision(),
-                inv_param->cuda_prec_eigensolver);
+    auto prec = precise ? inv_param->cuda_prec : inv_param->cuda_prec_eigensolver;
+    if (diracParam.gauge->Precision() != prec)
+      errorQuda("Gauge precision %d does not match requested precision %d\n", diracParam.gauge->Precision(), prec);
   }
 
   void createDirac(Dirac *&d, Dirac *&dSloppy, Dirac *&dPre, QudaInvertParam &param, bool pc_solve)
@@ -2617,10 +2658,15 @@ void eigensolveQuda(void **host_evecs, double _Complex *host_evals, QudaEigParam
   // Ensure device vectors qre in UKQCD basis for Wilson type fermions
   if (cudaParam.nSpin != 1) cudaParam.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
 
+  // LOBPCG and deflation space refinement start from the whole
+  // supplied eigenspace, rather than just the initial block
+  int n_guess = eig_param->block_size;
+  if (eig_param->deflation_refine == QUDA_BOOLEAN_TRUE) n_guess = eig_param->n_conv;
+  else if (eig_param->eig_type == QUDA_EIG_LOBPCG) n_guess = std::min(n_eig, eig_param->n_ev);
   std::vector<ColorSpinorField> kSpace(n_eig);
   for (int i = 0; i < n_eig; i++) {
     kSpace[i] = ColorSpinorField(cudaParam);
-    if (i < eig_param->block_size) kSpace[i] = host_evecs_[i];
+    if (i < n_guess) kSpace[i] = host_evecs_[i];
   }
 
   // Simple vector for eigenvalues.
@@ -2653,31 +2699,78 @@ void eigensolveQuda(void **host_evecs, double _Complex *host_evals, QudaEigParam
   // options: The normal operator, the daggered operator, and if we pre
   // multiply by gamma5. Each combination requires a unique Dirac operator
   // object.
-  DiracMatrix *m = nullptr;
-  if (!eig_param->use_norm_op && !eig_param->use_dagger && eig_param->compute_gamma5) {
-    m = new DiracG5M(dirac);
-  } else if (!eig_param->use_norm_op && !eig_param->use_dagger && !eig_param->compute_gamma5) {
-    m = new DiracM(dirac);
-  } else if (!eig_param->use_norm_op && eig_param->use_dagger) {
-    m = new DiracMdag(dirac);
-  } else if (eig_param->use_norm_op && !eig_param->use_dagger) {
-    m = new DiracMdagM(dirac);
-  } else if (eig_param->use_norm_op && eig_param->use_dagger) {
-    m = new DiracMMdag(dirac);
-  } else {
-    errorQuda("Invalid use_norm_op, dagger, gamma_5 combination");
-  }
+  auto create_mat = [&](Dirac &dirac) -> DiracMatrix * {
+    if (!eig_param->use_norm_op && !eig_param->use_dagger && eig_param->compute_gamma5) {
+      return new DiracG5M(dirac);
+    } else if (!eig_param->use_norm_op && !eig_param->use_dagger && !eig_param->compute_gamma5) {
+      return new DiracM(dirac);
+    } else if (!eig_param->use_norm_op && eig_param->use_dagger) {
+      return new DiracMdag(dirac);
+    } else if (eig_param->use_norm_op && !eig_param->use_dagger) {
+      return new DiracMdagM(dirac);
+    } else if (eig_param->use_norm_op && eig_param->use_dagger) {
+      return new DiracMMdag(dirac);
+    } else {
+      errorQuda("Invalid use_norm_op, dagger, gamma_5 combination");
+    }
+    return nullptr;
+  };
+  DiracMatrix *m = create_mat(dirac);
+
+  // With precise refinement the Krylov process runs to the sloppy
+  // tolerance, and only the refined eigenpairs must meet tol
+  bool precise_refine = eig_param->precise_refine == QUDA_BOOLEAN_TRUE && !eig_param->arpack_check;
+  double tol = eig_param->tol;
+  if (precise_refine) eig_param->tol = std::max(eig_param->tol_sloppy, tol);
 
   // Perform the eigensolve
   if (eig_param->arpack_check) {
     arpack_solve(host_evecs_, evals, *m, eig_param);
   } else {
     auto *eig_solve = quda::EigenSolver::create(eig_param, *m);
-    (*eig_solve)(kSpace, evals);
+    if (eig_param->deflation_refine == QUDA_BOOLEAN_TRUE && host_evecs && eig_solve->refine(kSpace, evals)) {
+      if (eig_param->compute_svd && !precise_refine) eig_solve->computeSVD(kSpace, evals);
+    } else {
+      (*eig_solve)(kSpace, evals);
+    }
     delete eig_solve;
   }
 
   delete m;
+  eig_param->tol = tol;
+
+  if (precise_refine) {
+    // Promote the converged eigenvectors to the solver precision and
+    // refine them with the full precision operator, so the Ritz
+    // rotation and residuals are computed in that precision
+    ColorSpinorParam preciseParam(cudaParam);
+    preciseParam.create = QUDA_NULL_FIELD_CREATE;
+    preciseParam.setPrecision(inv_param->cuda_prec, inv_param->cuda_prec, true);
+    std::vector<ColorSpinorField> kSpace_precise(n_eig);
+    for (int i = 0; i < n_eig; i++) {
+      kSpace_precise[i] = ColorSpinorField(preciseParam);
+      kSpace_precise[i].copy(kSpace[i]);
+    }
+    kSpace.clear();
+
+    logQuda(QUDA_SUMMARIZE, "Refining %d eigenpairs from %d to %d precision\n", eig_param->n_conv,
+            inv_param->cuda_prec_eigensolver, inv_param->cuda_prec);
+    // the precise operator must match dEig (smeared gauge, dslash
+    // type) in everything but precision
+    DiracParam diracPreciseParam;
+    setDiracEigParam(diracPreciseParam, inv_param, pc_solve, eig_param->use_smeared_gauge, true);
+    Dirac *dPrecise = Dirac::create(diracPreciseParam);
+    DiracMatrix *m_precise = create_mat(*dPrecise);
+    auto *eig_solve = quda::EigenSolver::create(eig_param, *m_precise);
+    if (!eig_solve->refine(kSpace_precise, evals))
+      warningQuda("Precise refinement of the eigenpairs did not reach tol = %e", eig_param->tol);
+    if (eig_param->compute_svd) eig_solve->computeSVD(kSpace_precise, evals);
+    delete eig_solve;
+    delete m_precise;
+    delete dPrecise;
+
+    kSpace = std::move(kSpace_precise);
+  }
 
   // Transfer Eigenpairs back to host if using GPU eigensolver. The copy
   // will automatically rotate from device UKQCD gamma basis to the
@@ -2696,6 +2789,21 @@ void eigensolveQuda(void **host_evecs, double _Complex *host_evals, QudaEigParam
   popVerbosity();
 }
 
+/**
+   @brief The fingerprint of the gauge fields a multigrid hierarchy is
+   built from, which validates a checkpoint: for improved staggered
+   fermions this includes the long links, which carry the Naik term
+*/
+static uint64_t mgGaugeChecksum(QudaInvertParam *param)
+{
+  uint64_t checksum = checkGauge(param)->checksum();
+  if (param->dslash_type == QUDA_ASQTAD_DSLASH && gaugeLongPrecise) {
+    uint64_t long_checksum = gaugeLongPrecise->checksum();
+    checksum ^= (long_checksum << 1) | (long_checksum >> 63);
+  }
+  return checksum;
+}
+
 multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param)
 {
   QudaInvertParam *param = mg_param.invert_param;
@@ -2769,8 +2877,14 @@ multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param)
   // fill out the MG parameters for the fine level
   mgParam = new MGParam(mg_param, B, m, mSmooth, mSmoothSloppy);
 
+  // fingerprint the gauge field if we are restoring or saving a checkpoint of the hierarchy
+  if (strcmp(mg_param.checkpoint_infile, "") != 0 || strcmp(mg_param.checkpoint_outfile, "") != 0)
+    mgParam->gauge_checksum = mgGaugeChecksum(param);
+
   mg = new MG(*mgParam);
   mgParam->updateInvertParam(*param);
+
+  if (strcmp(mg_param.checkpoint_outfile, "") != 0) mg->saveCheckpoint(mg_param.checkpoint_outfile);
 }
 
 void *newMultigridQuda(QudaMultigridParam *mg_param)
@@ -2889,6 +3003,16 @@ void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
 
     bool refresh = true;
     mg->mg->reset(refresh);
+
+    // the hierarchy reports on the parameters it was created with
+    if (&mg->mgParam->mg_global != mg_param)
+      for (int i = 0; i < QUDA_MAX_MG_LEVEL; i++)
+        mg_param->setup_refresh_rebuilt[i] = mg->mgParam->mg_global.setup_refresh_rebuilt[i];
+
+    if (strcmp(mg_param->checkpoint_outfile, "") != 0) {
+      mg->mgParam->gauge_checksum = mgGaugeChecksum(param);
+      mg->mg->saveCheckpoint(mg_param->checkpoint_outfile);
+    }
   }
 
   setOutputPrefix("");
@@ -2915,6 +3039,174 @@ void dumpMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
   profilerStop(__func__);
 }
 
+void diagnoseMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
+{
+  profilerStart(__func__);
+  auto profile = pushProfile(profileInvert, mg_param->invert_param);
+  pushVerbosity(mg_param->invert_param->verbosity);
+
+  auto *mg = static_cast<multigrid_solver *>(mg_);
+  checkMultigridParam(mg_param);
+  checkGauge(mg_param->invert_param);
+
+  mg->mg->probeConvergenceFactors(mg_param->convergence_factor, mg_param->tune_n_probe);
+  for (int i = 0; i < mg_param->n_level - 1; i++)
+    logQuda(QUDA_SUMMARIZE, "MG level %d convergence factor = %e\n", i + 1, mg_param->convergence_factor[i]);
+
+  popVerbosity();
+  profilerStop(__func__);
+}
+
+/**
+   @brief Set up a multigrid solver with the given parameters, probe
+   its convergence factors, and measure the time to solution of the
+   outer solver for each of the given right-hand sides.  The timed
+   setup and solves follow an untimed warm-up setup and solve.
+*/
+static MGTuneResult measureMultigrid(QudaMultigridParam &mg_param, const QudaInvertParam &param,
+                                     std::vector<ColorSpinorField> &x, std::vector<ColorSpinorField> &b)
+{
+  QudaInvertParam solve_param = param;
+  solve_param.use_init_guess = QUDA_USE_INIT_GUESS_NO;
+  solve_param.input_location = QUDA_CPU_FIELD_LOCATION;
+  solve_param.output_location = QUDA_CPU_FIELD_LOCATION;
+  solve_param.verbosity = std::min(param.verbosity, QUDA_SUMMARIZE);
+
+  // the first setup and solve with a new block size or number of
+  // null-space vectors autotune the kernels they launch, so this
+  // warm-up repetition is discarded and the second one is timed
+  {
+    multigrid_solver mg(mg_param);
+    solve_param.preconditioner = &mg;
+    solve_param.iter = 0;
+    invertQuda(x[0].data(), b[0].data(), &solve_param);
+  }
+
+  MGTuneResult result;
+  host_timer_t timer;
+
+  timer.start();
+  auto *mg = new multigrid_solver(mg_param);
+  timer.stop();
+  result.setup_secs = timer.last();
+
+  mg->mg->probeConvergenceFactors(result.factor, mg_param.tune_n_probe);
+
+  solve_param.preconditioner = mg;
+  result.converged = true;
+  for (auto i = 0u; i < b.size(); i++) {
+    solve_param.iter = 0;
+    timer.start();
+    invertQuda(x[i].data(), b[i].data(), &solve_param);
+    timer.stop();
+    result.solve_secs += timer.last() / b.size();
+    result.iter += static_cast<double>(solve_param.iter) / b.size();
+    if (solve_param.iter >= solve_param.maxiter) result.converged = false;
+  }
+
+  delete mg;
+  return result;
+}
+
+static void printMultigridTuneResult(const char *label, const QudaMultigridParam &mg_param, const MGTuneResult &result)
+{
+  logQuda(QUDA_SUMMARIZE, "MG tune %s: setup = %.3f secs, solve = %.3f secs, iter = %.1f, cost = %.3f secs%s\n", label,
+          result.setup_secs, result.solve_secs, result.iter, result.cost(mg_param.tune_n_solve),
+          result.converged ? "" : " (not converged)");
+  for (int i = 0; i < mg_param.n_level - 1; i++) {
+    logQuda(QUDA_VERBOSE,
+            "MG tune %s: level %d block = %dx%dx%dx%d, n_vec = %d, setup_maxiter = %d, nu = %d/%d, factor = %e\n",
+            label, i + 1, mg_param.geo_block_size[i][0], mg_param.geo_block_size[i][1], mg_param.geo_block_size[i][2],
+            mg_param.geo_block_size[i][3], mg_param.n_vec[i], mg_param.setup_maxiter[i], mg_param.nu_pre[i],
+            mg_param.nu_post[i], result.factor[i]);
+  }
+}
+
+void tuneMultigridQuda(QudaMultigridParam *mg_param, QudaInvertParam *param)
+{
+  profilerStart(__func__);
+  auto profile = pushProfile(profileTuneMultigrid);
+  pushVerbosity(param->verbosity);
+
+  checkMultigridParam(mg_param);
+  if (param->inv_type_precondition != QUDA_MG_INVERTER)
+    errorQuda("Outer solver preconditioner type %d is not multigrid", param->inv_type_precondition);
+  if (mg_param->tune_n_probe < 1) errorQuda("Invalid number of probe right-hand sides %d", mg_param->tune_n_probe);
+  GaugeField *cudaGauge = checkGauge(param);
+
+  // the plaquette identifies the ensemble, where the fat links of improved staggered fermions are not unitary
+  double plaq[3] = {};
+  if (gaugePrecise && gaugePrecise->LinkType() == QUDA_SU3_LINKS) plaqQuda(plaq);
+  auto key = mgTuneKey(*mg_param, *param, cudaGauge->X(), plaq[0]);
+
+  MGTuneResult best_result;
+  if (mgTuneCacheLoad(key, *mg_param, best_result)) {
+    logQuda(QUDA_SUMMARIZE, "Using cached multigrid parameters for %s\n", key.c_str());
+  } else {
+    logQuda(QUDA_SUMMARIZE, "Tuning multigrid parameters for %s\n", key.c_str());
+
+    // random right-hand sides in the host order of the outer solver
+    bool pc_solution
+      = (param->solution_type == QUDA_MATPC_SOLUTION) || (param->solution_type == QUDA_MATPCDAG_MATPC_SOLUTION);
+    ColorSpinorParam cpuParam(nullptr, *param, cudaGauge->X(), pc_solution, QUDA_CPU_FIELD_LOCATION);
+    cpuParam.create = QUDA_NULL_FIELD_CREATE;
+    ColorSpinorParam cudaParam(cpuParam, *param, QUDA_CUDA_FIELD_LOCATION);
+    cudaParam.create = QUDA_NULL_FIELD_CREATE;
+    ColorSpinorField noise(cudaParam);
+
+    std::vector<ColorSpinorField> x, b;
+    resize(x, mg_param->tune_n_probe, cpuParam);
+    resize(b, mg_param->tune_n_probe, cpuParam);
+    for (auto i = 0u; i < b.size(); i++) {
+      spinorNoise(noise, 1234 + i, QUDA_NOISE_GAUSS);
+      b[i].copy(noise);
+    }
+
+    // the trial hierarchies are neither restored nor saved
+    QudaMultigridParam best = *mg_param;
+    best.checkpoint_infile[0] = '\0';
+    best.checkpoint_outfile[0] = '\0';
+
+    best_result = measureMultigrid(best, *param, x, b);
+    printMultigridTuneResult("initial", best, best_result);
+    if (!best_result.converged) warningQuda("The initial multigrid parameters did not converge");
+
+    const MGTuneKnob knobs[] = {MGTuneKnob::geo_block_size, MGTuneKnob::n_vec, MGTuneKnob::setup_maxiter,
+                                MGTuneKnob::nu_pre, MGTuneKnob::nu_post};
+    for (int level = 0; level < mg_param->n_level - 1; level++) {
+      for (auto knob : knobs) {
+        auto candidates = mgTuneCandidates(best, level, knob, cudaGauge->X());
+        QudaMultigridParam knob_best = best;
+        MGTuneResult knob_result = best_result;
+        for (auto &candidate : candidates) {
+          auto result = measureMultigrid(candidate, *param, x, b);
+          printMultigridTuneResult("candidate", candidate, result);
+          if (result.cost(mg_param->tune_n_solve) < knob_result.cost(mg_param->tune_n_solve)) {
+            knob_best = candidate;
+            knob_result = result;
+          }
+        }
+        best = knob_best;
+        best_result = knob_result;
+      }
+    }
+
+    if (!best_result.converged) errorQuda("No multigrid parameters converged");
+
+    strcpy(best.checkpoint_infile, mg_param->checkpoint_infile);
+    strcpy(best.checkpoint_outfile, mg_param->checkpoint_outfile);
+    *mg_param = best;
+    mgTuneCacheSave(key, *mg_param, best_result);
+  }
+
+  for (int i = 0; i < mg_param->n_level - 1; i++) mg_param->convergence_factor[i] = best_result.factor[i];
+  printMultigridTuneResult("result", *mg_param, best_result);
+  if (strcmp(mg_param->tune_outfile, "") != 0) mgTuneWrite(mg_param->tune_outfile, key, *mg_param, best_result);
+
+  popVerbosity();
+  profilerStop(__func__);
+}
+
 deflated_solver::deflated_solver(QudaEigParam &eig_param, TimeProfile &profile)
   : d(nullptr), m(nullptr), RV(nullptr), deflParam(nullptr), defl(nullptr),  profile(profile) {
 
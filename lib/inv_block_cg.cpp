@@ -0,0 +1,243 @@
+#include <cmath>
+#include <limits>
+
+#include <blas_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+#include <eigen_helper.h>
+
+namespace quda
+{
+
+  BlockCG::BlockCG(const DiracMatrix &mat, const DiracMatrix &matSloppy, SolverParam &param) :
+    Solver(mat, matSloppy, matSloppy, matSloppy, param)
+  {
+  }
+
+  void BlockCG::create(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b)
+  {
+    Solver::create(x, b);
+
+    if (!init || r.size() != b.size()) {
+      getProfile().TPSTART(QUDA_PROFILE_INIT);
+
+      resize(r, b.size(), QUDA_NULL_FIELD_CREATE, b[0]);
+
+      // sloppy fields
+      ColorSpinorParam csParam(x[0]);
+      csParam.create = QUDA_NULL_FIELD_CREATE;
+      csParam.setPrecision(param.precision_sloppy);
+      resize(x_sloppy, b.size(), csParam);
+      resize(Q, b.size(), csParam);
+      resize(S, b.size(), csParam);
+      resize(Z, b.size(), csParam);
+      resize(T, b.size(), csParam);
+
+      init = true;
+      getProfile().TPSTOP(QUDA_PROFILE_INIT);
+    }
+  }
+
+  cvector_ref<const ColorSpinorField> BlockCG::get_residual()
+  {
+    if (!init) errorQuda("No residual vector present");
+    return r;
+  }
+
+  int BlockCG::orthonormalize(std::vector<ColorSpinorField> &W, int n, MatrixXcd &psi)
+  {
+    // the rank is determined relative to the sloppy precision
+    const double eps = precisionEpsilon(param.precision_sloppy);
+    psi = MatrixXcd::Identity(n, n);
+    int rank = n;
+
+    // two passes of Cholesky QR via the eigen-decomposition of the
+    // Gram matrix, where the second pass restores the orthogonality
+    // lost in the first
+    for (int pass = 0; pass < 2 && rank > 0; pass++) {
+      vector_ref<ColorSpinorField> W_ {W.begin(), W.begin() + rank};
+      MatrixXcd G = EigenSolver::gram(W_, W_);
+      SelfAdjointEigenSolver<MatrixXcd> eig(0.5 * (G + G.adjoint()));
+
+      // eigenvalues are in ascending order, so drop the leading ones
+      const auto &lambda = eig.eigenvalues();
+      double lambda_max = lambda[rank - 1];
+      int drop = 0;
+      while (drop < rank && !(lambda[drop] > eps * eps * lambda_max)) drop++;
+      int new_rank = rank - drop;
+      if (new_rank == 0) {
+        psi = MatrixXcd::Zero(0, n);
+        return 0;
+      }
+
+      MatrixXcd U = eig.eigenvectors().rightCols(new_rank);
+      VectorXd sigma = lambda.tail(new_rank).cwiseSqrt();
+
+      EigenSolver::rotate({T.begin(), T.begin() + new_rank}, W_, U * sigma.cwiseInverse().asDiagonal(), false);
+      for (int i = 0; i < new_rank; i++) std::swap(W[i], T[i]);
+      psi = (sigma.asDiagonal() * U.adjoint() * psi).eval();
+      rank = new_rank;
+    }
+
+    return rank;
+  }
+
+  void BlockCG::operator()(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b)
+  {
+    commGlobalReductionPush(param.global_reduction);
+
+    if (param.maxiter == 0 || param.Nsteps == 0) {
+      if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
+      commGlobalReductionPop();
+      return;
+    }
+
+    create(x, b);
+
+    getProfile().TPSTART(QUDA_PROFILE_PREAMBLE);
+
+    const int n_rhs = b.size();
+    vector<double> b2 = blas::norm2(b);
+    vector<double> r2;
+
+    // Check to see that we're not trying to invert on a zero-field source
+    if (is_zero_src(x, b, b2)) {
+      getProfile().TPSTOP(QUDA_PROFILE_PREAMBLE);
+      commGlobalReductionPop();
+      return;
+    }
+
+    if (param.use_init_guess == QUDA_USE_INIT_GUESS_YES) {
+      mat(r, x);
+      r2 = blas::xmyNorm(b, r);
+      for (auto i = 0u; i < b.size(); i++)
+        if (b2[i] == 0) b2[i] = r2[i];
+    } else {
+      blas::zero(x);
+      blas::copy(r, b);
+      r2 = b2;
+    }
+
+    auto stop = stopping(param.tol, b2, param.residual_type);
+
+    // directions whose contribution to every residual is well below
+    // the tolerance are deflated from the block; zero sources have a
+    // zero solution and play no part in this
+    double deflate_tol = std::numeric_limits<double>::max();
+    for (int i = 0; i < n_rhs; i++)
+      if (b2[i] > 0) deflate_tol = std::min(deflate_tol, 0.1 * sqrt(stop[i]));
+
+    getProfile().TPSTOP(QUDA_PROFILE_PREAMBLE);
+    getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+
+    int k = 0;
+    int res_increase = 0;
+    bool converged = convergenceL2(r2, stop);
+    bool breakdown = false;
+    PrintStats("BlockCG", k, r2, b2);
+
+    while (!converged && !breakdown && k < param.maxiter) {
+      // (re)start from the true residual: R = Q C, S = Q
+      blas::copy(Q, r);
+      MatrixXcd C;
+      int s = orthonormalize(Q, n_rhs, C);
+      for (int i = 0; i < s; i++) blas::copy(S[i], Q[i]);
+      blas::zero(x_sloppy);
+
+      double r2_max = 0.0;
+      for (auto ri : r2) r2_max = std::max(r2_max, ri);
+      double r2_max_update = r2_max;
+
+      while (s > 0 && k < param.maxiter) {
+        vector_ref<ColorSpinorField> S_ {S.begin(), S.begin() + s};
+        vector_ref<ColorSpinorField> Z_ {Z.begin(), Z.begin() + s};
+        vector_ref<ColorSpinorField> Q_ {Q.begin(), Q.begin() + s};
+
+        // Z = A S, with all directions in a single multi-RHS application
+        matSloppy(Z_, S_);
+
+        // alpha = (S^dag A S)^{-1}
+        MatrixXcd SZ = EigenSolver::gram(S_, Z_);
+        LDLT<MatrixXcd> ldlt(0.5 * (SZ + SZ.adjoint()));
+        if (ldlt.info() != Success || !ldlt.isPositive()) {
+          warningQuda("BlockCG: operator is not positive definite on the search space");
+          breakdown = true;
+          break;
+        }
+        MatrixXcd alpha = ldlt.solve(MatrixXcd::Identity(s, s));
+
+        // X += S alpha C
+        EigenSolver::rotate(x_sloppy, S_, alpha * C, true);
+
+        // Q = Q - Z alpha = Q psi
+        EigenSolver::rotate(Q_, Z_, -alpha, true);
+        MatrixXcd psi;
+        int rank = orthonormalize(Q, s, psi);
+        MatrixXcd C_new = psi * C;
+
+        // deflate the directions that no longer contribute to any residual
+        int s_new = 0;
+        MatrixXcd U;
+        if (rank > 0) {
+          JacobiSVD<MatrixXcd> svd(C_new, ComputeFullU);
+          while (s_new < rank && svd.singularValues()[s_new] > deflate_tol) s_new++;
+          U = svd.matrixU().leftCols(s_new);
+        }
+        if (s_new < s) logQuda(QUDA_VERBOSE, "BlockCG: deflating block size from %d to %d\n", s, s_new);
+
+        k++;
+
+        if (s_new > 0) {
+          // Q = Q U, C = U^dag C_new, S = Q + S psi^dag U
+          EigenSolver::rotate({T.begin(), T.begin() + s_new}, {Q.begin(), Q.begin() + rank}, U, false);
+          for (int i = 0; i < s_new; i++) std::swap(Q[i], T[i]);
+          C = U.adjoint() * C_new;
+          for (int i = 0; i < s_new; i++) blas::copy(T[i], Q[i]);
+          EigenSolver::rotate({T.begin(), T.begin() + s_new}, S_, psi.adjoint() * U, true);
+          for (int i = 0; i < s_new; i++) std::swap(S[i], T[i]);
+        }
+        s = s_new;
+
+        // the iterated residual norms are the column norms of C
+        for (int j = 0; j < n_rhs; j++) r2[j] = s > 0 ? C.col(j).squaredNorm() : 0.0;
+        PrintStats("BlockCG", k, r2, b2);
+
+        r2_max = 0.0;
+        for (auto ri : r2) r2_max = std::max(r2_max, ri);
+        if (convergenceL2(r2, stop) || r2_max < param.delta * param.delta * r2_max_update) break;
+      }
+
+      // reliable update: accumulate the solution and compute the true residual
+      blas::xpy(x_sloppy, x);
+      mat(r, x);
+      auto r2_old = r2;
+      r2 = blas::xmyNorm(b, r);
+      converged = convergenceL2(r2, stop);
+
+      logQuda(QUDA_DEBUG_VERBOSE, "BlockCG: reliable update at iteration %d\n", k);
+
+      if (!converged && convergenceL2(r2_old, stop) && ++res_increase > param.max_res_increase) {
+        warningQuda("BlockCG: solver exiting due to too many true residual norm increases");
+        break;
+      }
+    }
+
+    getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+    getProfile().TPSTART(QUDA_PROFILE_EPILOGUE);
+
+    if (k == param.maxiter) warningQuda("Exceeded maximum iterations %d", param.maxiter);
+
+    param.iter += k;
+
+    for (int i = 0; i < n_rhs; i++) {
+      param.true_res[i] = b2[i] > 0 ? sqrt(r2[i] / b2[i]) : 0.0;
+      param.true_res_hq[i] = 0.0;
+    }
+    PrintSummary("BlockCG", k, r2, b2, stop);
+
+    getProfile().TPSTOP(QUDA_PROFILE_EPILOGUE);
+
+    commGlobalReductionPop();
+  }
+
+} // namespace quda
@@ -60,6 +60,25 @@ namespace quda {
     if (!param.use_sloppy_partial_accumulator) create_alias(x_sloppy, x);
   }
 
+  void CG::set_sloppy_precision(cvector_ref<ColorSpinorField> &x, QudaPrecision prec)
+  {
+    if (Ap[0].Precision() == prec) return;
+
+    ColorSpinorParam csParam(x[0]);
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    csParam.setPrecision(prec);
+
+    Ap.clear();
+    resize(Ap, x.size(), csParam);
+
+    r_sloppy.clear();
+    if (prec != param.precision) {
+      resize(r_sloppy, x.size(), csParam);
+    } else {
+      create_alias(r_sloppy, r);
+    }
+  }
+
   void CG::operator()(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b,
                       cvector_ref<const ColorSpinorField> &p_init, cvector<double> &r2_old_init)
   {
@@ -126,7 +145,22 @@ namespace quda {
       }
     }
 
-    const double u = precisionEpsilon(param.precision_sloppy);
+    // The ladder of operators, and their precisions, that the sloppy
+    // iteration runs on.  With adaptive precision we start on the
+    // preconditioner operator and promote at a reliable update that
+    // shows stagnation, with each operator built on the matching
+    // resident gauge field copy.
+    std::vector<std::pair<const DiracMatrix *, QudaPrecision>> ladder = {{&matSloppy, param.precision_sloppy}};
+    if (param.adaptive_precision && advanced_feature && !param.is_preconditioner
+        && param.schwarz_type == QUDA_INVALID_SCHWARZ) {
+      if (param.precision_precondition < param.precision_sloppy)
+        ladder.insert(ladder.begin(), {&matPrecon, param.precision_precondition});
+      if (param.precision > param.precision_sloppy) ladder.push_back({&mat, param.precision});
+    }
+    auto level = 0u;
+    set_sloppy_precision(x, ladder[level].second);
+
+    const double u = precisionEpsilon(ladder[level].second);
     const double uhigh = precisionEpsilon(); // solver precision
 
     double Anorm = 0.0;
@@ -172,6 +206,7 @@ namespace quda {
       x_update_batch[i] = XUpdateBatch(Np, !p_init[i].empty() ? p_init[i] : r_sloppy[i], csParam);
 
     vector<double> r2_old(r2.size(), 0.0);
+    vector<double> r2_reliable = r2; // true residuals at the last reliable update, to judge stagnation
     for (auto i = 0u; i < b.size(); i++) {
       if (r2_old_init[i] != 0.0 and !p_init[i].empty()) {
         // FIXME vectorize this
@@ -234,7 +269,7 @@ namespace quda {
     while ( !converged && k < param.maxiter ) {
       auto p = get_p(x_update_batch);
       auto p_next = get_p(x_update_batch, true);
-      matSloppy(Ap, p);
+      (*ladder[level].first)(Ap, p);
 
       vector<double> sigma(b.size());
 
@@ -336,6 +371,7 @@ namespace quda {
         }
         blas::xpy(x_sloppy, y); // swap these around?
 
+        auto r2_iter = r2;
         mat(r, y);       //  here we can use x as tmp
         r2 = blas::xmyNorm(b, r);
 
@@ -350,6 +386,19 @@ namespace quda {
           ru.update_maxr_deflate(r2[0]);
         }
 
+        if (level + 1 < ladder.size() && ReliableUpdates::stagnating(r2, r2_iter, r2_reliable)) {
+          level++;
+          param.adaptive_promotions++;
+          logQuda(QUDA_SUMMARIZE, "CG: promoting sloppy precision to %d bytes at iteration %d\n", ladder[level].second,
+                  k);
+          set_sloppy_precision(x, ladder[level].second);
+          ru.update_u(precisionEpsilon(ladder[level].second));
+
+          // carry the search directions over to the new precision
+          ColorSpinorParam promoted(r_sloppy[0]);
+          for (auto &xi : x_update_batch) xi = XUpdateBatch(Np, xi.get_current_field(), promoted);
+        }
+
         blas::copy(r_sloppy, r); // nop when these pointers alias
         blas::zero(x_sloppy);
 
@@ -373,6 +422,7 @@ namespace quda {
         blas::xpayz(r_sloppy, beta, p, p_next);
 
         ru.reset(r2[0]);
+        r2_reliable = r2;
       }
 
       breakdown = false;
@@ -399,6 +449,9 @@ namespace quda {
     blas::copy(x, x_sloppy);
     blas::xpy(y, x);
 
+    // restore the sloppy fields for subsequent solves
+    if (ladder.size() > 1) set_sloppy_precision(x, param.precision_sloppy);
+
     if (!param.is_preconditioner) {
       getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
       getProfile().TPSTART(QUDA_PROFILE_EPILOGUE);
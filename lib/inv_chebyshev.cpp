@@ -0,0 +1,134 @@
+#include <quda_internal.h>
+#include <blas_quda.h>
+#include <invert_quda.h>
+#include <solver.hpp>
+
+namespace quda
+{
+
+  Chebyshev::Chebyshev(const DiracMatrix &mat, const DiracMatrix &matSloppy, SolverParam &param) :
+    Solver(mat, matSloppy, matSloppy, matSloppy, param), mdagmSloppy(matSloppy.Expose()), mdagSloppy(matSloppy.Expose())
+  {
+  }
+
+  void Chebyshev::create(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b)
+  {
+    Solver::create(x, b);
+
+    if (!init || r.size() != b.size()) {
+      resize(r, b.size(), QUDA_NULL_FIELD_CREATE, b[0]);
+
+      // now allocate sloppy fields
+      ColorSpinorParam csParam(b[0]);
+      csParam.create = QUDA_NULL_FIELD_CREATE;
+      csParam.setPrecision(param.precision_sloppy);
+      resize(d, b.size(), csParam);
+      resize(Ad, b.size(), csParam);
+      resize(x_sloppy, b.size(), csParam);
+
+      if (param.precision != param.precision_sloppy) { // mixed precision
+        resize(r_sloppy, b.size(), csParam);
+      } else {
+        create_alias(r_sloppy, r);
+      }
+
+      // the residual of the normal equations
+      if (!matSloppy.hermitian()) resize(s_sloppy, b.size(), csParam);
+
+      init = true;
+    } // init
+  }
+
+  cvector_ref<const ColorSpinorField> Chebyshev::get_residual()
+  {
+    if (!init) errorQuda("No residual vector present");
+    if (!param.return_residual) errorQuda("SolverParam::return_residual not enabled");
+    if (param.precision != param.precision_sloppy && !param.compute_true_res) blas::copy(r, r_sloppy);
+    return r;
+  }
+
+  void Chebyshev::operator()(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b)
+  {
+    if (param.maxiter == 0 || param.Nsteps == 0) {
+      if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
+      return;
+    }
+
+    create(x, b); // allocate fields
+
+    if (!param.is_preconditioner) getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+
+    if (param.use_init_guess == QUDA_USE_INIT_GUESS_YES) {
+      mat(r, x);
+      blas::xpay(b, -1.0, r); // r = b - Ax0
+    } else {
+      blas::copy(r, b);
+      blas::zero(x);
+    }
+    blas::copy(r_sloppy, r);
+
+    // a non-Hermitian operator is smoothed through the normal equations, whose residual s = M^dag r
+    // is recomputed from the residual r of the original system
+    bool normal = !matSloppy.hermitian();
+    const DiracMatrix &op = normal ? static_cast<const DiracMatrix &>(mdagmSloppy) : matSloppy;
+    auto &s = normal ? s_sloppy : r_sloppy;
+    if (normal) mdagSloppy(s, r_sloppy);
+
+    // the bounds are only estimated once, after which the iteration is reduction free
+    auto &lambda_max = param.ca_lambda_max;
+    if (lambda_max < param.ca_lambda_min) {
+      lambda_max = 1.1 * Solver::performPowerIterations(op, s[0], d[0], Ad[0], 100, 10);
+      logQuda(QUDA_SUMMARIZE, "Chebyshev approximate lambda max = 1.1 x %e\n", lambda_max / 1.1);
+    }
+    double lambda_min = param.ca_lambda_min > 0.0 ? param.ca_lambda_min : 0.1 * lambda_max;
+    if (lambda_min >= lambda_max) errorQuda("Invalid Chebyshev interval [%e, %e]", lambda_min, lambda_max);
+
+    double theta = 0.5 * (lambda_max + lambda_min);
+    double delta = 0.5 * (lambda_max - lambda_min);
+    double sigma = theta / delta;
+    double rho = 1.0 / sigma;
+
+    // d_0 = s_0 / theta
+    blas::copy(d, s);
+    blas::ax(1.0 / theta, d);
+    blas::zero(x_sloppy);
+
+    for (int k = 0; k < param.maxiter; k++) {
+      // the residual is only needed after the last iteration if it is to be returned
+      if (k == param.maxiter - 1 && !param.return_residual) {
+        blas::xpy(d, x_sloppy);
+        break;
+      }
+
+      matSloppy(Ad, d);
+      blas::axpy(-1.0, Ad, r_sloppy); // r_{k+1} = r_k - A d_k
+
+      if (k == param.maxiter - 1) {
+        blas::xpy(d, x_sloppy);
+        break;
+      }
+
+      if (normal) mdagSloppy(s, r_sloppy); // s_{k+1} = M^dag r_{k+1}
+
+      // x_{k+1} = x_k + d_k, d_{k+1} = rho_{k+1} rho_k d_k + 2 rho_{k+1} / delta s_{k+1}
+      double rho_new = 1.0 / (2.0 * sigma - rho);
+      blas::axpyBzpcx(1.0, d, x_sloppy, 2.0 * rho_new / delta, s, rho_new * rho);
+      rho = rho_new;
+    }
+
+    blas::xpy(x_sloppy, x);
+
+    if (param.compute_true_res) {
+      mat(r, x);
+      blas::xpay(b, -1.0, r);
+    }
+
+    logQuda(QUDA_VERBOSE, "Chebyshev: %d iterations on [%e, %e]\n", param.maxiter, lambda_min, lambda_max);
+
+    if (!param.is_preconditioner) {
+      getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+      param.iter += param.maxiter;
+    }
+  }
+
+} // namespace quda
@@ -82,6 +82,44 @@ namespace quda {
     }
   }
 
+  void GCR::orthoDir(std::vector<std::vector<Complex>> &beta, std::vector<std::vector<ColorSpinorField>> &Ap, int k,
+                     int pipeline)
+  {
+    const auto n_rhs = beta.size();
+    auto set_beta = [&](int i, cvector<Complex> &b) {
+      for (auto j = 0u; j < n_rhs; j++) beta[j][i * n_krylov + k] = b[j];
+    };
+    auto minus_beta = [&](int i) {
+      vector<Complex> b(n_rhs);
+      for (auto j = 0u; j < n_rhs; j++) b[j] = -beta[j][i * n_krylov + k];
+      return b;
+    };
+
+    switch (pipeline) {
+    case 0: // no kernel fusion
+      for (int i = 0; i < k; i++) {
+        set_beta(i, blas::cDotProduct(Ap[i], Ap[k]));
+        blas::caxpy(minus_beta(i), Ap[i], Ap[k]);
+      }
+      break;
+    case 1: // basic kernel fusion
+      if (k == 0) break;
+      set_beta(0, blas::cDotProduct(Ap[0], Ap[k]));
+      for (int i = 0; i < k - 1; i++) set_beta(i + 1, blas::caxpyDotzy(minus_beta(i), Ap[i], Ap[k], Ap[i + 1]));
+      blas::caxpy(minus_beta(k - 1), Ap[k - 1], Ap[k]);
+      break;
+    default:
+      // the block kernels fuse over the Krylov space, so are applied to each right hand side in turn
+      for (auto j = 0u; j < n_rhs; j++) {
+        vector_ref<ColorSpinorField> Ap_j;
+        Ap_j.reserve(Ap.size());
+        for (auto &a : Ap) Ap_j.push_back(a[j]);
+        orthoDir(beta[j], Ap_j, k, pipeline);
+      }
+      break;
+    }
+  }
+
   void GCR::backSubs(const std::vector<Complex> &alpha, const std::vector<Complex> &beta,
                      const std::vector<double> &gamma, std::vector<Complex> &delta, int n)
   {
@@ -321,7 +359,7 @@ namespace quda {
         return p_i;
       };
 
-      for (auto i = 0u; i < b.size(); i++) orthoDir(beta[i], get_i(Ap, i), k, pipeline);
+      orthoDir(beta, Ap, k, pipeline);
 
       auto Apr = blas::cDotProductNormA(Ap[k], K ? r_sloppy : p[k]);
 
@@ -152,4 +152,72 @@ namespace quda
     getProfile().TPSTOP(QUDA_PROFILE_CHRONO);
   }
 
+  void recycleExtrapolate(cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b,
+                          std::vector<ColorSpinorField> &p, std::vector<ColorSpinorField> &q, bool hermitian)
+  {
+    getProfile().TPSTART(QUDA_PROFILE_CHRONO);
+    logQuda(QUDA_VERBOSE, "Projecting %lu sources onto recycled basis of size %lu\n", b.size(), p.size());
+
+    // Galerkin condition P^dag (b - Q psi) = 0 for a Hermitian
+    // operator, else the minimum residual condition Q^dag (b - Q psi) = 0
+    auto &w = hermitian ? p : q;
+    MatrixXcd G = EigenSolver::gram(w, q);
+    MatrixXcd B = EigenSolver::gram(w, b);
+
+    getProfile().TPSTOP(QUDA_PROFILE_CHRONO);
+    getProfile().TPSTART(QUDA_PROFILE_EIGEN);
+
+    LDLT<MatrixXcd> ldlt(0.5 * (G + G.adjoint()));
+    MatrixXcd psi = ldlt.solve(B);
+
+    getProfile().TPSTOP(QUDA_PROFILE_EIGEN);
+    getProfile().TPSTART(QUDA_PROFILE_CHRONO);
+
+    EigenSolver::rotate(x, p, psi, false);
+
+    getProfile().TPSTOP(QUDA_PROFILE_CHRONO);
+  }
+
+  void recycleAugment(std::vector<ColorSpinorField> &p, std::vector<ColorSpinorField> &q,
+                      cvector_ref<const ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b, int max_dim,
+                      double tol)
+  {
+    getProfile().TPSTART(QUDA_PROFILE_CHRONO);
+
+    for (auto i = 0u; i < x.size(); i++) {
+      ColorSpinorField p_new(x[i]);
+      ColorSpinorField q_new(b[i]);
+      double x2 = blas::norm2(p_new);
+      if (x2 == 0.0) continue;
+
+      // classical Gram-Schmidt with re-orthogonalization, applying
+      // the same transformation to the operator images
+      for (int pass = 0; pass < 2 && p.size() > 0; pass++) {
+        MatrixXcd c = EigenSolver::gram(p, p_new);
+        EigenSolver::rotate(p_new, p, -c, true);
+        EigenSolver::rotate(q_new, q, -c, true);
+      }
+
+      // directions that are already spanned to within the solver
+      // tolerance add nothing to the projection
+      double p2 = blas::norm2(p_new);
+      if (p2 < tol * tol * x2) {
+        logQuda(QUDA_VERBOSE, "Solution %u is linearly dependent on the recycled basis\n", i);
+        continue;
+      }
+      blas::ax(1.0 / sqrt(p2), p_new);
+      blas::ax(1.0 / sqrt(p2), q_new);
+
+      // the basis is orthonormal, so evicting the oldest entry leaves it orthonormal
+      if ((int)p.size() >= max_dim) {
+        p.erase(p.begin());
+        q.erase(q.begin());
+      }
+      p.push_back(std::move(p_new));
+      q.push_back(std::move(q_new));
+    }
+
+    getProfile().TPSTOP(QUDA_PROFILE_CHRONO);
+  }
+
 } // namespace quda
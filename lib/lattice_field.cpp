@@ -333,6 +333,43 @@ namespace quda {
     initGhostFaceBuffer = false;
   }
 
+  void LatticeField::swapGhostBuffer(GhostState &state)
+  {
+    GhostState present = {ghost_send_buffer_d,
+                          ghost_recv_buffer_d,
+                          ghost_pinned_send_buffer_h,
+                          ghost_pinned_recv_buffer_h,
+                          ghost_pinned_send_buffer_hd,
+                          ghost_pinned_recv_buffer_hd,
+                          ghost_remote_send_buffer_d,
+                          ghostFaceBytes,
+                          initGhostFaceBuffer,
+                          mh_recv_p2p,
+                          mh_send_p2p,
+                          ipcCopyEvent,
+                          ipcRemoteCopyEvent,
+                          initIPCComms,
+                          ghost_field_reset};
+
+    ghost_send_buffer_d = state.send_d;
+    ghost_recv_buffer_d = state.recv_d;
+    ghost_pinned_send_buffer_h = state.pinned_send_h;
+    ghost_pinned_recv_buffer_h = state.pinned_recv_h;
+    ghost_pinned_send_buffer_hd = state.pinned_send_hd;
+    ghost_pinned_recv_buffer_hd = state.pinned_recv_hd;
+    ghost_remote_send_buffer_d = state.remote_send_d;
+    ghostFaceBytes = state.bytes;
+    initGhostFaceBuffer = state.init_ghost;
+    mh_recv_p2p = state.mh_recv;
+    mh_send_p2p = state.mh_send;
+    ipcCopyEvent = state.copy_event;
+    ipcRemoteCopyEvent = state.remote_copy_event;
+    initIPCComms = state.init_ipc;
+    ghost_field_reset = state.reset;
+
+    state = present;
+  }
+
   void LatticeField::createComms(bool no_comms_fill) const
   {
     destroyComms(); // if we are requesting a new number of faces destroy and start over
@@ -0,0 +1,225 @@
+#include <cstring>
+#include <mg_checkpoint.h>
+#include <multigrid.h>
+
+namespace quda
+{
+
+  static constexpr char mg_checkpoint_magic[8] = {'Q', 'U', 'D', 'A', 'M', 'G', 'C', 'P'};
+  static constexpr int mg_checkpoint_version = 1;
+
+  MGCheckpoint::MGCheckpoint(const std::string &prefix, int level, bool write) :
+    filename(prefix + "_level_" + std::to_string(level) + ".rank" + std::to_string(comm_rank())), write(write)
+  {
+    if (prefix.empty()) errorQuda("No checkpoint filename prefix defined");
+    fp = fopen(filename.c_str(), write ? "wb" : "rb");
+    if (!fp && write) errorQuda("Unable to open checkpoint file %s for writing", filename.c_str());
+  }
+
+  MGCheckpoint::~MGCheckpoint()
+  {
+    if (fp) fclose(fp);
+  }
+
+  void MGCheckpoint::write_bytes(const void *data, size_t bytes)
+  {
+    if (!write) errorQuda("Checkpoint %s not opened for writing", filename.c_str());
+    if (fwrite(data, 1, bytes, fp) != bytes) errorQuda("Unable to write %lu bytes to %s", bytes, filename.c_str());
+  }
+
+  void MGCheckpoint::read_bytes(void *data, size_t bytes)
+  {
+    if (write) errorQuda("Checkpoint %s not opened for reading", filename.c_str());
+    if (!fp) errorQuda("Checkpoint %s is not open", filename.c_str());
+    if (fread(data, 1, bytes, fp) != bytes) errorQuda("Unable to read %lu bytes from %s", bytes, filename.c_str());
+  }
+
+  static MGCheckpointHeader make_header(const MGParam &param)
+  {
+    MGCheckpointHeader header = {};
+    memcpy(header.magic, mg_checkpoint_magic, sizeof(header.magic));
+    header.version = mg_checkpoint_version;
+    header.level = param.level;
+    header.n_level = param.Nlevel;
+    header.rank = comm_rank();
+    for (int d = 0; d < 4; d++) {
+      header.comm_dim[d] = comm_dim(d);
+      header.X[d] = param.B[0].X(d);
+    }
+    header.gauge_checksum = param.gauge_checksum;
+    header.param_key = mgCheckpointKey(param);
+    return header;
+  }
+
+  void MGCheckpoint::save_header(const MGParam &param)
+  {
+    auto header = make_header(param);
+    write_bytes(&header, sizeof(header));
+  }
+
+  bool MGCheckpoint::load_header(const MGParam &param)
+  {
+    if (!fp) {
+      warningQuda("Unable to open checkpoint file %s", filename.c_str());
+      return false;
+    }
+
+    MGCheckpointHeader header;
+    read_bytes(&header, sizeof(header));
+    auto expected = make_header(param);
+
+    if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version) {
+      warningQuda("%s is not a version %d multigrid checkpoint", filename.c_str(), expected.version);
+      return false;
+    }
+
+    if (header.level != expected.level || header.n_level != expected.n_level || header.rank != expected.rank) {
+      warningQuda("Checkpoint %s level %d / %d rank %d does not match expected level %d / %d rank %d",
+                  filename.c_str(), header.level, header.n_level, header.rank, expected.level, expected.n_level,
+                  expected.rank);
+      return false;
+    }
+
+    for (int d = 0; d < 4; d++) {
+      if (header.comm_dim[d] != expected.comm_dim[d] || header.X[d] != expected.X[d]) {
+        warningQuda("Checkpoint %s geometry does not match present lattice", filename.c_str());
+        return false;
+      }
+    }
+
+    if (header.gauge_checksum != expected.gauge_checksum) {
+      warningQuda("Checkpoint %s gauge checksum %lx does not match present gauge field %lx", filename.c_str(),
+                  header.gauge_checksum, expected.gauge_checksum);
+      return false;
+    }
+
+    if (header.param_key != expected.param_key) {
+      warningQuda("Checkpoint %s parameter hash %lx does not match present parameters %lx", filename.c_str(),
+                  header.param_key, expected.param_key);
+      return false;
+    }
+
+    return true;
+  }
+
+  void MGCheckpoint::save(const ColorSpinorField &v)
+  {
+    ColorSpinorParam param(v);
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.setPrecision(std::max(v.Precision(), QUDA_SINGLE_PRECISION));
+    param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    ColorSpinorField tmp(param);
+    tmp.copy(v);
+
+    MGCheckpointRecord record = {tmp.Precision(), tmp.Bytes()};
+    write_bytes(&record, sizeof(record));
+    write_bytes(tmp.data(), tmp.Bytes());
+  }
+
+  void MGCheckpoint::load(ColorSpinorField &v)
+  {
+    ColorSpinorParam param(v);
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.setPrecision(std::max(v.Precision(), QUDA_SINGLE_PRECISION));
+    param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    ColorSpinorField tmp(param);
+
+    MGCheckpointRecord record;
+    read_bytes(&record, sizeof(record));
+    if (record.precision != tmp.Precision() || record.bytes != tmp.Bytes())
+      errorQuda("Checkpoint %s record (precision = %d, bytes = %lu) does not match expected (precision = %d, bytes = %lu)",
+                filename.c_str(), record.precision, record.bytes, tmp.Precision(), tmp.Bytes());
+    read_bytes(tmp.data(), tmp.Bytes());
+
+    v.copy(tmp);
+  }
+
+  /**
+     @brief Return the parameters for a host copy of a gauge field
+     that we use for I/O: MILC order, since this is a single
+     contiguous allocation, and no halo region
+   */
+  static GaugeFieldParam host_param(const GaugeField &u)
+  {
+    GaugeFieldParam param(u);
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.setPrecision(std::max(u.Precision(), QUDA_SINGLE_PRECISION));
+    param.order = QUDA_MILC_GAUGE_ORDER;
+    param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+    param.pad = 0;
+    param.mem_type = QUDA_MEMORY_DEVICE;
+    return param;
+  }
+
+  void MGCheckpoint::save(const GaugeField &u)
+  {
+    GaugeField tmp(host_param(u));
+    tmp.copy(u);
+
+    MGCheckpointRecord record = {tmp.Precision(), tmp.Bytes()};
+    write_bytes(&record, sizeof(record));
+    write_bytes(tmp.data(), tmp.Bytes());
+  }
+
+  void MGCheckpoint::load(GaugeField &u)
+  {
+    GaugeField tmp(host_param(u));
+
+    MGCheckpointRecord record;
+    read_bytes(&record, sizeof(record));
+    if (record.precision != tmp.Precision() || record.bytes != tmp.Bytes())
+      errorQuda("Checkpoint %s record (precision = %d, bytes = %lu) does not match expected (precision = %d, bytes = %lu)",
+                filename.c_str(), record.precision, record.bytes, tmp.Precision(), tmp.Bytes());
+    read_bytes(tmp.data(), tmp.Bytes());
+
+    // fixed-point fields require the scale to be set prior to the copy
+    if (u.Precision() < QUDA_SINGLE_PRECISION) u.Scale(tmp.abs_max());
+    u.copy(tmp);
+  }
+
+  /**
+     @brief Simple FNV-1a hash that we use to fingerprint the parameters
+   */
+  struct fnv1a {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    template <typename T> fnv1a &operator<<(const T &value)
+    {
+      static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "fnv1a only supports arithmetic or enum types");
+      auto bytes = reinterpret_cast<const unsigned char *>(&value);
+      for (size_t i = 0; i < sizeof(T); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+      }
+      return *this;
+    }
+  };
+
+  uint64_t mgCheckpointKey(const MGParam &param)
+  {
+    const QudaMultigridParam &mg = param.mg_global;
+    const QudaInvertParam &inv = *mg.invert_param;
+
+    fnv1a hash;
+    // fine operator parameters
+    hash << inv.dslash_type << inv.kappa << inv.mass << inv.mu << inv.epsilon << inv.clover_csw << inv.clover_coeff
+         << inv.matpc_type << inv.cuda_prec_sloppy << inv.cuda_prec_precondition << inv.laplace3D
+         << mg.staggered_kd_dagger_approximation;
+
+    // coarsening parameters for all levels up to and including this one
+    hash << mg.n_level;
+    for (int l = 0; l <= param.level; l++) {
+      hash << mg.n_vec[l] << mg.spin_block_size[l] << mg.precision_null[l] << mg.transfer_type[l]
+           << mg.coarse_grid_solution_type[l] << mg.smoother_solve_type[l] << mg.mu_factor[l] << mg.n_block_ortho[l]
+           << mg.block_ortho_two_pass[l] << mg.fit_aggregate_offset[l] << mg.setup_location[l];
+      for (int d = 0; d < 4; d++) hash << mg.geo_block_size[l][d];
+    }
+    // the coarse operator on this level depends on the next level's mu factor and smoother solve type
+    if (param.level + 1 < mg.n_level) hash << mg.mu_factor[param.level + 1] << mg.smoother_solve_type[param.level + 1];
+
+    return hash.hash;
+  }
+
+} // namespace quda
@@ -0,0 +1,282 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mg_tune.h>
+#include <tune_quda.h>
+#include <comm_quda.h>
+#include "externals/json.hpp"
+
+using json = nlohmann::json;
+
+namespace quda
+{
+
+  // the null-space vector counts that have been compiled
+  static constexpr int mg_nvec_list[] = {@QUDA_MULTIGRID_NVEC_LIST@};
+
+  static bool nvec_compiled(int n_vec)
+  {
+    for (auto n : mg_nvec_list)
+      if (n == n_vec) return true;
+    return false;
+  }
+
+  double MGTuneResult::cost(int n_solve) const
+  {
+    return converged ? setup_secs + n_solve * solve_secs : std::numeric_limits<double>::infinity();
+  }
+
+  std::string mgTuneKey(const QudaMultigridParam &mg_param, const QudaInvertParam &param, const lat_dim_t &X,
+                        double plaquette)
+  {
+    char key[512];
+    snprintf(key, sizeof(key),
+             "dslash=%d,X=%dx%dx%dx%d,grid=%dx%dx%dx%d,kappa=%.6g,mass=%.6g,mu=%.6g,csw=%.6g,plaq=%.3f,prec=%d,%d,%d,"
+             "n_level=%d",
+             param.dslash_type, X[0] * comm_dim(0), X[1] * comm_dim(1), X[2] * comm_dim(2), X[3] * comm_dim(3),
+             comm_dim(0), comm_dim(1), comm_dim(2), comm_dim(3), param.kappa, param.mass, param.mu, param.clover_csw,
+             plaquette, param.cuda_prec, param.cuda_prec_sloppy, param.cuda_prec_precondition, mg_param.n_level);
+    std::string str(key);
+
+    // the smoother and coarse solver are not tuned, but the tuned parameters depend on them
+    for (int l = 0; l < mg_param.n_level; l++) {
+      snprintf(key, sizeof(key), ",level%d=smoother:%d,%d,%d,%.3g,coarse:%d,%.3g,%d,cycle:%d", l, mg_param.smoother[l],
+               mg_param.smoother_solve_type[l], mg_param.smoother_schwarz_type[l], mg_param.smoother_tol[l],
+               mg_param.coarse_solver[l], mg_param.coarse_solver_tol[l], mg_param.coarse_solver_maxiter[l],
+               mg_param.cycle_type[l]);
+      str += key;
+    }
+    return str;
+  }
+
+  /**
+     @brief Whether the hierarchy described by mg_param can be
+     instantiated on the local lattice X: each block size must divide
+     the lattice into an even number of blocks, and the number of
+     null-space vectors must be compiled, no larger than the aggregate
+     size and non-decreasing from level to level.
+   */
+  static bool mg_tune_valid(const QudaMultigridParam &mg_param, const lat_dim_t &X)
+  {
+    auto x = X;
+    int n_color = 3;
+    for (int l = 0; l < mg_param.n_level - 1; l++) {
+      int aggregate_size = n_color;
+      for (int d = 0; d < 4; d++) {
+        int bs = mg_param.geo_block_size[l][d];
+        if (bs < 1 || x[d] % bs != 0 || (x[d] / bs) % 2 != 0) return false;
+        x[d] /= bs;
+        aggregate_size *= bs;
+      }
+      aggregate_size = mg_param.spin_block_size[l] == 0 ? aggregate_size / 2 : aggregate_size * mg_param.spin_block_size[l];
+
+      int n_vec = mg_param.n_vec[l];
+      if (mg_param.transfer_type[l] == QUDA_TRANSFER_AGGREGATE) {
+        if (n_vec > aggregate_size || !nvec_compiled(n_vec)) return false;
+        if (l > 0 && n_vec < n_color) return false;
+      }
+      if (mg_param.n_vec_batch[l] > 0 && n_vec % mg_param.n_vec_batch[l] != 0) return false;
+      n_color = n_vec;
+    }
+    return true;
+  }
+
+  std::vector<QudaMultigridParam> mgTuneCandidates(const QudaMultigridParam &mg_param, int level, MGTuneKnob knob,
+                                                   const lat_dim_t &X)
+  {
+    std::vector<QudaMultigridParam> candidates;
+    auto add = [&](const QudaMultigridParam &candidate) {
+      if (mg_tune_valid(candidate, X)) candidates.push_back(candidate);
+    };
+
+    // the coarse space is fixed for the staggered KD transfers, and when the null-space vectors are loaded
+    bool fixed_space
+      = mg_param.transfer_type[level] != QUDA_TRANSFER_AGGREGATE || mg_param.vec_load[level] == QUDA_BOOLEAN_TRUE;
+
+    switch (knob) {
+    case MGTuneKnob::geo_block_size: {
+      if (fixed_space) break;
+      // the spatial and temporal block sizes are scaled separately
+      const int dims[2][2] = {{0, 3}, {3, 4}};
+      for (auto &dim : dims) {
+        for (bool grow : {true, false}) {
+          auto candidate = mg_param;
+          for (int d = dim[0]; d < dim[1]; d++) {
+            int &bs = candidate.geo_block_size[level][d];
+            bs = grow ? 2 * bs : bs / 2;
+          }
+          add(candidate);
+        }
+      }
+      break;
+    }
+    case MGTuneKnob::n_vec: {
+      if (fixed_space) break;
+      // the adjacent compiled sizes
+      int n_vec = mg_param.n_vec[level];
+      int lower = 0, upper = 0;
+      for (auto n : mg_nvec_list) {
+        if (n < n_vec && n > lower) lower = n;
+        if (n > n_vec && (upper == 0 || n < upper)) upper = n;
+      }
+      for (auto n : {lower, upper}) {
+        if (n == 0) continue;
+        auto candidate = mg_param;
+        candidate.n_vec[level] = n;
+        add(candidate);
+      }
+      break;
+    }
+    case MGTuneKnob::setup_maxiter: {
+      if (fixed_space) break;
+      int maxiter = mg_param.setup_maxiter[level];
+      for (auto n : {maxiter / 2, 2 * maxiter}) {
+        if (n == 0 || n == maxiter) continue;
+        auto candidate = mg_param;
+        candidate.setup_maxiter[level] = n;
+        add(candidate);
+      }
+      break;
+    }
+    case MGTuneKnob::nu_pre:
+    case MGTuneKnob::nu_post: {
+      int nu = knob == MGTuneKnob::nu_pre ? mg_param.nu_pre[level] : mg_param.nu_post[level];
+      for (auto n : {nu / 2, nu == 0 ? 2 : 2 * nu}) {
+        if (n == nu) continue;
+        auto candidate = mg_param;
+        (knob == MGTuneKnob::nu_pre ? candidate.nu_pre[level] : candidate.nu_post[level]) = n;
+        if (candidate.nu_pre[level] + candidate.nu_post[level] > 0) add(candidate);
+      }
+      break;
+    }
+    }
+
+    return candidates;
+  }
+
+  static json mg_tune_to_json(const QudaMultigridParam &mg_param, const MGTuneResult &result)
+  {
+    json levels = json::array();
+    for (int l = 0; l < mg_param.n_level - 1; l++) {
+      levels.push_back({{"geo_block_size", std::vector<int>(mg_param.geo_block_size[l], mg_param.geo_block_size[l] + 4)},
+                        {"n_vec", mg_param.n_vec[l]},
+                        {"setup_maxiter", mg_param.setup_maxiter[l]},
+                        {"nu_pre", mg_param.nu_pre[l]},
+                        {"nu_post", mg_param.nu_post[l]},
+                        {"convergence_factor", result.factor[l]}});
+    }
+
+    return {{"n_level", mg_param.n_level},
+            {"levels", levels},
+            {"setup_secs", result.setup_secs},
+            {"solve_secs", result.solve_secs},
+            {"iter", result.iter}};
+  }
+
+  static bool mg_tune_from_json(const json &j, QudaMultigridParam &mg_param, MGTuneResult &result)
+  {
+    try {
+      auto &levels = j.at("levels");
+      if (j.at("n_level").get<int>() != mg_param.n_level || levels.size() != static_cast<size_t>(mg_param.n_level - 1))
+        return false;
+
+      auto param = mg_param;
+      for (int l = 0; l < mg_param.n_level - 1; l++) {
+        auto &level = levels.at(l);
+        auto geo_block_size = level.at("geo_block_size").get<std::vector<int>>();
+        if (geo_block_size.size() != 4) return false;
+        for (int d = 0; d < 4; d++) param.geo_block_size[l][d] = geo_block_size[d];
+        param.n_vec[l] = level.at("n_vec").get<int>();
+        param.setup_maxiter[l] = level.at("setup_maxiter").get<int>();
+        param.nu_pre[l] = level.at("nu_pre").get<int>();
+        param.nu_post[l] = level.at("nu_post").get<int>();
+        result.factor[l] = level.at("convergence_factor").get<double>();
+      }
+      result.setup_secs = j.at("setup_secs").get<double>();
+      result.solve_secs = j.at("solve_secs").get<double>();
+      result.iter = j.at("iter").get<double>();
+      result.converged = true;
+      mg_param = param;
+    } catch (json::exception &e) {
+      warningQuda("Ignoring malformed multigrid tune cache entry: %s", e.what());
+      return false;
+    }
+    return true;
+  }
+
+  static std::string mg_tune_cache_path()
+  {
+    auto path = get_resource_path();
+    return path.empty() ? path : path + "/mg_tunecache.json";
+  }
+
+  /**
+     @brief Read the tune cache on rank 0 and broadcast it to all
+     other ranks, so that all ranks agree on the tuned parameters
+   */
+  static json mg_tune_cache_read()
+  {
+    std::string path = mg_tune_cache_path();
+    std::string s;
+    if (!path.empty() && comm_rank() == 0) {
+      std::ifstream in(path);
+      if (in) s.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    size_t size = s.size();
+    comm_broadcast(&size, sizeof(size));
+    s.resize(size);
+    if (size > 0) comm_broadcast(&s[0], size);
+    if (s.empty()) return json::object();
+
+    auto j = json::parse(s, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) {
+      warningQuda("Ignoring malformed multigrid tune cache %s", path.c_str());
+      return json::object();
+    }
+    return j;
+  }
+
+  bool mgTuneCacheLoad(const std::string &key, QudaMultigridParam &mg_param, MGTuneResult &result)
+  {
+    auto cache = mg_tune_cache_read();
+    auto entry = cache.find(key);
+    return entry != cache.end() && mg_tune_from_json(*entry, mg_param, result);
+  }
+
+  void mgTuneCacheSave(const std::string &key, const QudaMultigridParam &mg_param, const MGTuneResult &result)
+  {
+    std::string path = mg_tune_cache_path();
+    if (path.empty()) return;
+
+    auto cache = mg_tune_cache_read();
+    cache[key] = mg_tune_to_json(mg_param, result);
+
+    if (comm_rank() == 0) {
+      // write to a temporary file first so a concurrent reader never sees a partial cache
+      std::string tmp_path = path + ".tmp";
+      std::ofstream out(tmp_path);
+      out << cache.dump(2) << std::endl;
+      out.close();
+      if (!out || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        warningQuda("Unable to write multigrid tune cache %s", path.c_str());
+      } else {
+        logQuda(QUDA_SUMMARIZE, "Saved multigrid parameters to %s\n", path.c_str());
+      }
+    }
+  }
+
+  void mgTuneWrite(const std::string &filename, const std::string &key, const QudaMultigridParam &mg_param,
+                   const MGTuneResult &result)
+  {
+    if (comm_rank() != 0) return;
+
+    json j = {{key, mg_tune_to_json(mg_param, result)}};
+    std::ofstream out(filename);
+    out << j.dump(2) << std::endl;
+    if (!out) errorQuda("Unable to write multigrid parameters to %s", filename.c_str());
+    logQuda(QUDA_SUMMARIZE, "Wrote multigrid parameters to %s\n", filename.c_str());
+  }
+
+} // namespace quda
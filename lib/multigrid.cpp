@@ -4,6 +4,8 @@
 #include <tune_quda.h>
 #include <random_quda.h>
 #include <vector_io.h>
+#include <split_grid.h>
+#include <solver.hpp>
 
 // for building the KD inverse op
 #include <staggered_kd_build_xinv.h>
@@ -13,6 +15,77 @@ namespace quda
 
   using namespace blas;
 
+  /**
+     @brief Return the parameters of a field expanded to hold a sub-partition of a split grid
+     @param[in] field The field on the unsplit grid
+     @param[in] split_key The grid of sub-partitions
+  */
+  static ColorSpinorParam agglomerated_param(const ColorSpinorField &field, const CommKey &split_key)
+  {
+    ColorSpinorParam param(field);
+    param.create = QUDA_NULL_FIELD_CREATE;
+    for (int d = 0; d < CommKey::n_dim; d++) param.x[d] *= split_key[d];
+    return param;
+  }
+
+  /**
+     @brief Return the parameters of the host field a coarse vector
+     is staged through when it is split or joined: multigrid fields
+     are split on the host, where the sites are stored contiguously
+     @param[in] field The coarse vector on the unsplit grid
+     @return The parameters of the host staging field
+  */
+  static ColorSpinorParam staging_param(const ColorSpinorField &field)
+  {
+    ColorSpinorParam param(field);
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.setPrecision(std::max(field.Precision(), QUDA_SINGLE_PRECISION));
+    param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    return param;
+  }
+
+  /**
+     @brief Collect a coarse vector set onto each sub-partition of a
+     split grid.  This must be called with the unsplit communicator.
+     The host staging fields are only allocated if they do not already
+     exist, so they may be reused between calls.
+     @param[in,out] collected Host fields holding the collected vectors
+     @param[in,out] host Host fields the unsplit vectors are staged through
+     @param[in] v The vector set on the unsplit grid
+     @param[in] split_key The grid of sub-partitions
+  */
+  static void split_coarse(std::vector<ColorSpinorField> &collected, std::vector<ColorSpinorField> &host,
+                           cvector_ref<const ColorSpinorField> &v, const CommKey &split_key)
+  {
+    resize(host, v.size(), staging_param(v[0]));
+    resize(collected, v.size(), agglomerated_param(host[0], split_key));
+    for (auto i = 0u; i < v.size(); i++) {
+      host[i].copy(v[i]);
+      split_field(collected[i], {host[i]}, split_key);
+    }
+  }
+
+  /**
+     @brief Scatter a coarse vector set collected on a split grid back
+     onto the unsplit grid.  Each sub-partition holds the same
+     solution, so any replica may be kept.  This must be called with
+     the unsplit communicator.
+     @param[out] v The vector set on the unsplit grid
+     @param[in,out] host Host fields the unsplit vectors are staged through
+     @param[in] collected Host fields holding the collected vectors
+     @param[in] split_key The grid of sub-partitions
+  */
+  static void join_coarse(cvector_ref<ColorSpinorField> &v, std::vector<ColorSpinorField> &host,
+                          cvector_ref<const ColorSpinorField> &collected, const CommKey &split_key)
+  {
+    resize(host, v.size(), staging_param(v[0]));
+    for (auto i = 0u; i < v.size(); i++) {
+      join_field({host[i]}, collected[i], split_key);
+      v[i].copy(host[i]);
+    }
+  }
+
   MG::MG(MGParam &param) :
     Solver(*param.matResidual, *param.matSmooth, *param.matSmoothSloppy, *param.matSmoothSloppy, param),
     param(param),
@@ -31,6 +104,38 @@ namespace quda
     if (param.coarse_grid_solution_type == QUDA_MATPC_SOLUTION && param.smoother_solve_type != QUDA_DIRECT_PC_SOLVE)
       errorQuda("Cannot use preconditioned coarse grid solution without preconditioned smoother solve");
 
+    if (param.level == 0) {
+      int n_agglomerate = 0;
+      for (int i = 0; i < param.Nlevel; i++) {
+        auto &grid = param.mg_global.agglomerate_grid[i];
+        if (!(CommKey {grid[0], grid[1], grid[2], grid[3]} == default_comm_key)) {
+          if (i == 0) errorQuda("The fine grid cannot be agglomerated");
+          n_agglomerate++;
+        }
+      }
+      if (n_agglomerate > 1) errorQuda("At most one level can be agglomerated (requested %d)", n_agglomerate);
+    }
+
+    // the next coarser level may be agglomerated onto a split grid
+    if (param.level < param.Nlevel - 1) {
+      auto &grid = param.mg_global.agglomerate_grid[param.level + 1];
+      agglomerate_key = {grid[0], grid[1], grid[2], grid[3]};
+      if (agglomerated()) {
+        if (!agglomerate_key.is_valid())
+          errorQuda("Agglomeration grid (%d,%d,%d,%d) is not valid", agglomerate_key[0], agglomerate_key[1],
+                    agglomerate_key[2], agglomerate_key[3]);
+        for (int d = 0; d < CommKey::n_dim; d++)
+          if (comm_dim(d) % agglomerate_key[d] != 0)
+            errorQuda("Agglomeration not possible: %d %% %d != 0", comm_dim(d), agglomerate_key[d]);
+        if (param.transfer_type != QUDA_TRANSFER_AGGREGATE)
+          errorQuda("Agglomeration requires an aggregation transfer operator on level %d", param.level);
+        if (param.mg_global.location[param.level + 1] != QUDA_CUDA_FIELD_LOCATION)
+          errorQuda("Agglomeration requires level %d to be located on the device", param.level + 1);
+      }
+    }
+
+    param.mg_global.cycle_adaptive_skipped[param.level] = 0;
+
     // allocating vectors
     {
       // create residual vectors
@@ -49,7 +154,27 @@ namespace quda
 
     rng = new RNG(param.B[0], 1234);
 
-    if (param.transfer_type == QUDA_TRANSFER_AGGREGATE) {
+    // restore this level from a checkpoint if one is provided that matches the present gauge field and parameters
+    if (param.transfer_type == QUDA_TRANSFER_AGGREGATE && param.level < param.Nlevel - 1
+        && strcmp(param.mg_global.checkpoint_infile, "") != 0) {
+      if (!param.checkpoint_restore) {
+        logQuda(QUDA_SUMMARIZE, "Not restoring level %d from checkpoint since a finer level was rebuilt\n", param.level);
+      } else {
+        getProfile().TPSTART(QUDA_PROFILE_IO);
+        checkpoint = new MGCheckpoint(param.mg_global.checkpoint_infile, param.level, false);
+        if (checkpoint->load_header(param)) {
+          logQuda(QUDA_SUMMARIZE, "Restoring from checkpoint %s\n", checkpoint->Filename().c_str());
+          for (int i = 0; i < param.Nvec; i++) checkpoint->load(param.B[i]);
+        } else {
+          warningQuda("Unable to restore level %d from checkpoint, running setup", param.level);
+          delete checkpoint;
+          checkpoint = nullptr;
+        }
+        getProfile().TPSTOP(QUDA_PROFILE_IO);
+      }
+    }
+
+    if (param.transfer_type == QUDA_TRANSFER_AGGREGATE && !checkpoint) {
       if (param.level < param.Nlevel - 1) {
         if (param.mg_global.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_YES) {
           if (param.mg_global.generate_all_levels == QUDA_BOOLEAN_TRUE || param.level == 0) {
@@ -85,10 +210,23 @@ namespace quda
     // in case of iterative setup with MG the coarse level may be already built
     if (!transfer) reset();
 
+    // the checkpoint is only used during construction
+    if (checkpoint) {
+      delete checkpoint;
+      checkpoint = nullptr;
+    }
+
     popLevel();
   }
 
   void MG::reset(bool refresh) {
+    // an incremental refresh only rebuilds the levels that have degraded
+    if (refresh && transfer && param.mg_global.setup_refresh_incremental == QUDA_BOOLEAN_TRUE
+        && param.transfer_type == QUDA_TRANSFER_AGGREGATE) {
+      refreshIncremental();
+      return;
+    }
+
     pushLevel(param.level);
 
     logQuda(QUDA_VERBOSE, "%s level %d\n", transfer ? "Resetting" : "Creating", param.level);
@@ -125,7 +263,8 @@ namespace quda
         logQuda(QUDA_VERBOSE, "Creating transfer operator\n");
         transfer = new Transfer(param.B, param.Nvec, param.NblockOrtho, param.blockOrthoTwoPass, param.geoBlockSize,
                                 param.spinBlockSize, param.mg_global.precision_null[param.level],
-                                param.mg_global.transfer_type[param.level]);
+                                param.mg_global.transfer_type[param.level], checkpoint,
+                                param.mg_global.fit_aggregate_offset[param.level] == QUDA_BOOLEAN_TRUE);
         for (int i = 0; i < QUDA_MAX_MG_LEVEL; i++)
           param.mg_global.geo_block_size[param.level][i] = param.geoBlockSize[i];
 
@@ -160,6 +299,9 @@ namespace quda
             transfer->R(B_coarse[i], param.B[i]);
           }
         }
+
+        if (agglomerated()) createAgglomeratedVectors();
+
         logQuda(QUDA_VERBOSE, "Transfer operator done\n");
       }
 
@@ -175,6 +317,7 @@ namespace quda
 
     if (param.level < param.Nlevel-1) {
       // creating or resetting the coarse level temporaries and solvers
+      pushCoarseCommunicator();
       if (coarse) {
         coarse->param.updateInvertParam(*param.mg_global.invert_param);
         coarse->param.delta = 1e-20;
@@ -185,18 +328,27 @@ namespace quda
         coarse->reset(refresh);
       } else {
         // create the next multigrid level
-        param_coarse
-          = new MGParam(param, B_coarse, matCoarseResidual, matCoarseSmoother, matCoarseSmootherSloppy, param.level + 1);
+        param_coarse = new MGParam(param, agglomerated() ? B_agglomerate : B_coarse, matCoarseResidual,
+                                   matCoarseSmoother, matCoarseSmootherSloppy, param.level + 1);
         param_coarse->fine = this;
         param_coarse->delta = 1e-20;
         param_coarse->precision = param.mg_global.invert_param->cuda_prec_precondition;
+        // the coarse level can only be restored if this level was: the staggered KD transfer is never
+        // checkpointed but is rebuilt identically, while any level rebuilt by the setup changes the coarse space
+        param_coarse->checkpoint_restore
+          = param.checkpoint_restore && (checkpoint || param.transfer_type != QUDA_TRANSFER_AGGREGATE);
 
         coarse = new MG(*param_coarse);
       }
+      popCoarseCommunicator();
       setOutputPrefix(prefix); // restore since we just popped back from coarse grid
 
       createCoarseSolver();
 
+      // record the quality of this level for subsequent incremental refreshes
+      if (param.mg_global.setup_refresh_incremental == QUDA_BOOLEAN_TRUE)
+        convergence_factor = probeConvergenceFactor(refresh_n_probe);
+
       // If enabled, verify the coarse links and fine solvers were correctly built
       if (param.mg_global.run_verify) verify();
     }
@@ -212,6 +364,159 @@ namespace quda
     popLevel();
   }
 
+  void MG::refreshIncremental()
+  {
+    pushLevel(param.level);
+
+    logQuda(QUDA_VERBOSE, "Incrementally refreshing level %d\n", param.level);
+
+    // the smoother is always rebuilt since the fine operator has changed
+    destroySmoother();
+
+    // reset the Dirac operator pointers since these may have changed
+    diracResidual = param.matResidual->Expose();
+    diracSmoother = param.matSmooth->Expose();
+    diracSmootherSloppy = param.matSmoothSloppy->Expose();
+
+    createSmoother();
+
+    if (param.level < param.Nlevel - 1) {
+      // a change in the operator parameters always requires a rebuild
+      bool preconditioned_coarsen
+        = (param.coarse_grid_solution_type == QUDA_MATPC_SOLUTION && param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE);
+      const Dirac *dirac = preconditioned_coarsen ? diracSmoother : diracResidual;
+      bool changed = dirac->Mass() != diracCoarseResidual->Mass() || dirac->Mu() != diracCoarseResidual->Mu()
+        || (param.B[0].Nspin() != 1 && dirac->Kappa() != diracCoarseResidual->Kappa());
+
+      double factor = changed ? 0.0 : probeConvergenceFactor(refresh_n_probe);
+      double threshold = (1.0 + param.mg_global.setup_refresh_tol[param.level]) * convergence_factor;
+
+      bool rebuild = changed || factor > threshold;
+      param.mg_global.setup_refresh_rebuilt[param.level] = rebuild ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+      // the coarser levels are only revisited on a rebuild
+      if (!rebuild)
+        for (int l = param.level + 1; l < param.Nlevel; l++) param.mg_global.setup_refresh_rebuilt[l] = QUDA_BOOLEAN_FALSE;
+
+      if (rebuild) {
+        if (changed) {
+          logQuda(QUDA_SUMMARIZE, "Operator parameters have changed, rebuilding level\n");
+        } else {
+          logQuda(QUDA_SUMMARIZE, "Convergence factor %e exceeds %e, rebuilding level\n", factor, threshold);
+        }
+
+        destroySmoother();
+        destroyCoarseSolver();
+
+        if (param.mg_global.setup_maxiter_refresh[param.level]) generateNullVectors(param.B, true);
+
+        transfer->setSiteSubset(QUDA_FULL_SITE_SUBSET, QUDA_INVALID_PARITY);
+        transfer->reset();
+        resetTransfer = false;
+
+        // an agglomerated coarse operator is a copy, so it cannot be rebuilt in place
+        createCoarseDirac(!agglomerated());
+        createSmoother();
+
+        // the coarse operator has changed so the next level must be checked in turn
+        pushCoarseCommunicator();
+        coarse->param.updateInvertParam(*param.mg_global.invert_param);
+        coarse->param.delta = 1e-20;
+        coarse->param.precision = param.mg_global.invert_param->cuda_prec_precondition;
+        coarse->param.matResidual = matCoarseResidual;
+        coarse->param.matSmooth = matCoarseSmoother;
+        coarse->param.matSmoothSloppy = matCoarseSmootherSloppy;
+        if (agglomerated())
+          coarse->reset(true);
+        else
+          coarse->refreshIncremental();
+        popCoarseCommunicator();
+        setOutputPrefix(prefix); // restore since we just popped back from coarse grid
+
+        createCoarseSolver();
+
+        convergence_factor = probeConvergenceFactor(refresh_n_probe);
+
+        if (param.mg_global.run_verify) verify();
+      } else {
+        logQuda(QUDA_SUMMARIZE, "Convergence factor %e within %e, reusing level\n", factor, threshold);
+      }
+    }
+
+    popLevel();
+  }
+
+  double MG::probeConvergenceFactor(int n_probe)
+  {
+    pushLevel(param.level);
+
+    ColorSpinorParam csParam(r[0]);
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    ColorSpinorField e(csParam), b(csParam), x(csParam);
+
+    double factor = 0.0;
+    for (int i = 0; i < n_probe; i++) {
+      spinorNoise(e, *rng, QUDA_NOISE_UNIFORM);
+      (*param.matResidual)(b, e);
+      (*this)(x, b);
+      factor = std::max(factor, sqrt(xmyNorm(e, x) / norm2(e)));
+    }
+
+    logQuda(QUDA_VERBOSE, "Probed convergence factor %e\n", factor);
+
+    popLevel();
+    return factor;
+  }
+
+  void MG::probeConvergenceFactors(double *factor, int n_probe)
+  {
+    factor[param.level] = probeConvergenceFactor(n_probe);
+
+    if (param.level < param.Nlevel - 2) {
+      pushCoarseCommunicator();
+      coarse->probeConvergenceFactors(factor, n_probe);
+      popCoarseCommunicator();
+      setOutputPrefix(prefix); // restore since we just popped back from coarse grid
+    }
+  }
+
+  void MG::pushCoarseCommunicator(bool retain) const
+  {
+    if (!agglomerated()) return;
+    push_communicator(agglomerate_key, retain);
+    // an ordinary switch has freed the state of this level, leaving nothing to retain
+    LatticeField::swapGhostBuffer(comm_ghost);
+    FieldTmp<ColorSpinorField>::swap(comm_tmp);
+  }
+
+  void MG::popCoarseCommunicator(bool retain) const
+  {
+    if (!agglomerated()) return;
+    push_communicator(default_comm_key, retain);
+    LatticeField::swapGhostBuffer(comm_ghost);
+    FieldTmp<ColorSpinorField>::swap(comm_tmp);
+  }
+
+  void MG::createAgglomeratedVectors()
+  {
+    logQuda(QUDA_VERBOSE, "Agglomerating level %d onto a (%d,%d,%d,%d) grid of sub-partitions\n", param.level + 1,
+            agglomerate_key[0], agglomerate_key[1], agglomerate_key[2], agglomerate_key[3]);
+
+    // only the restricted null-space vectors need to be redistributed
+    bool restricted = param.mg_global.generate_all_levels == QUDA_BOOLEAN_FALSE;
+    std::vector<ColorSpinorField> B_collected, B_host;
+    if (restricted) split_coarse(B_collected, B_host, B_coarse, agglomerate_key);
+
+    pushCoarseCommunicator();
+    B_agglomerate.resize(B_coarse.size());
+    for (auto i = 0u; i < B_coarse.size(); i++) {
+      B_agglomerate[i] = ColorSpinorField(agglomerated_param(B_coarse[i], agglomerate_key));
+      if (restricted) B_agglomerate[i].copy(B_collected[i]);
+    }
+    resize(r_agglomerate, 1, agglomerated_param(r_coarse[0], agglomerate_key));
+    resize(x_agglomerate, 1, agglomerated_param(x_coarse[0], agglomerate_key));
+    popCoarseCommunicator();
+  }
+
   void MG::resetStaggeredKD(GaugeField *gauge_in, GaugeField *fat_gauge_in, GaugeField *long_gauge_in,
                             GaugeField *gauge_sloppy_in, GaugeField *fat_gauge_sloppy_in,
                             GaugeField *long_gauge_sloppy_in, double mass)
@@ -306,7 +611,10 @@ namespace quda
 
     param_presmooth->inv_type = param.smoother;
     param_presmooth->inv_type_precondition = QUDA_INVALID_INVERTER;
-    param_presmooth->residual_type = (param_presmooth->inv_type == QUDA_MR_INVERTER) ? QUDA_INVALID_RESIDUAL : QUDA_L2_RELATIVE_RESIDUAL;
+    param_presmooth->residual_type
+      = (param_presmooth->inv_type == QUDA_MR_INVERTER || param_presmooth->inv_type == QUDA_CHEBYSHEV_INVERTER) ?
+      QUDA_INVALID_RESIDUAL :
+      QUDA_L2_RELATIVE_RESIDUAL;
     param_presmooth->Nsteps = param.mg_global.smoother_schwarz_cycle[param.level];
     param_presmooth->maxiter = (param.level < param.Nlevel-1) ? param.nu_pre : param.nu_pre + param.nu_post;
 
@@ -319,6 +627,29 @@ namespace quda
       param_presmooth->ca_lambda_max = param.mg_global.smoother_solver_ca_lambda_max[param.level];
     }
 
+    if (param_presmooth->inv_type == QUDA_CHEBYSHEV_INVERTER) {
+      param_presmooth->ca_lambda_min = param.mg_global.smoother_solver_ca_lambda_min[param.level];
+      param_presmooth->ca_lambda_max = param.mg_global.smoother_solver_ca_lambda_max[param.level];
+
+      // estimate the upper bound here, so that it is shared by the pre- and post-smoothers; a
+      // non-Hermitian operator is smoothed through the normal equations, so the bound is that of M^dag M
+      if (param_presmooth->ca_lambda_max < param_presmooth->ca_lambda_min) {
+        ColorSpinorParam csParam(r[0]);
+        csParam.create = QUDA_NULL_FIELD_CREATE;
+        csParam.setPrecision(param_presmooth->precision_sloppy, QUDA_INVALID_PRECISION,
+                             csParam.location == QUDA_CUDA_FIELD_LOCATION ? true : false);
+        std::vector<ColorSpinorField> v(3, csParam);
+        spinorNoise(v[0], *rng, QUDA_NOISE_UNIFORM);
+        bool pc = param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE;
+        DiracMdagM mdagm(param.matSmoothSloppy->Expose());
+        const DiracMatrix &op = param.matSmoothSloppy->hermitian() ? *param.matSmoothSloppy : mdagm;
+        double lambda_max = Solver::performPowerIterations(op, pc ? v[0].Even() : v[0], pc ? v[1].Even() : v[1],
+                                                           pc ? v[2].Even() : v[2], 100, 10);
+        param_presmooth->ca_lambda_max = 1.1 * lambda_max;
+        logQuda(QUDA_VERBOSE, "Chebyshev smoother approximate lambda max = 1.1 x %e\n", lambda_max);
+      }
+    }
+
     param_presmooth->tol = param.smoother_tol;
     param_presmooth->global_reduction = param.global_reduction;
 
@@ -355,17 +686,19 @@ namespace quda
     popLevel();
   }
 
-  void MG::createCoarseDirac() {
+  void MG::createCoarseDirac(bool in_place)
+  {
     pushLevel(param.level);
 
-    logQuda(QUDA_VERBOSE, "Creating coarse Dirac operator\n");
+    logQuda(QUDA_VERBOSE, "%s coarse Dirac operator\n", in_place ? "Rebuilding" : "Creating");
+    if (in_place && !diracCoarseResidual) errorQuda("No coarse Dirac operator to rebuild");
 
     // check if we are coarsening the preconditioned system then
     bool preconditioned_coarsen = (param.coarse_grid_solution_type == QUDA_MATPC_SOLUTION && param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE);
     QudaMatPCType matpc_type = param.mg_global.invert_param->matpc_type;
 
     // use even-odd preconditioning for the coarse grid solver
-    if (diracCoarseResidual) delete diracCoarseResidual;
+    if (diracCoarseResidual && !in_place) delete diracCoarseResidual;
     if (diracCoarseSmoother) delete diracCoarseSmoother;
     if (diracCoarseSmootherSloppy) delete diracCoarseSmootherSloppy;
 
@@ -411,11 +744,24 @@ namespace quda
       // level + 1 since this is for the coarse grid
       diracParam.dslash_use_mma = param.mg_global.dslash_use_mma[param.level + 1];
       diracParam.allow_truncation = (param.mg_global.allow_truncation == QUDA_BOOLEAN_TRUE) ? true : false;
+      diracParam.checkpoint = checkpoint; // if set, the coarse operator is restored rather than built
 
-      diracCoarseResidual = new DiracCoarse(diracParam, param.setup_location == QUDA_CUDA_FIELD_LOCATION ? true : false,
-                                            param.mg_global.setup_minimize_memory == QUDA_BOOLEAN_TRUE ? true : false);
+      if (in_place)
+        static_cast<DiracCoarse *>(diracCoarseResidual)->updateCoarseOp(diracParam.dirac);
+      else
+        diracCoarseResidual = new DiracCoarse(diracParam, param.setup_location == QUDA_CUDA_FIELD_LOCATION ? true : false,
+                                              param.mg_global.setup_minimize_memory == QUDA_BOOLEAN_TRUE ? true : false);
+
+      if (agglomerated()) {
+        // redistribute the coarse operator onto the sub-partitions
+        if (in_place) errorQuda("Cannot rebuild an agglomerated coarse operator in place");
+        auto agglomerated_dirac = static_cast<DiracCoarse *>(diracCoarseResidual)->agglomerate(diracParam, agglomerate_key);
+        delete diracCoarseResidual;
+        diracCoarseResidual = agglomerated_dirac;
+      }
 
-      // create smoothing operators
+      // create smoothing operators on the same grid as the coarse operator
+      pushCoarseCommunicator();
       diracParam.dirac = const_cast<Dirac *>(param.matSmooth->Expose());
       diracParam.halo_precision = param.mg_global.smoother_halo_precision[param.level + 1];
 
@@ -436,6 +782,7 @@ namespace quda
         }
         diracCoarseSmootherSloppy = new DiracCoarse(static_cast<DiracCoarse &>(*diracCoarseSmoother), diracParam);
       }
+      popCoarseCommunicator();
     }
 
     if (matCoarseResidual) delete matCoarseResidual;
@@ -551,10 +898,12 @@ namespace quda
 
   void MG::destroyCoarseSolver() {
     pushLevel(param.level);
+    pushCoarseCommunicator();
 
     if (param.cycle_type == QUDA_MG_CYCLE_VCYCLE && param.level < param.Nlevel-2) {
       // nothing to do
-    } else if (param.cycle_type == QUDA_MG_CYCLE_RECURSIVE || param.level == param.Nlevel-2) {
+    } else if (param.cycle_type == QUDA_MG_CYCLE_RECURSIVE || param.cycle_type == QUDA_MG_CYCLE_ADAPTIVE
+               || param.level == param.Nlevel - 2) {
       if (coarse_solver) {
         auto &coarse_solver_inner = reinterpret_cast<PreconditionedSolver *>(coarse_solver)->ExposeSolver();
         // int defl_size = coarse_solver_inner.evecs.size();
@@ -575,6 +924,7 @@ namespace quda
       errorQuda("Multigrid cycle type %d not supported", param.cycle_type);
     }
 
+    popCoarseCommunicator();
     popLevel();
   }
 
@@ -583,11 +933,13 @@ namespace quda
 
     logQuda(QUDA_VERBOSE, "Creating coarse solver wrapper\n");
     destroyCoarseSolver();
+    pushCoarseCommunicator();
     if (param.cycle_type == QUDA_MG_CYCLE_VCYCLE && param.level < param.Nlevel-2) {
       // if coarse solver is not a bottom solver and on the second to bottom level then we can just use the coarse solver as is
       coarse_solver = coarse;
       logQuda(QUDA_VERBOSE, "Assigned coarse solver to coarse MG operator\n");
-    } else if (param.cycle_type == QUDA_MG_CYCLE_RECURSIVE || param.level == param.Nlevel-2) {
+    } else if (param.cycle_type == QUDA_MG_CYCLE_RECURSIVE || param.cycle_type == QUDA_MG_CYCLE_ADAPTIVE
+               || param.level == param.Nlevel - 2) {
 
       param_coarse_solver = new SolverParam(param);
       param_coarse_solver->inv_type = param.mg_global.coarse_solver[param.level + 1];
@@ -702,9 +1054,11 @@ namespace quda
 
         // Run a dummy solve so that the deflation space is constructed and computed if needed during the MG setup,
         // or the eigenvalues are recomputed during transfer.
-        spinorNoise(r_coarse[0], *coarse->rng, QUDA_NOISE_UNIFORM);
+        auto &r_dummy = agglomerated() ? r_agglomerate[0] : r_coarse[0];
+        auto &x_dummy = agglomerated() ? x_agglomerate[0] : x_coarse[0];
+        spinorNoise(r_dummy, *coarse->rng, QUDA_NOISE_UNIFORM);
         param_coarse_solver->maxiter = 1; // do a single iteration on the dummy solve
-        (*coarse_solver)(x_coarse[0], r_coarse[0]);
+        (*coarse_solver)(x_dummy, r_dummy);
         setOutputPrefix(prefix); // restore since we just popped back from coarse grid
         param_coarse_solver->maxiter = param.mg_global.coarse_solver_maxiter[param.level + 1];
       }
@@ -715,6 +1069,7 @@ namespace quda
     }
     logQuda(QUDA_VERBOSE, "Coarse solver wrapper done\n");
 
+    popCoarseCommunicator();
     popLevel();
   }
 
@@ -723,19 +1078,29 @@ namespace quda
     pushLevel(param.level);
 
     if (param.level < param.Nlevel - 1) {
+      pushCoarseCommunicator();
       if (coarse) delete coarse;
-      if (param.level == param.Nlevel-1 || param.cycle_type == QUDA_MG_CYCLE_RECURSIVE) {
+      if (param.level == param.Nlevel - 1 || param.cycle_type == QUDA_MG_CYCLE_RECURSIVE
+          || param.cycle_type == QUDA_MG_CYCLE_ADAPTIVE) {
 	if (coarse_solver) delete coarse_solver;
 	if (param_coarse_solver) delete param_coarse_solver;
       }
-
-      if (transfer) delete transfer;
+      B_agglomerate.clear();
+      r_agglomerate.clear();
+      x_agglomerate.clear();
+      coarse_collected.clear();
+      coarse_host.clear();
+      y_coarse.clear();
       if (matCoarseSmootherSloppy) delete matCoarseSmootherSloppy;
       if (diracCoarseSmootherSloppy) delete diracCoarseSmootherSloppy;
       if (matCoarseSmoother) delete matCoarseSmoother;
       if (diracCoarseSmoother) delete diracCoarseSmoother;
       if (matCoarseResidual) delete matCoarseResidual;
       if (diracCoarseResidual) delete diracCoarseResidual;
+      // an ordinary switch frees the state of the agglomerated grid, so none is retained past destruction
+      popCoarseCommunicator();
+
+      if (transfer) delete transfer;
       if (postsmoother) delete postsmoother;
       if (param_postsmooth) delete param_postsmooth;
     }
@@ -763,6 +1128,18 @@ namespace quda
   {
     pushLevel(param.level);
 
+    if (agglomerated()) {
+      // the coarse operator does not live on this grid, so the transfer identities cannot be checked
+      warningQuda("Skipping verification of level %d since level %d is agglomerated", param.level, param.level + 1);
+      if (recursively && param.level < param.Nlevel - 2) {
+        pushCoarseCommunicator();
+        coarse->verify(true);
+        popCoarseCommunicator();
+      }
+      popLevel();
+      return;
+    }
+
     QudaPrecision prec = (param.mg_global.precision_null[param.level] < r[0].Precision()) ?
       param.mg_global.precision_null[param.level] :
       r[0].Precision();
@@ -1214,8 +1591,28 @@ namespace quda
         // restrict to the coarse grid
         transfer->R(r_coarse, residual);
 
-        // recurse to the next lower level
-        (*coarse_solver)(x_coarse, r_coarse);
+        if (agglomerated()) {
+          // collect onto each sub-partition, solve redundantly there and scatter back; the communication
+          // state of both grids is retained across the switch, so each cycle does not reallocate it.  The
+          // exchange is profiled as communication, to weigh against the time saved on the coarse solve
+          getProfile().TPSTART(QUDA_PROFILE_COMMS);
+          split_coarse(coarse_collected, coarse_host, r_coarse, agglomerate_key);
+          getProfile().TPSTOP(QUDA_PROFILE_COMMS);
+          pushCoarseCommunicator(true);
+          resize(r_agglomerate, r_coarse.size(), QUDA_NULL_FIELD_CREATE);
+          resize(x_agglomerate, r_coarse.size(), QUDA_NULL_FIELD_CREATE);
+          for (auto i = 0u; i < r_coarse.size(); i++) r_agglomerate[i].copy(coarse_collected[i]);
+          coarseCycle(x_agglomerate, r_agglomerate);
+          for (auto i = 0u; i < r_coarse.size(); i++) coarse_collected[i].copy(x_agglomerate[i]);
+          popCoarseCommunicator(true);
+          setOutputPrefix(prefix);
+          getProfile().TPSTART(QUDA_PROFILE_COMMS);
+          join_coarse(x_coarse, coarse_host, coarse_collected, agglomerate_key);
+          getProfile().TPSTOP(QUDA_PROFILE_COMMS);
+        } else {
+          // recurse to the next lower level
+          coarseCycle(x_coarse, r_coarse);
+        }
 
         // prolongate back to this grid
         auto &x_coarse_2_fine = inner_solution_type == QUDA_MAT_SOLUTION ?
@@ -1245,6 +1642,41 @@ namespace quda
     popOutputPrefix();
   }
 
+  void MG::coarseCycle(cvector_ref<ColorSpinorField> &x, cvector_ref<ColorSpinorField> &r)
+  {
+    if (!adaptiveCycle()) {
+      (*coarse_solver)(x, r);
+      return;
+    }
+
+    auto r2 = norm2(r);
+    (*coarse)(x, r);
+    setOutputPrefix(prefix);
+
+    // measure the residual reduction of the V-cycle, with the operator the coarse solver applies to fields of
+    // this site subset, as in createCoarseSolver
+    resize(y_coarse, r.size(), QUDA_NULL_FIELD_CREATE, r[0]);
+    auto &mat = r[0].SiteSubset() == QUDA_PARITY_SITE_SUBSET ? *matCoarseSmoother : *matCoarseResidual;
+    mat(y_coarse, x);
+    auto y2 = xmyNorm(r, y_coarse);
+
+    double rho = 0.0;
+    for (auto i = 0u; i < r.size(); i++)
+      if (r2[i] > 0.0) rho = std::max(rho, sqrt(y2[i] / r2[i]));
+
+    const double threshold = param.mg_global.cycle_adaptive_threshold[param.level];
+    if (rho > threshold) {
+      logQuda(QUDA_DEBUG_VERBOSE, "V-cycle residual reduction %e > %e, applying K-cycle\n", rho, threshold);
+      // solve for the remaining error, repurposing the residual storage
+      (*coarse_solver)(r, y_coarse);
+      setOutputPrefix(prefix);
+      xpy(r, x);
+    } else {
+      logQuda(QUDA_DEBUG_VERBOSE, "V-cycle residual reduction %e <= %e\n", rho, threshold);
+      param.mg_global.cycle_adaptive_skipped[param.level]++;
+    }
+  }
+
   // supports separate reading or single file read
   void MG::loadVectors(cvector_ref<ColorSpinorField> &B)
   {
@@ -1291,7 +1723,36 @@ namespace quda
     } else {
       saveVectors(param.B);
     }
-    if (param.level < param.Nlevel - 2) coarse->dumpNullVectors();
+    if (param.level < param.Nlevel - 2) {
+      if (agglomerated())
+        warningQuda("Cannot dump near-null vectors of agglomerated level %d", param.level + 1);
+      else
+        coarse->dumpNullVectors();
+    }
+  }
+
+  void MG::saveCheckpoint(const std::string &prefix) const
+  {
+    if (param.transfer_type != QUDA_TRANSFER_AGGREGATE) {
+      warningQuda("Cannot checkpoint top level of staggered MG solve, this level will be rebuilt on restore.");
+    } else {
+      getProfile().TPSTART(QUDA_PROFILE_IO);
+      pushLevel(param.level);
+      MGCheckpoint io(prefix, param.level, true);
+      io.save_header(param);
+      for (int i = 0; i < param.Nvec; i++) io.save(param.B[i]);
+      transfer->save(io);
+      static_cast<const DiracCoarse *>(diracCoarseResidual)->save(io);
+      logQuda(QUDA_SUMMARIZE, "Saved checkpoint %s\n", io.Filename().c_str());
+      popLevel();
+      getProfile().TPSTOP(QUDA_PROFILE_IO);
+    }
+    if (param.level < param.Nlevel - 2) {
+      if (agglomerated())
+        warningQuda("Cannot checkpoint agglomerated level %d, it will be rebuilt on restore", param.level + 1);
+      else
+        coarse->saveCheckpoint(prefix);
+    }
   }
 
   void MG::generateNullVectors(std::vector<ColorSpinorField> &B, bool refresh)
@@ -1391,18 +1852,7 @@ namespace quda
               param.mg_global.num_setup_iter[param.level]);
 
       // global orthonormalization of the initial null-space vectors
-      if (param.mg_global.pre_orthonormalize) {
-        for (auto i = 0u; i < B.size(); i++) {
-          for (auto j = 0u; j < i; j++) {
-            Complex alpha = cDotProduct(B[j], B[i]); // <j,i>
-            caxpy(-alpha, B[j], B[i]);               // i-<j,i>j
-          }
-          double nrm2 = norm2(B[i]);
-          if (nrm2 > 1e-16)
-            ax(1.0 / sqrt(nrm2), B[i]); // i/<i,i>
-          else errorQuda("\nCannot normalize %u vector\n", i);
-        }
-      }
+      if (param.mg_global.pre_orthonormalize) blas::block::orthonormalize(B);
 
       // launch solver for each source
       if (B.size() % param.n_vec_batch != 0) errorQuda("Bad batch size %d", param.n_vec_batch);
@@ -1437,18 +1887,7 @@ namespace quda
       }
 
       // global orthonormalization of the generated null-space vectors
-      if (param.mg_global.post_orthonormalize) {
-        for (auto i = 0u; i < B.size(); i++) {
-          for (auto j = 0u; j < i; j++) {
-            Complex alpha = cDotProduct(B[j], B[i]); // <j,i>
-            caxpy(-alpha, B[j], B[i]);               // i-<j,i>j
-          }
-          double nrm2 = norm2(B[i]);
-          if (sqrt(nrm2) > 1e-16)
-            ax(1.0 / sqrt(nrm2), B[i]); // i/<i,i>
-          else errorQuda("\nCannot normalize %u vector (nrm=%e)\n", i, sqrt(nrm2));
-        }
-      }
+      if (param.mg_global.post_orthonormalize) blas::block::orthonormalize(B);
 
       if (solverParam.inv_type == QUDA_MG_INVERTER) {
 
@@ -1457,16 +1896,21 @@ namespace quda
           reset();
           if ( param.level < param.Nlevel-2 ) {
             if ( param.mg_global.generate_all_levels == QUDA_BOOLEAN_TRUE ) {
-              coarse->generateNullVectors(B_coarse, refresh);
+              pushCoarseCommunicator();
+              coarse->generateNullVectors(agglomerated() ? B_agglomerate : B_coarse, refresh);
+              popCoarseCommunicator();
             } else {
               logQuda(QUDA_VERBOSE, "Restricting null space vectors\n");
               for (auto i = 0; i < param.Nvec; i++) {
                 zero(B_coarse[i]);
                 transfer->R(B_coarse[i], param.B[i]);
               }
+              if (agglomerated()) createAgglomeratedVectors();
               // rebuild the transfer operator in the coarse level
+              pushCoarseCommunicator();
               coarse->resetTransfer = true;
               coarse->reset();
+              popCoarseCommunicator();
             }
           }
         } else {
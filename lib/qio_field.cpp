@@ -13,6 +13,15 @@ static QIO_Layout layout;
 static int lattice_size[4];
 int quda_this_node;
 
+// SciDAC checksum of the last record read or written
+static uint32_t last_checksum[2] = {0, 0};
+
+void get_last_qio_checksum(uint32_t checksum[2])
+{
+  checksum[0] = last_checksum[0];
+  checksum[1] = last_checksum[1];
+}
+
 std::ostream &operator<<(std::ostream &out, const QIO_Layout &layout)
 {
   out << "node_number = " << layout.node_number << std::endl;
@@ -194,6 +203,11 @@ int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cp
   QIO_destroy_record_info(rec_info);
   printfQuda("%s: QIO_read_record_data returns status %d\n", __func__, status);
   if (status != QIO_SUCCESS) return 1;
+
+  // QIO has verified the record against the stored checksum, report it
+  last_checksum[0] = QIO_get_reader_last_checksuma(infile);
+  last_checksum[1] = QIO_get_reader_last_checksumb(infile);
+  printfQuda("%s: SciDAC checksum a = %x, b = %x\n", __func__, last_checksum[0], last_checksum[1]);
   return 0;
 }
 
@@ -378,6 +392,10 @@ int write_field(QIO_Writer *outfile, int count, const void *field_out[], QudaPre
   QIO_string_destroy(xml_record_out);
 
   if (status != QIO_SUCCESS) return 1;
+
+  last_checksum[0] = QIO_get_writer_last_checksuma(outfile);
+  last_checksum[1] = QIO_get_writer_last_checksumb(outfile);
+  printfQuda("%s: SciDAC checksum a = %x, b = %x\n", __func__, last_checksum[0], last_checksum[1]);
   return 0;
 }
 
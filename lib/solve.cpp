@@ -18,6 +18,64 @@ namespace quda
       for (auto i = 0; i < QUDA_MAX_CHRONO; i++) chronoResident[i].clear();
   }
 
+  /**
+     @brief Apply the solver to a set of sources.  When
+     param.recycle_max_dim is set, the sources are instead solved in
+     blocks of param.recycle_block_size, with each block seeded by its
+     projection onto a basis of the solutions of the preceding blocks,
+     so that later sources start from a residual with the already
+     resolved (predominantly low-mode) directions removed.
+     @param[in] solve The solver
+     @param[out] x The solution vectors
+     @param[in] b The source vectors
+     @param[in,out] solverParam The solver parameters
+     @param[in,out] param The invert parameters, where the iteration count of each block is returned
+     @param[in] hermitian Whether the operator is Hermitian or not
+   */
+  static void recycleSolve(Solver &solve, cvector_ref<ColorSpinorField> &x, cvector_ref<const ColorSpinorField> &b,
+                           SolverParam &solverParam, QudaInvertParam &param, bool hermitian)
+  {
+    const auto block_size = static_cast<size_t>(param.recycle_block_size);
+    if (param.recycle_max_dim <= 0 || b.size() <= block_size) {
+      solve(x, b);
+      return;
+    }
+
+    std::vector<ColorSpinorField> p;
+    std::vector<ColorSpinorField> q;
+    vector<double> true_res(b.size());
+    vector<double> true_res_hq(b.size());
+    auto use_init_guess = solverParam.use_init_guess;
+
+    for (auto i = 0u; i < b.size(); i += block_size) {
+      auto n = std::min(block_size, b.size() - i);
+      cvector_ref<ColorSpinorField> x_ {x.begin() + i, x.begin() + i + n};
+      cvector_ref<const ColorSpinorField> b_ {b.begin() + i, b.begin() + i + n};
+
+      if (p.size() > 0) {
+        recycleExtrapolate(x_, b_, p, q, hermitian);
+        solverParam.use_init_guess = QUDA_USE_INIT_GUESS_YES;
+      }
+
+      auto iter = solverParam.iter;
+      solve(x_, b_);
+      param.recycle_iter[i / block_size] = solverParam.iter - iter;
+      logQuda(QUDA_SUMMARIZE, "Recycled solve of sources %u-%lu with basis size %lu took %d iterations\n", i,
+              i + n - 1, p.size(), solverParam.iter - iter);
+
+      for (auto j = 0u; j < n; j++) {
+        true_res[i + j] = solverParam.true_res[j];
+        true_res_hq[i + j] = solverParam.true_res_hq[j];
+      }
+
+      if (i + n < b.size()) recycleAugment(p, q, x_, b_, param.recycle_max_dim, param.tol);
+    }
+
+    solverParam.true_res = true_res;
+    solverParam.true_res_hq = true_res_hq;
+    solverParam.use_init_guess = use_init_guess;
+  }
+
   void massRescale(cvector_ref<ColorSpinorField> &b, QudaInvertParam &param, bool for_multishift)
   {
     double kappa5 = (0.5 / (5.0 + param.m5));
@@ -224,7 +282,7 @@ namespace quda
       }
 
       Solver *solve = Solver::create(solverParam, m, mSloppy, mPre, mEig);
-      (*solve)(out, in);
+      recycleSolve(*solve, out, in, solverParam, param, false);
       delete solve;
       solverParam.updateInvertParam(param);
     } else if (!norm_error_solve) {
@@ -242,12 +300,12 @@ namespace quda
       if (param.inv_type_precondition != QUDA_INVALID_INVERTER && param.schwarz_type != QUDA_INVALID_SCHWARZ) {
         DiracMdagMLocal mPreLocal(diracPre);
         Solver *solve = Solver::create(solverParam, m, mSloppy, mPreLocal, mEig);
-        (*solve)(out, in);
+        recycleSolve(*solve, out, in, solverParam, param, true);
         delete solve;
         solverParam.updateInvertParam(param);
       } else {
         Solver *solve = Solver::create(solverParam, m, mSloppy, mPre, mEig);
-        (*solve)(out, in);
+        recycleSolve(*solve, out, in, solverParam, param, true);
         delete solve;
         solverParam.updateInvertParam(param);
       }
@@ -341,6 +399,7 @@ namespace quda
       || (param.solve_type == QUDA_NORMERR_PC_SOLVE);
 
     param.iter = 0;
+    param.adaptive_promotions = 0;
 
     Dirac *dirac = nullptr;
     Dirac *diracSloppy = nullptr;
@@ -91,10 +91,18 @@ namespace quda {
       report("CA-GCR");
       solver = new CAGCR(mat, matSloppy, matPrecon, matEig, param);
       break;
+    case QUDA_BLOCK_CG_INVERTER:
+      report("Block CG");
+      solver = new BlockCG(mat, matSloppy, param);
+      break;
     case QUDA_MR_INVERTER:
       report("MR");
       solver = new MR(mat, matSloppy, param);
       break;
+    case QUDA_CHEBYSHEV_INVERTER:
+      report("Chebyshev");
+      solver = new Chebyshev(mat, matSloppy, param);
+      break;
     case QUDA_SD_INVERTER:
       report("SD");
       solver = new SD(mat, param);
@@ -294,12 +302,36 @@ namespace quda {
 
         // move vectors from preserved space to local space
         evals = std::move(space->evals);
+        bool space_svd = space->svd;
 
         delete space;
         param.eig_param.preserve_deflation_space = nullptr;
 
         // we successfully got the deflation space so disable any subsequent recalculation
         deflate_compute = false;
+
+        if (param.eig_param.deflation_refine == QUDA_BOOLEAN_TRUE) {
+          // the operator may have changed since the space was computed, so refine it in place
+          if (!mat.hermitian()) errorQuda("Deflation space refinement requires a Hermitian operator");
+          if (!param.is_preconditioner) getProfile().TPSTOP(QUDA_PROFILE_INIT);
+          migrateDeflationSpace(QUDA_CUDA_FIELD_LOCATION);
+
+          if (eig_solve->refine(evecs, evals)) {
+            if (space_svd) eig_solve->computeSVD(evecs, evals);
+            recompute_evals = false;
+          } else {
+            // fall back to a full solve from the (partially refined) preserved space, of
+            // which LOBPCG takes the whole block as its initial guess, and the Lanczos and
+            // Arnoldi solvers only the leading block_size vectors
+            logQuda(QUDA_SUMMARIZE, "Recomputing the deflation space\n");
+            resize(evecs, param.eig_param.n_conv, csParam);
+            deflate_compute = true;
+          }
+          if (!param.is_preconditioner) getProfile().TPSTART(QUDA_PROFILE_INIT);
+        }
+
+        if (evecs[0].Location() == QUDA_CPU_FIELD_LOCATION && recompute_evals)
+          errorQuda("Out-of-core deflation space requires preserve_evals");
       } else {
         // Computing the deflation space, rather than transferring, so we create space.
         resize(evecs, param.eig_param.n_conv, csParam);
@@ -330,6 +362,11 @@ namespace quda {
         // if evecs size = 2x evals size then we are doing an SVD deflation
         space->svd = (evecs.size() == 2 * evals.size()) ? true : false;
 
+        if (param.eig_param.deflation_out_of_core == QUDA_BOOLEAN_TRUE) {
+          logQuda(QUDA_VERBOSE, "Migrating deflation space to host memory\n");
+          migrateDeflationSpace(QUDA_CPU_FIELD_LOCATION);
+        }
+
         space->evecs = std::move(evecs);
         space->evals = std::move(evals);
 
@@ -344,6 +381,35 @@ namespace quda {
     getProfile().TPSTOP(QUDA_PROFILE_FREE);
   }
 
+  void Solver::migrateDeflationSpace(QudaFieldLocation location)
+  {
+    std::vector<ColorSpinorField> migrated;
+    migrated.reserve(evecs.size());
+    for (auto &v : evecs) {
+      if (v.Location() == location) {
+        migrated.push_back(std::move(v));
+        continue;
+      }
+      // host vectors use the host field order (host fields are at least single precision), and
+      // device vectors the native order at the eigensolver precision
+      ColorSpinorParam csParam(v);
+      csParam.location = location;
+      csParam.create = QUDA_NULL_FIELD_CREATE;
+      if (location == QUDA_CPU_FIELD_LOCATION) {
+        csParam.mem_type = QUDA_MEMORY_HOST_PINNED;
+        csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+        csParam.setPrecision(std::max(v.Precision(), QUDA_SINGLE_PRECISION));
+      } else {
+        csParam.mem_type = QUDA_MEMORY_DEVICE;
+        csParam.setPrecision(param.precision_eigensolver, QUDA_INVALID_PRECISION, true);
+      }
+      migrated.emplace_back(csParam);
+      migrated.back().copy(v);
+      v = ColorSpinorField();
+    }
+    evecs = std::move(migrated);
+  }
+
   void Solver::injectDeflationSpace(std::vector<ColorSpinorField> &defl_space)
   {
     if (!evecs.empty()) errorQuda("Solver deflation space should be empty, instead size=%lu\n", evecs.size());
@@ -595,6 +661,7 @@ namespace quda {
     for (auto i = 0u; i < true_res.size(); i++) param.true_res[i] = true_res[i];
     for (auto i = 0u; i < true_res_hq.size(); i++) param.true_res_hq[i] = true_res_hq[i];
     param.iter += iter;
+    param.adaptive_promotions += adaptive_promotions;
     if (offset >= 0) {
       param.true_res_offset[offset] = true_res_offset[offset];
       param.iter_res_offset[offset] = iter_res_offset[offset];
@@ -186,7 +186,7 @@ namespace quda {
         yAccessor, xAccessor, yAccessorAtomic, xAccessorAtomic, uvAccessor, avAccessor, vAccessor, gAccessor,
         lAccessor, xinvAccessor, xinvAccessor, xinvAccessor, Y, X, *Yatomic, *Xatomic, *uv, *av, v,
         kappa, mass, mu_dummy, mu_factor_dummy, allow_truncation, dirac, matpc, need_bidirectional, T.fineToCoarse(Y.Location()),
-        T.coarseToFine(Y.Location()));
+        T.coarseToFine(Y.Location()), T.Geo_offset());
     } else {
 
       constexpr QudaFieldOrder csOrder = colorspinor::getNative<vFloat>(fineSpin);
@@ -220,7 +220,7 @@ namespace quda {
         yAccessor, xAccessor, yAccessorAtomic, xAccessorAtomic, uvAccessor, avAccessor, vAccessor, gAccessor,
         lAccessor, xinvAccessor, xinvAccessor, xinvAccessor, Y, X, *Yatomic, *Xatomic, *uv, *av, v,
         kappa, mass, mu_dummy, mu_factor_dummy, allow_truncation, dirac, matpc, need_bidirectional, T.fineToCoarse(Y.Location()),
-        T.coarseToFine(Y.Location()));
+        T.coarseToFine(Y.Location()), T.Geo_offset());
     }
 
     // Clean up
@@ -7,11 +7,13 @@
 #include <multigrid.h>
 #include <tune_quda.h>
 #include <malloc_quda.h>
+#include <mg_checkpoint.h>
 
 #include <iostream>
 #include <algorithm>
 #include <vector>
 #include <limits>
+#include <complex>
 
 namespace quda {
 
@@ -20,7 +22,8 @@ namespace quda {
   * however we do even-odd to preserve chirality (that is straightforward)
   */
   Transfer::Transfer(const std::vector<ColorSpinorField> &B, int Nvec, int n_block_ortho, bool block_ortho_two_pass,
-                     int *geo_bs, int spin_bs, QudaPrecision null_precision, const QudaTransferType transfer_type) :
+                     int *geo_bs, int spin_bs, QudaPrecision null_precision, const QudaTransferType transfer_type,
+                     MGCheckpoint *checkpoint, bool fit_offset) :
     B(B),
     Nvec(Nvec),
     NblockOrtho(n_block_ortho),
@@ -107,14 +110,25 @@ namespace quda {
       coarse_to_fine_d = static_cast<int *>(pool_device_malloc(B[0].Volume() * sizeof(int)));
     }
 
-    createGeoMap(geo_bs);
+    this->fit_offset = fit_offset;
+    if (fit_offset && transfer_type != QUDA_TRANSFER_AGGREGATE)
+      errorQuda("Aggregate offset fitting not supported for transfer type %d", transfer_type);
+
+    // a fitted map is created by reset, unless the prolongator is restored instead
+    if (!fit_offset)
+      createGeoMap(geo_bs);
+    else if (checkpoint)
+      fitGeoMap();
 
     // allocate the fine-to-coarse spin map
     spin_map = static_cast<int**>(safe_malloc(nspin_fine*sizeof(int*)));
     for (int s = 0; s < B[0].Nspin(); s++) spin_map[s] = static_cast<int *>(safe_malloc(2 * sizeof(int)));
     createSpinMap(spin_bs);
 
-    reset();
+    if (checkpoint)
+      load(*checkpoint);
+    else
+      reset();
     postTrace();
   }
 
@@ -214,6 +228,9 @@ namespace quda {
         || transfer_type == QUDA_TRANSFER_OPTIMIZED_KD_DROP_LONG) {
       return;
     }
+    // the aggregates follow the null space as it is refreshed
+    if (fit_offset) fitGeoMap();
+
     logQuda(QUDA_VERBOSE, "Transfer: block orthogonalizing\n");
 
     if (B[0].Location() == QUDA_CUDA_FIELD_LOCATION) {
@@ -235,6 +252,28 @@ namespace quda {
     postTrace();
   }
 
+  void Transfer::save(MGCheckpoint &checkpoint) const
+  {
+    if (transfer_type != QUDA_TRANSFER_AGGREGATE) errorQuda("Cannot checkpoint transfer type %d", transfer_type);
+    checkpoint.save(Vectors());
+  }
+
+  void Transfer::load(MGCheckpoint &checkpoint)
+  {
+    if (transfer_type != QUDA_TRANSFER_AGGREGATE) errorQuda("Cannot restore transfer type %d", transfer_type);
+    logQuda(QUDA_VERBOSE, "Transfer: restoring block-orthogonal vectors from %s\n", checkpoint.Filename().c_str());
+
+    if (B[0].Location() == QUDA_CUDA_FIELD_LOCATION) {
+      if (!enable_gpu) errorQuda("enable_gpu = %d so cannot load", enable_gpu);
+      checkpoint.load(V_d);
+      if (enable_cpu) V_h = V_d;
+    } else {
+      if (!enable_cpu) errorQuda("enable_cpu = %d so cannot load", enable_cpu);
+      checkpoint.load(V_h);
+      if (enable_gpu) V_d = V_h;
+    }
+  }
+
   Transfer::~Transfer() {
     if (spin_map)
     {
@@ -269,6 +308,87 @@ namespace quda {
     }
   };
 
+  void fitAggregateOffset(int offset[4], const std::vector<double> &rho, const int *X, const int *geo_bs)
+  {
+    // the coupling cut by the block boundaries for each candidate
+    // offset, where the boundary between x and x+mu lies on plane x_d+1
+    const int bs_max = *std::max_element(geo_bs, geo_bs + 4);
+    std::vector<double> cost(4 * bs_max, 0.0);
+    for (size_t i = 0; i < rho.size(); i++) {
+      int x[4];
+      for (int d = 0, r = i; d < 4; d++) {
+        x[d] = r % X[d];
+        r /= X[d];
+      }
+      for (int d = 0; d < 4; d++) {
+        if (comm_dim_partitioned(d) || geo_bs[d] == 1) continue;
+        int y[4] = {x[0], x[1], x[2], x[3]};
+        y[d] = (x[d] + 1) % X[d];
+        size_t j = ((static_cast<size_t>(y[3]) * X[2] + y[2]) * X[1] + y[1]) * X[0] + y[0];
+        cost[d * bs_max + (x[d] + 1) % geo_bs[d]] += sqrt(rho[i] * rho[j]);
+      }
+    }
+    comm_allreduce_sum(cost);
+
+    for (int d = 0; d < 4; d++) {
+      offset[d] = 0;
+      if (comm_dim_partitioned(d)) continue;
+      for (int o = 1; o < geo_bs[d]; o++)
+        if (cost[d * bs_max + o] < (1.0 - 1e-6) * cost[d * bs_max + offset[d]]) offset[d] = o;
+    }
+  }
+
+  void Transfer::fitGeoMap()
+  {
+    ColorSpinorParam param(B[0]);
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.setPrecision(QUDA_DOUBLE_PRECISION);
+    param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    ColorSpinorField tmp(param);
+
+    // the null-space density on each site, which is gauge invariant
+    const size_t volume = tmp.Volume();
+    const int site_length = tmp.Nspin() * tmp.Ncolor();
+    std::vector<double> rho(volume, 0.0);
+    int x[QUDA_MAX_DIM] = {};
+    for (int i = 0; i < Nvec; i++) {
+      tmp.copy(B[i]);
+      auto v = tmp.data<const std::complex<double> *>();
+      for (size_t k = 0; k < volume; k++) {
+        tmp.LatticeIndex(x, k);
+        auto &r = rho[((static_cast<size_t>(x[3]) * tmp.X(2) + x[2]) * tmp.X(1) + x[1]) * tmp.X(0) + x[0]];
+        for (int s = 0; s < site_length; s++) r += std::norm(v[k * site_length + s]);
+      }
+    }
+
+    fitAggregateOffset(geo_offset, rho, tmp.X(), geo_bs);
+
+    // the offset can be forced, e.g., to verify the transfer and coarse
+    // operator with shifted aggregates independently of the fit
+    char *offset_env = getenv("QUDA_MG_AGGREGATE_OFFSET");
+    if (offset_env) {
+      int offset[4];
+      if (sscanf(offset_env, "%d %d %d %d", &offset[0], &offset[1], &offset[2], &offset[3]) != 4)
+        errorQuda("QUDA_MG_AGGREGATE_OFFSET=\"%s\" must be four integers", offset_env);
+      for (int d = 0; d < 4; d++) {
+        if (offset[d] < 0 || offset[d] >= geo_bs[d])
+          errorQuda("Aggregate offset %d for dimension %d must be in [0, %d)", offset[d], d, geo_bs[d]);
+        if (comm_dim_partitioned(d) && offset[d] != 0) {
+          warningQuda("Ignoring aggregate offset %d for partitioned dimension %d", offset[d], d);
+          offset[d] = 0;
+        }
+        geo_offset[d] = offset[d];
+      }
+    }
+
+    std::string offset_str = std::to_string(geo_offset[0]);
+    for (int d = 1; d < 4; d++) offset_str += " x " + std::to_string(geo_offset[d]);
+    logQuda(QUDA_VERBOSE, "Transfer: using aggregate offset %s\n", offset_str.c_str());
+
+    createGeoMap(geo_bs);
+  }
+
   // compute the fine-to-coarse site map
   void Transfer::createGeoMap(int *geo_bs) {
 
@@ -284,8 +404,9 @@ namespace quda {
       
       //printfQuda("fine idx %d = fine (%d,%d,%d,%d), ", i, x[0], x[1], x[2], x[3]);
 
-      // compute the corresponding coarse-grid index given the block size
-      for (int d=0; d<fine.Ndim(); d++) x[d] /= geo_bs[d];
+      // compute the corresponding coarse-grid index given the block
+      // size, with the blocks shifted by any fitted offset
+      for (int d = 0; d < fine.Ndim(); d++) x[d] = ((x[d] - geo_offset[d] + fine.X(d)) % fine.X(d)) / geo_bs[d];
 
       // compute the coarse-offset index and store in fine_to_coarse
       int k;
@@ -117,7 +117,8 @@ enum class Kernel {
   cDotProductNorm_block,
   cDotProduct_block,
   hDotProduct_block,
-  caxpyXmazMR
+  caxpyXmazMR,
+  orthonormalize_block
 };
 
 // For googletest names must be non-empty, unique, and may only contain ASCII
@@ -163,7 +164,8 @@ const std::map<Kernel, std::string> kernel_map
      {Kernel::cDotProductNorm_block, "cDotProductNorm_block"},
      {Kernel::cDotProduct_block, "cDotProduct_block"},
      {Kernel::hDotProduct_block, "hDotProduct_block"},
-     {Kernel::caxpyXmazMR, "caxpyXmazMR"}};
+     {Kernel::caxpyXmazMR, "caxpyXmazMR"},
+     {Kernel::orthonormalize_block, "orthonormalize_block"}};
 
 const int Nkernels = kernel_map.size();
 
@@ -186,7 +188,8 @@ bool is_mixed(Kernel kernel)
 {
   switch (kernel) {
   case Kernel::axpyz_block:
-  case Kernel::caxpyz_block: return false;
+  case Kernel::caxpyz_block:
+  case Kernel::orthonormalize_block: return false;
   default: return true;
   }
 }
@@ -534,6 +537,10 @@ protected:
         commAsyncReductionSet(false);
         break;
 
+      case Kernel::orthonormalize_block:
+        for (int i = 0; i < niter; ++i) blas::block::orthonormalize(xmD);
+        break;
+
       default: errorQuda("Undefined blas kernel %s\n", kernel_map.at(kernel).c_str());
       }
     }
@@ -1078,6 +1085,26 @@ protected:
       error = ERROR(x) + ERROR(y);
       break;
 
+    case Kernel::orthonormalize_block:
+      for (int i = 0; i < Nsrc; i++) xmD[i] = xmH[i];
+
+      // use a small block size to exercise the projection between blocks
+      blas::block::orthonormalize(xmD, 2);
+
+      // reference is sequential classical Gram-Schmidt
+      for (int i = 0; i < Nsrc; i++) {
+        for (int j = 0; j < i; j++) blas::caxpy(-blas::cDotProduct(xmH[j], xmH[i]), xmH[j], xmH[i]);
+        blas::ax(1.0 / sqrt(blas::norm2(xmH[i])), xmH[i]);
+      }
+
+      error = 0.0;
+      for (int i = 0; i < Nsrc; i++) {
+        zmH[i] = xmD[i];
+        error += blas::xmyNorm(xmH[i], zmH[i]);
+      }
+      error /= Nsrc;
+      break;
+
     default: errorQuda("Undefined blas kernel %s\n", kernel_map.at(kernel).c_str());
     }
 
@@ -133,11 +133,14 @@ void init(int argc, char **argv)
   }
 }
 
-std::vector<double> eigensolve(test_t test_param)
+std::vector<double> eigensolve(test_t test_param, std::vector<quda::ColorSpinorField> *evecs_guess,
+                               std::vector<double _Complex> *evals_out)
 {
   // Collect testing parameters from gtest
   eig_inv_param.cuda_prec = ::testing::get<0>(test_param);
-  eig_inv_param.cuda_prec_eigensolver = ::testing::get<0>(test_param);
+  // the eigensolver precision follows the gauge field, which may be
+  // loaded sloppier than the outer precision
+  eig_inv_param.cuda_prec_eigensolver = gauge_param.cuda_prec_eigensolver;
   eig_inv_param.cuda_prec_sloppy = ::testing::get<0>(test_param);
   eig_inv_param.cuda_prec_precondition = ::testing::get<0>(test_param);
   eig_inv_param.cuda_prec_refinement_sloppy = ::testing::get<0>(test_param);
@@ -198,6 +201,9 @@ std::vector<double> eigensolve(test_t test_param)
   std::vector<void *> host_evecs_ptr(n_eig);
   // Allocate host side memory and pointers
   std::vector<quda::ColorSpinorField> evecs(n_eig, cs_param);
+  // start from the eigenvectors of a previous solve if given
+  if (evecs_guess && evecs_guess->size() == evecs.size())
+    for (int i = 0; i < n_eig; i++) evecs[i] = (*evecs_guess)[i];
   for (int i = 0; i < n_eig; i++) host_evecs_ptr[i] = evecs[i].data();
 
   // Complex eigenvalues
@@ -237,6 +243,8 @@ std::vector<double> eigensolve(test_t test_param)
       }
     }
   }
+  if (evecs_guess) *evecs_guess = std::move(evecs);
+  if (evals_out) *evals_out = evals;
   return residua;
   // QUDA eigensolver test COMPLETE
   //----------------------------------------------------------------------------
@@ -1,5 +1,10 @@
 #include <instantiate.h>
+#include <blas_lapack.h>
+#include <eig_arrow.h>
+#include <eig_hessenberg.h>
+#include <Eigen/Dense>
 #include <gtest/gtest.h>
+#include <random>
 
 using test_t = ::testing::tuple<QudaPrecision, QudaEigType, QudaBoolean, QudaBoolean, QudaBoolean, QudaEigSpectrumType>;
 
@@ -58,7 +63,8 @@ public:
   }
 };
 
-std::vector<double> eigensolve(test_t test_param);
+std::vector<double> eigensolve(test_t test_param, std::vector<quda::ColorSpinorField> *evecs_guess = nullptr,
+                               std::vector<double _Complex> *evals_out = nullptr);
 
 TEST_P(EigensolveTest, verify)
 {
@@ -77,6 +83,159 @@ TEST_P(EigensolveTest, verify)
   for (auto rsd : eigensolve(GetParam())) EXPECT_LE(rsd, tol);
 }
 
+using EigensolveWarmStartTest = EigensolveTest;
+
+// an eigensolve that starts from converged eigenvectors converges
+// without a further iteration
+TEST_P(EigensolveWarmStartTest, verify)
+{
+  if (skip_test(GetParam())) GTEST_SKIP();
+
+  auto tol = ::testing::get<0>(GetParam()) == QUDA_SINGLE_PRECISION ? 1e-5 : 1e-12;
+  eig_param.tol = tol;
+
+  std::vector<quda::ColorSpinorField> evecs;
+  for (auto rsd : eigensolve(GetParam(), &evecs)) EXPECT_LE(rsd, tol);
+
+  auto max_restarts = eig_param.max_restarts;
+  auto require_convergence = eig_param.require_convergence;
+  eig_param.max_restarts = 1;
+  eig_param.require_convergence = QUDA_BOOLEAN_FALSE;
+  auto residua = eigensolve(GetParam(), &evecs);
+  eig_param.max_restarts = max_restarts;
+  eig_param.require_convergence = require_convergence;
+
+  for (auto rsd : residua) EXPECT_LE(rsd, tol);
+}
+
+using EigensolveRefineTest = EigensolveTest;
+
+// after the gauge field is perturbed, refining the stale eigenpairs on
+// the new operator brings their residuals below those of the stale
+// eigenpairs, and to the eigensolver tolerance
+TEST_P(EigensolveRefineTest, verify)
+{
+  if (skip_test(GetParam())) GTEST_SKIP();
+
+  auto tol = ::testing::get<0>(GetParam()) == QUDA_SINGLE_PRECISION ? 1e-5 : 1e-12;
+  eig_param.tol = tol;
+
+  std::vector<quda::ColorSpinorField> evecs;
+  std::vector<double _Complex> evals;
+  for (auto rsd : eigensolve(GetParam(), &evecs, &evals)) EXPECT_LE(rsd, tol);
+
+  auto gauge_initial = gauge_;
+  perturbHostGaugeField(gauge.data(), gauge_param.cpu_prec, 1e-2);
+  freeGaugeQuda();
+  loadGaugeQuda(gauge.data(), &gauge_param);
+
+  std::vector<double> stale(eig_n_conv);
+  for (int i = 0; i < eig_n_conv; i++)
+    stale[i] = verifyWilsonTypeEigenvector(evecs[i].data(), evals[i], i, gauge_param, eig_param, gauge.data(),
+                                           clover.data(), clover_inv.data());
+
+  auto deflation_refine = eig_param.deflation_refine;
+  eig_param.deflation_refine = QUDA_BOOLEAN_TRUE;
+  auto refined = eigensolve(GetParam(), &evecs);
+  eig_param.deflation_refine = deflation_refine;
+
+  // restore the unperturbed gauge field
+  std::copy(gauge_initial.begin(), gauge_initial.end(), gauge_.begin());
+  freeGaugeQuda();
+  loadGaugeQuda(gauge.data(), &gauge_param);
+
+  for (int i = 0; i < eig_n_conv; i++) {
+    EXPECT_LE(refined[i], tol) << "eigenpair " << i;
+    EXPECT_LT(refined[i], stale[i]) << "eigenpair " << i;
+  }
+}
+
+using EigensolveRotateTest = EigensolveTest;
+
+// the Krylov space rotation with the native GEMM gives the same
+// eigenpairs as the multi-blas rotation and its batched LU variant
+TEST_P(EigensolveRotateTest, verify)
+{
+  if (skip_test(GetParam())) GTEST_SKIP();
+
+  auto tol = ::testing::get<0>(GetParam()) == QUDA_SINGLE_PRECISION ? 1e-5 : 1e-12;
+  eig_param.tol = tol;
+
+  auto native = quda::blas_lapack::use_native();
+  auto batched_rotate = eig_batched_rotate;
+
+  // native GEMM rotation in a single tile, then the multi-blas
+  // rotation without and with batching
+  std::vector<std::vector<double _Complex>> evals(3);
+  std::vector<std::vector<double>> residua(3);
+  quda::blas_lapack::set_native(true);
+  eig_batched_rotate = 2 * eig_n_kr;
+  residua[0] = eigensolve(GetParam(), nullptr, &evals[0]);
+  quda::blas_lapack::set_native(false);
+  residua[1] = eigensolve(GetParam(), nullptr, &evals[1]);
+  eig_batched_rotate = 2;
+  residua[2] = eigensolve(GetParam(), nullptr, &evals[2]);
+
+  quda::blas_lapack::set_native(native);
+  eig_batched_rotate = batched_rotate;
+
+  for (int r = 0; r < 3; r++) {
+    for (int i = 0; i < eig_n_conv; i++) {
+      EXPECT_LE(residua[r][i], tol) << "rotation " << r << " eigenpair " << i;
+      // the eigenvalues agree to the accuracy that the residuals bound
+      EXPECT_LE(std::abs(std::complex<double>(evals[r][i]) - std::complex<double>(evals[0][i])),
+                10 * tol * std::abs(std::complex<double>(evals[0][i])))
+        << "rotation " << r << " eigenpair " << i;
+    }
+  }
+}
+
+/**
+   @brief Reload the gauge (and clover) field with the eigensolver
+   copy at the given precision
+   @param[in] prec The eigensolver precision
+*/
+void load_eigensolver_precision(QudaPrecision prec)
+{
+  freeGaugeQuda();
+  gauge_param.cuda_prec_eigensolver = prec;
+  loadGaugeQuda(gauge.data(), &gauge_param);
+  if (dslash_type == QUDA_CLOVER_WILSON_DSLASH || dslash_type == QUDA_TWISTED_CLOVER_DSLASH) {
+    freeCloverQuda();
+    eig_inv_param.clover_cuda_prec_eigensolver = prec;
+    loadCloverQuda(clover.data(), clover_inv.data(), &eig_inv_param);
+  }
+}
+
+using EigensolvePreciseRefineTest = EigensolveTest;
+
+// eigenpairs computed with a single precision eigensolver and refined
+// with the double precision operator reach a double precision tolerance
+// on the host reference operator
+TEST_P(EigensolvePreciseRefineTest, verify)
+{
+  if (skip_test(GetParam())) GTEST_SKIP();
+  if (::testing::get<0>(GetParam()) != QUDA_DOUBLE_PRECISION || !quda::is_enabled(QUDA_SINGLE_PRECISION))
+    GTEST_SKIP();
+
+  auto tol = 1e-12;
+  eig_param.tol = tol;
+
+  auto precise_refine = eig_param.precise_refine;
+  auto tol_sloppy = eig_param.tol_sloppy;
+  eig_param.precise_refine = QUDA_BOOLEAN_TRUE;
+  eig_param.tol_sloppy = 1e-5;
+  load_eigensolver_precision(QUDA_SINGLE_PRECISION);
+
+  auto residua = eigensolve(GetParam());
+
+  load_eigensolver_precision(::testing::get<0>(GetParam()));
+  eig_param.precise_refine = precise_refine;
+  eig_param.tol_sloppy = tol_sloppy;
+
+  for (int i = 0; i < eig_n_conv; i++) EXPECT_LE(residua[i], tol) << "eigenpair " << i;
+}
+
 std::string gettestname(::testing::TestParamInfo<test_t> param)
 {
   std::string name;
@@ -92,11 +251,189 @@ std::string gettestname(::testing::TestParamInfo<test_t> param)
   return name;
 }
 
+// arrow matrix dimension, arrow position (percent of the dimension), and matrix type
+using arrow_test_t = ::testing::tuple<int, int, int>;
+
+enum ArrowMatrixType { ARROW_RANDOM, ARROW_SMALL_COUPLINGS, ARROW_REPEATED_POLES };
+
+class ArrowEigensolveTest : public ::testing::TestWithParam<arrow_test_t>
+{
+};
+
+// the structured eigensolve of the thick-restart arrow matrix agrees
+// with the dense reference, including when couplings are deflated and
+// when repeated poles give repeated eigenvalues
+TEST_P(ArrowEigensolveTest, verify)
+{
+  const int dim = ::testing::get<0>(GetParam());
+  const int arrow_pos = std::min(dim - 1, dim * ::testing::get<1>(GetParam()) / 100);
+  const int type = ::testing::get<2>(GetParam());
+
+  std::mt19937 rng(1234 + dim + arrow_pos);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> diag(dim), offdiag(dim - 1);
+  for (auto &d : diag) d = dist(rng);
+  for (auto &e : offdiag) e = dist(rng);
+  // couplings below the deflation tolerance
+  if (type == ARROW_SMALL_COUPLINGS)
+    for (int i = 0; i < dim - 1; i += 3) offdiag[i] *= 1e-17;
+  // triples of locked Ritz values give eigenvalues of multiplicity two
+  if (type == ARROW_REPEATED_POLES)
+    for (int i = 0; i < arrow_pos; i++)
+      if (i % 3 != 0) diag[i] = diag[i - 1];
+
+  std::vector<double> A(dim * dim, 0.0);
+  for (int i = 0; i < dim; i++) A[i * dim + i] = diag[i];
+  for (int i = 0; i < arrow_pos; i++) A[i * dim + arrow_pos] = A[arrow_pos * dim + i] = offdiag[i];
+  for (int i = arrow_pos; i < dim - 1; i++) A[i * dim + i + 1] = A[(i + 1) * dim + i] = offdiag[i];
+  double scale = 0.0;
+  for (auto a : A) scale = std::max(scale, std::abs(a));
+
+  std::vector<double> evals(dim), evecs(dim * dim), evals_ref(dim), evecs_ref(dim * dim);
+  quda::arrowEigensolve(evals.data(), evecs.data(), diag.data(), offdiag.data(), dim, arrow_pos);
+  quda::arrowEigensolveDense(evals_ref.data(), evecs_ref.data(), diag.data(), offdiag.data(), dim, arrow_pos);
+
+  const double eps = std::numeric_limits<double>::epsilon();
+  const double tol = 100 * dim * eps;
+  auto dot = [&](const double *u, const double *v) {
+    double sum = 0.0;
+    for (int k = 0; k < dim; k++) sum += u[k] * v[k];
+    return sum;
+  };
+
+  for (int i = 0; i < dim; i++) {
+    const double *v = &evecs[dim * i];
+    EXPECT_LE(std::abs(evals[i] - evals_ref[i]), tol * scale) << "eigenvalue " << i;
+
+    // the eigenvectors are orthonormal
+    for (int j = 0; j <= i; j++)
+      EXPECT_LE(std::abs(dot(v, &evecs[dim * j]) - (i == j ? 1.0 : 0.0)), tol) << "eigenvectors " << i << " " << j;
+
+    // and have small residuals
+    double r2 = 0.0;
+    for (int k = 0; k < dim; k++) {
+      double r = dot(&A[k * dim], v) - evals[i] * v[k];
+      r2 += r * r;
+    }
+    EXPECT_LE(std::sqrt(r2), tol * scale) << "eigenvector " << i;
+
+    // and lie in the reference eigenspace of their eigenvalue, which
+    // is only unique up to a rotation for repeated eigenvalues
+    double overlap = 0.0;
+    for (int j = 0; j < dim; j++)
+      if (std::abs(evals_ref[j] - evals[i]) <= 1e-6 * scale) overlap += std::pow(dot(v, &evecs_ref[dim * j]), 2);
+    EXPECT_LE(std::abs(1.0 - overlap), 1e-8) << "eigenvector " << i;
+  }
+}
+
+std::string getarrowtestname(::testing::TestParamInfo<arrow_test_t> param)
+{
+  const char *type[] = {"random", "small_couplings", "repeated_poles"};
+  return std::string("dim") + std::to_string(::testing::get<0>(param.param)) + "_arrow"
+    + std::to_string(::testing::get<1>(param.param)) + "_" + type[::testing::get<2>(param.param)];
+}
+
+class HessenbergTest : public ::testing::TestWithParam<int>
+{
+};
+
+using cmatrix_t = Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic>;
+
+// a random complex upper Hessenberg matrix
+cmatrix_t random_hessenberg(int n, std::mt19937 &rng)
+{
+  std::normal_distribution<double> dist;
+  cmatrix_t H = cmatrix_t::Zero(n, n);
+  for (int j = 0; j < n; j++)
+    for (int i = 0; i <= std::min(j + 1, n - 1); i++) H(i, j) = {dist(rng), dist(rng)};
+  return H;
+}
+
+// the implicitly shifted QR steps of the Arnoldi restart are a unitary
+// similarity transformation that preserves the Hessenberg form, and
+// whose first column is that of the explicitly shifted polynomial
+// prod_k (H - mu_k) e_1
+TEST_P(HessenbergTest, shifts)
+{
+  const int n = GetParam();
+  const int num_shifts = n / 4;
+  std::mt19937 rng(1234 + n);
+  cmatrix_t H0 = random_hessenberg(n, rng);
+
+  // shift with the eigenvalues of largest modulus, as IRAM does with the unwanted Ritz values
+  Eigen::ComplexEigenSolver<cmatrix_t> eigensolver(H0);
+  std::vector<std::complex<double>> shifts(n);
+  for (int k = 0; k < num_shifts; k++) shifts[k] = eigensolver.eigenvalues()[n - 1 - k];
+
+  std::vector<std::vector<std::complex<double>>> H(n, std::vector<std::complex<double>>(n)), Q;
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) H[i][j] = H0(i, j);
+  quda::hessenbergQRShifts(H, Q, shifts, num_shifts, 1e-14);
+
+  cmatrix_t H1(n, n), Q1(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      H1(i, j) = H[i][j];
+      Q1(i, j) = Q[i][j];
+    }
+  }
+
+  const double scale = H0.norm();
+  const double tol = 100 * n * std::numeric_limits<double>::epsilon();
+  EXPECT_LE((Q1.adjoint() * Q1 - cmatrix_t::Identity(n, n)).norm(), tol);
+  EXPECT_LE((Q1.adjoint() * H0 * Q1 - H1).norm(), tol * scale);
+  for (int j = 0; j < n; j++)
+    for (int i = j + 2; i < n; i++) EXPECT_LE(std::abs(H1(i, j)), tol * scale) << "element " << i << " " << j;
+
+  // implicit Q theorem: the first column of Q is parallel to prod_k (H - mu_k) e_1
+  Eigen::VectorXcd p = Eigen::VectorXcd::Unit(n, 0);
+  for (int k = 0; k < num_shifts; k++) {
+    p = H0 * p - shifts[k] * p;
+    p.normalize();
+  }
+  EXPECT_LE(1.0 - std::abs(p.dot(Q1.col(0))), 1e-8);
+}
+
+// the eigenvectors of an upper triangular matrix have small residuals
+// and agree with those of Eigen, and the eigenvalues are in the same
+// order
+TEST_P(HessenbergTest, triangular)
+{
+  const int n = GetParam();
+  std::mt19937 rng(4321 + n);
+  cmatrix_t T = random_hessenberg(n, rng).triangularView<Eigen::Upper>();
+
+  Eigen::VectorXcd evals(n);
+  cmatrix_t X(n, n);
+  quda::triangularEigensolve(evals.data(), X.data(), T.data(), n);
+  Eigen::ComplexEigenSolver<cmatrix_t> eigensolver(T);
+
+  const double scale = T.norm();
+  const double tol = 100 * n * std::numeric_limits<double>::epsilon();
+  for (int k = 0; k < n; k++) {
+    EXPECT_LE(std::abs(evals[k] - eigensolver.eigenvalues()[k]), tol * scale) << "eigenvalue " << k;
+    EXPECT_LE(std::abs(X.col(k).norm() - 1.0), tol) << "eigenvector " << k;
+    EXPECT_LE((T * X.col(k) - evals[k] * X.col(k)).norm(), tol * scale) << "eigenvector " << k;
+    // the eigenvectors are unique up to a phase
+    EXPECT_LE(1.0 - std::abs(X.col(k).dot(eigensolver.eigenvectors().col(k).normalized())), 1e-8)
+      << "eigenvector " << k;
+  }
+}
+
 using ::testing::Combine;
 using ::testing::Values;
 
+// Hessenberg matrices of the size of typical Krylov spaces
+INSTANTIATE_TEST_SUITE_P(Hessenberg, HessenbergTest, Values(16, 64, 128));
+
+// arrow matrices solved directly and by divide and conquer, with the arrow at the start, middle and end
+INSTANTIATE_TEST_SUITE_P(ArrowEigensolve, ArrowEigensolveTest,
+                         Combine(Values(8, 64, 200), Values(0, 50, 99),
+                                 Values(ARROW_RANDOM, ARROW_SMALL_COUPLINGS, ARROW_REPEATED_POLES)),
+                         getarrowtestname);
+
 // Can solve hermitian systems
-auto hermitian_solvers = Values(QUDA_EIG_TR_LANCZOS, QUDA_EIG_BLK_TR_LANCZOS, QUDA_EIG_IR_ARNOLDI);
+auto hermitian_solvers = Values(QUDA_EIG_TR_LANCZOS, QUDA_EIG_BLK_TR_LANCZOS, QUDA_EIG_IR_ARNOLDI, QUDA_EIG_LOBPCG);
 
 // Can solve non-hermitian systems
 auto non_hermitian_solvers = Values(QUDA_EIG_IR_ARNOLDI);
@@ -131,3 +468,30 @@ INSTANTIATE_TEST_SUITE_P(DirectFull, EigensolveTest,
                                             Values(QUDA_BOOLEAN_FALSE), Values(QUDA_BOOLEAN_FALSE),
                                             non_hermitian_spectrum),
                          gettestname);
+
+// LOBPCG started from the eigenvectors of a previous solve
+INSTANTIATE_TEST_SUITE_P(WarmStartEvenOdd, EigensolveWarmStartTest,
+                         ::testing::Combine(precisions, Values(QUDA_EIG_LOBPCG), Values(QUDA_BOOLEAN_TRUE),
+                                            Values(QUDA_BOOLEAN_TRUE), Values(QUDA_BOOLEAN_FALSE), hermitian_spectrum),
+                         gettestname);
+
+// Lanczos eigenpairs refined after a gauge field update
+INSTANTIATE_TEST_SUITE_P(RefineEvenOdd, EigensolveRefineTest,
+                         ::testing::Combine(precisions, Values(QUDA_EIG_TR_LANCZOS), Values(QUDA_BOOLEAN_TRUE),
+                                            Values(QUDA_BOOLEAN_TRUE), Values(QUDA_BOOLEAN_FALSE),
+                                            Values(QUDA_SPECTRUM_SR_EIG)),
+                         gettestname);
+
+// Lanczos with the native GEMM and multi-blas Krylov space rotations
+INSTANTIATE_TEST_SUITE_P(RotateEvenOdd, EigensolveRotateTest,
+                         ::testing::Combine(precisions, Values(QUDA_EIG_TR_LANCZOS), Values(QUDA_BOOLEAN_TRUE),
+                                            Values(QUDA_BOOLEAN_TRUE), Values(QUDA_BOOLEAN_FALSE),
+                                            Values(QUDA_SPECTRUM_SR_EIG)),
+                         gettestname);
+
+// single precision Lanczos eigenpairs refined in double precision
+INSTANTIATE_TEST_SUITE_P(PreciseRefineEvenOdd, EigensolvePreciseRefineTest,
+                         ::testing::Combine(Values(QUDA_DOUBLE_PRECISION), Values(QUDA_EIG_TR_LANCZOS),
+                                            Values(QUDA_BOOLEAN_TRUE), Values(QUDA_BOOLEAN_TRUE),
+                                            Values(QUDA_BOOLEAN_FALSE), Values(QUDA_SPECTRUM_SR_EIG)),
+                         gettestname);
@@ -3,10 +3,12 @@
 #include <time.h>
 #include <math.h>
 #include <string.h>
+#include <functional>
 
 // QUDA headers
 #include <quda.h>
 #include <color_spinor_field.h> // convenient quark field container
+#include <blas_quda.h>
 
 // External headers
 #include <misc.h>
@@ -23,6 +25,9 @@ QudaEigParam mg_eig_param[QUDA_MAX_MG_LEVEL];
 QudaEigParam eig_param;
 bool use_split_grid = false;
 bool use_multi_src = false;
+bool keep_deflation_space = false;     // preserve the deflation space past the last solve
+std::vector<int> solve_iter;           // iterations of each source (the total of its tile) in the last solve
+std::function<void(void *)> mg_update; // applied to the multigrid hierarchy once it is set up
 
 std::vector<char> gauge_;
 std::array<void *, 4> gauge;
@@ -191,7 +196,7 @@ void init(int argc, char **argv)
   }
 }
 
-std::vector<std::array<double, 2>> solve(test_t param)
+std::vector<std::array<double, 2>> solve(test_t param, std::vector<quda::ColorSpinorField> *solutions)
 {
   inv_param.cuda_prec = ::testing::get<0>(param);
   inv_param.clover_cuda_prec = ::testing::get<0>(param);
@@ -234,7 +239,9 @@ std::vector<std::array<double, 2>> solve(test_t param)
   void *mg_preconditioner = nullptr;
   if (inv_multigrid) {
     if (use_split_grid) { errorQuda("Split grid does not work with MG yet."); }
+    if (mg_tune) tuneMultigridQuda(&mg_param, &inv_param);
     mg_preconditioner = newMultigridQuda(&mg_param);
+    if (mg_update) mg_update(mg_preconditioner);
     inv_param.preconditioner = mg_preconditioner;
 
     printfQuda("MG Setup Done: %g secs, %g Gflops\n", mg_param.invert_param->secs,
@@ -299,13 +306,20 @@ std::vector<std::array<double, 2>> solve(test_t param)
   std::vector<double> time(Nsrc);
   std::vector<double> gflops(Nsrc);
   std::vector<int> iter(Nsrc);
+  solve_iter.assign(Nsrc, 0);
 
   quda::RNG rng(check, 1234);
 
   for (int i = 0; i < Nsrc; i++) {
-    // Populate the host spinor with random numbers.
-    in[i] = quda::ColorSpinorField(cs_param);
-    spinorNoise(in[i], rng, QUDA_NOISE_GAUSS);
+    if (Nsrc_rank > 0 && i >= Nsrc_rank) {
+      // linearly dependent sources test rank-deficient blocks in the multi-source solvers
+      in[i] = in[i % Nsrc_rank];
+      quda::blas::axpy(0.5, in[(i + 1) % Nsrc_rank], in[i]);
+    } else {
+      // Populate the host spinor with random numbers.
+      in[i] = quda::ColorSpinorField(cs_param);
+      spinorNoise(in[i], rng, QUDA_NOISE_GAUSS);
+    }
     out[i] = quda::ColorSpinorField(cs_param);
   }
 
@@ -319,7 +333,8 @@ std::vector<std::array<double, 2>> solve(test_t param)
 
     for (int i = 0; i < Nsrc; i++) {
       // If deflating, preserve the deflation space between solves
-      if (inv_deflate) eig_param.preserve_deflation = i < Nsrc - 1 ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+      if (inv_deflate) eig_param.preserve_deflation
+          = (i < Nsrc - 1 || keep_deflation_space) ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
       // Perform QUDA inversions
       if (multishift > 1) {
         invertMultiShiftQuda(_hp_multi_x[i].data(), in[i].data(), &inv_param);
@@ -334,6 +349,7 @@ std::vector<std::array<double, 2>> solve(test_t param)
       time[i] = inv_param.secs;
       gflops[i] = inv_param.gflops / inv_param.secs;
       iter[i] = inv_param.iter;
+      solve_iter[i] = inv_param.iter;
       printfQuda("Done: %i iter / %g secs = %g Gflops\n", inv_param.iter, inv_param.secs,
                  inv_param.gflops / inv_param.secs);
       if (inv_param.energy > 0) {
@@ -352,7 +368,8 @@ std::vector<std::array<double, 2>> solve(test_t param)
 
     for (int j = 0; j < Nsrc; j += Nsrc_tile) {
       // If deflating, preserve the deflation space between solves
-      if (inv_deflate) eig_param.preserve_deflation = j < Nsrc - Nsrc_tile ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+      if (inv_deflate) eig_param.preserve_deflation
+          = (j < Nsrc - Nsrc_tile || keep_deflation_space) ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
       for (int i = 0; i < Nsrc_tile; i++) {
         _hp_x[i] = out[j + i].data();
@@ -365,6 +382,7 @@ std::vector<std::array<double, 2>> solve(test_t param)
       for (int i = 0; i < Nsrc_tile; i++) {
         inv_param.true_res[j + i] = inv_param.true_res[i];
         inv_param.true_res_hq[j + i] = inv_param.true_res_hq[i];
+        solve_iter[j + i] = inv_param.iter;
       }
 
       printfQuda("Done: %d sub-partitions - %i total iter / %g secs = %g Gflops, %g secs per source\n", num_sub_partition,
@@ -393,6 +411,7 @@ std::vector<std::array<double, 2>> solve(test_t param)
                                gauge.data(), clover.data(), clover_inv.data(), i);
     }
   }
+  if (solutions) *solutions = std::move(out);
   return res;
 }
 
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include <quda_arch.h>
+#include <mg_tune.h>
+#include <mg_checkpoint.h>
+#include <invert_quda.h>
+#include <transfer.h>
 #include <cmath>
+#include <cstdio>
 
 // tuple containing parameters for Schwarz solver
 using schwarz_t = ::testing::tuple<QudaSchwarzType, QudaInverterType, QudaPrecision>;
@@ -47,6 +52,8 @@ bool skip_test(test_t param)
   if ((inverter_type == QUDA_CG3_INVERTER || inverter_type == QUDA_CG3NE_INVERTER || inverter_type == QUDA_CG3NR_INVERTER)
       && prec_sloppy < QUDA_DOUBLE_PRECISION)
     return true;
+  // the block CG rank detection is too coarse with quarter precision
+  if (inverter_type == QUDA_BLOCK_CG_INVERTER && prec_sloppy < QUDA_HALF_PRECISION) return true;
   // split-grid doesn't support multishift at present
   if (use_split_grid && multishift > 1) return true;
   if ((distance_pc_alpha0 != 0 && distance_pc_t0 >= 0) && (multishift > 1)) return true;
@@ -54,11 +61,63 @@ bool skip_test(test_t param)
   return false;
 }
 
+std::vector<std::array<double, 2>> solve(test_t param, std::vector<quda::ColorSpinorField> *solutions = nullptr);
+
+/**
+   @brief Restore a variable to its value at construction on leaving
+   the scope, so a test may change it and still return early, e.g.,
+   from a failed ASSERT
+*/
+template <typename T> class Restore
+{
+  T &var;
+  T value;
+
+public:
+  Restore(T &v) : var(v), value(v) { }
+  ~Restore() { var = value; }
+};
+
+/**
+   @brief Restore the invert, multigrid and eigensolver parameters on
+   leaving the scope
+*/
+struct ParamGuard {
+  Restore<QudaInvertParam> inv {inv_param};
+  Restore<QudaMultigridParam> mg {mg_param};
+  Restore<QudaEigParam> eig {eig_param};
+};
+
 class InvertTest : public ::testing::TestWithParam<test_t>
 {
 protected:
   test_t param;
 
+  /**
+     @brief Set the L2 tolerance of a test solve from the outer
+     precision, with no heavy-quark tolerance
+     @return The tolerance
+  */
+  double set_tol()
+  {
+    auto tol = ::testing::get<0>(param) == QUDA_SINGLE_PRECISION ? 1e-6 : 1e-12;
+    inv_param.tol = tol;
+    inv_param.tol_hq = 0.0;
+    return tol;
+  }
+
+  /**
+     @brief Solve, and check that every source converged to tol
+     @param[in] tol The tolerance
+     @param[out] solutions The solutions, if requested
+     @return The number of iterations of the solve
+  */
+  int solve_converged(double tol, std::vector<quda::ColorSpinorField> *solutions = nullptr)
+  {
+    for (auto rsd : solve(param, solutions)) EXPECT_LE(rsd[0], tol);
+    return inv_param.iter;
+  }
+
 public:
   InvertTest() : param(GetParam()) { }
 
@@ -100,8 +159,6 @@ public:
   }
 };
 
-std::vector<std::array<double, 2>> solve(test_t param);
-
 TEST_P(InvertTest, verify)
 {
   if (skip_test(GetParam())) GTEST_SKIP();
@@ -151,10 +208,463 @@ std::string gettestname(::testing::TestParamInfo<test_t> param)
   return name;
 }
 
+using InvertRecycleTest = InvertTest;
+
+// a multi-source solve recycling the earlier solutions gives the same
+// solutions, and the blocks of sources that lie in the span of the
+// earlier sources (--nsrc-rank) take fewer iterations than solving
+// the same block without recycling
+TEST_P(InvertRecycleTest, verify)
+{
+  // all sources must be solved in a single multi-source solve, and the
+  // later sources must be combinations of the earlier ones
+  if (Nsrc < 2 || Nsrc_tile != Nsrc || grid_partition[0] * grid_partition[1] * grid_partition[2] * grid_partition[3] > 1)
+    GTEST_SKIP();
+  if (Nsrc_rank <= 0 || Nsrc_rank >= Nsrc) GTEST_SKIP();
+
+  ParamGuard guard;
+  Restore<int> nsrc_tile(Nsrc_tile);
+  auto tol = set_tol();
+
+  auto recycle_block_size = inv_param.recycle_block_size;
+  auto block_size = (recycle_block_size < Nsrc && Nsrc % recycle_block_size == 0) ? recycle_block_size : 1;
+
+  // the reference solves each block of sources on its own
+  std::vector<quda::ColorSpinorField> x_ref;
+  auto recycle_max_dim = inv_param.recycle_max_dim;
+  inv_param.recycle_max_dim = 0;
+  Nsrc_tile = block_size;
+  solve(GetParam(), &x_ref);
+  auto iter_ref = solve_iter;
+
+  std::vector<quda::ColorSpinorField> x;
+  inv_param.recycle_max_dim = std::max(recycle_max_dim, Nsrc);
+  inv_param.recycle_block_size = block_size;
+  Nsrc_tile = Nsrc;
+  solve_converged(tol, &x);
+
+  // the solutions agree to within the solver tolerance, up to the condition number
+  for (int i = 0; i < Nsrc; i++) {
+    auto x2 = quda::blas::norm2(x_ref[i]);
+    quda::blas::axpy(-1.0, x[i], x_ref[i]);
+    EXPECT_LE(sqrt(quda::blas::norm2(x_ref[i]) / x2), 1e3 * tol);
+  }
+
+  // the blocks past the rank of the sources are (up to the solver
+  // tolerance) in the span of the recycled solutions
+  for (int i = 0; i < Nsrc; i += block_size) {
+    if (i >= Nsrc_rank) EXPECT_LT(inv_param.recycle_iter[i / block_size], iter_ref[i]) << "sources from " << i;
+  }
+}
+
+using InvertAdaptiveTest = InvertTest;
+
+// a solve to a tolerance beyond the reach of the initial sloppy
+// precision must promote the sloppy precision to converge: with
+// reliable updates that each claim more reduction than the
+// preconditioner and sloppy precisions can realize, the iteration
+// climbs every rung of the ladder to the outer precision
+TEST_P(InvertAdaptiveTest, verify)
+{
+  ParamGuard guard;
+  auto tol = set_tol();
+
+  inv_param.adaptive_precision = QUDA_BOOLEAN_TRUE;
+  inv_param.reliable_delta = 1e-8;
+  solve_converged(tol);
+
+  auto prec = ::testing::get<0>(GetParam());
+  auto prec_sloppy = ::testing::get<1>(GetParam());
+  auto prec_precondition = ::testing::get<2>(::testing::get<7>(GetParam()));
+  int rungs = 1 + (prec_precondition < prec_sloppy ? 1 : 0) + (prec > prec_sloppy ? 1 : 0);
+  EXPECT_EQ(inv_param.adaptive_promotions, rungs - 1);
+}
+
+using InvertSmootherTest = InvertTest;
+
+// a fixed number of iterations of a smoother reduces the residual,
+// and more iterations reduce it further
+TEST_P(InvertSmootherTest, verify)
+{
+  ParamGuard guard;
+  inv_param.tol = 0.0;
+  inv_param.tol_hq = 0.0;
+
+  std::vector<double> res;
+  for (int n : {4, 16}) {
+    inv_param.maxiter = n;
+    double max_res = 0.0;
+    for (auto rsd : solve(GetParam())) max_res = std::max(max_res, rsd[0]);
+    res.push_back(max_res);
+  }
+
+  // the initial guess is zero, so the initial relative residual is one
+  EXPECT_LT(res[0], 1.0);
+  EXPECT_LE(res[1], res[0]);
+}
+
+using InvertDeflationTest = InvertTest;
+
+// deflating with the space streamed from host memory uses the same
+// eigenvalues, and takes as many iterations, as deflating in core
+TEST_P(InvertDeflationTest, verify)
+{
+  // the space is only streamed from host memory once it has been preserved
+  if (!inv_deflate || Nsrc < 2) GTEST_SKIP();
+
+  ParamGuard guard;
+  Restore<bool> keep(keep_deflation_space);
+  auto tol = set_tol();
+  keep_deflation_space = true;
+
+  std::vector<std::vector<quda::Complex>> evals;
+  std::vector<int> iter;
+  std::vector<bool> on_host;
+  for (auto out_of_core : {QUDA_BOOLEAN_FALSE, QUDA_BOOLEAN_TRUE}) {
+    eig_param.deflation_out_of_core = out_of_core;
+    // several tiles exercise the double buffering
+    eig_param.deflation_tile_size = std::max(1, eig_param.n_ev_deflate / 3);
+    iter.push_back(solve_converged(tol));
+
+    auto space = reinterpret_cast<quda::deflation_space *>(eig_param.preserve_deflation_space);
+    if (space) {
+      evals.push_back(space->evals);
+      on_host.push_back(space->evecs[0].Location() == QUDA_CPU_FIELD_LOCATION);
+      delete space;
+      eig_param.preserve_deflation_space = nullptr;
+    }
+  }
+
+  ASSERT_EQ(evals.size(), 2u);
+  EXPECT_FALSE(on_host[0]);
+  EXPECT_TRUE(on_host[1]);
+  ASSERT_EQ(evals[0].size(), evals[1].size());
+  for (auto i = 0u; i < evals[0].size(); i++)
+    EXPECT_LE(std::abs(evals[0][i] - evals[1][i]), eig_param.tol * std::abs(evals[0][i])) << "eigenvalue " << i;
+
+  // the tiled projection only differs in the order of the reductions
+  EXPECT_LE(std::abs(iter[1] - iter[0]), 1);
+}
+
+// multigrid-preconditioned solves, which are only run with --inv-multigrid true
+class InvertMultigridTest : public InvertTest
+{
+public:
+  virtual void SetUp()
+  {
+    if (!inv_multigrid) GTEST_SKIP();
+    InvertTest::SetUp();
+    if (IsSkipped()) return;
+
+    // build the hierarchy in the precisions of the test
+    mg_inv_param.cuda_prec = ::testing::get<0>(param);
+    mg_inv_param.cuda_prec_sloppy = ::testing::get<1>(param);
+    mg_inv_param.cuda_prec_precondition = ::testing::get<2>(::testing::get<7>(param));
+    mg_inv_param.clover_cuda_prec = mg_inv_param.cuda_prec;
+    mg_inv_param.clover_cuda_prec_sloppy = mg_inv_param.cuda_prec_sloppy;
+    mg_inv_param.clover_cuda_prec_precondition = mg_inv_param.cuda_prec_precondition;
+  }
+};
+
+/**
+   @brief Read a multigrid checkpoint file
+   @param[in] filename The checkpoint file
+   @param[out] header The checkpoint header
+   @return The fields (prolongator and coarse links) in the checkpoint
+*/
+std::vector<std::vector<double>> read_checkpoint(const std::string &filename, quda::MGCheckpointHeader &header)
+{
+  std::vector<std::vector<double>> records;
+  FILE *fp = fopen(filename.c_str(), "rb");
+  if (!fp) return records;
+  if (fread(&header, sizeof(header), 1, fp) == 1) {
+    quda::MGCheckpointRecord record;
+    while (fread(&record, sizeof(record), 1, fp) == 1) {
+      std::vector<char> bytes(record.bytes);
+      if (fread(bytes.data(), 1, record.bytes, fp) != record.bytes) break;
+      if (record.precision == QUDA_DOUBLE_PRECISION) {
+        auto v = reinterpret_cast<const double *>(bytes.data());
+        records.emplace_back(v, v + record.bytes / sizeof(double));
+      } else {
+        auto v = reinterpret_cast<const float *>(bytes.data());
+        records.emplace_back(v, v + record.bytes / sizeof(float));
+      }
+    }
+  }
+  fclose(fp);
+  return records;
+}
+
+std::string checkpoint_filename(const std::string &prefix, int level)
+{
+  return prefix + "_level_" + std::to_string(level) + ".rank" + std::to_string(quda::comm_rank());
+}
+
+using InvertCheckpointTest = InvertMultigridTest;
+
+// a hierarchy restored from a checkpoint has the same prolongators and
+// coarse operators, and takes as many iterations, as the one that was
+// saved, while a checkpoint saved with different parameters is
+// rejected and the hierarchy set up instead
+TEST_P(InvertCheckpointTest, verify)
+{
+  ParamGuard guard;
+  auto tol = set_tol();
+
+  const std::string saved = "invert_test_checkpoint_saved";
+  const std::string restored = "invert_test_checkpoint_restored";
+  const std::string rebuilt = "invert_test_checkpoint_rebuilt";
+
+  strcpy(mg_param.checkpoint_infile, "");
+  strcpy(mg_param.checkpoint_outfile, saved.c_str());
+  auto iter_saved = solve_converged(tol);
+
+  // restore, and save the restored hierarchy to compare with the saved one
+  strcpy(mg_param.checkpoint_infile, saved.c_str());
+  strcpy(mg_param.checkpoint_outfile, restored.c_str());
+  auto iter_restored = solve_converged(tol);
+  EXPECT_LE(std::abs(iter_restored - iter_saved), iter_saved / 10 + 1);
+
+  for (int l = 0; l < mg_param.n_level - 1; l++) {
+    quda::MGCheckpointHeader header_saved, header_restored;
+    auto records_saved = read_checkpoint(checkpoint_filename(saved, l), header_saved);
+    auto records_restored = read_checkpoint(checkpoint_filename(restored, l), header_restored);
+    ASSERT_FALSE(records_saved.empty()) << "level " << l;
+    ASSERT_EQ(records_saved.size(), records_restored.size()) << "level " << l;
+    EXPECT_EQ(header_saved.param_key, header_restored.param_key);
+    EXPECT_EQ(header_saved.gauge_checksum, header_restored.gauge_checksum);
+
+    // fixed-point fields may be requantized on restore
+    for (auto i = 0u; i < records_saved.size(); i++) {
+      ASSERT_EQ(records_saved[i].size(), records_restored[i].size());
+      double max = 0.0, dev = 0.0;
+      for (auto j = 0u; j < records_saved[i].size(); j++) {
+        max = std::max(max, std::abs(records_saved[i][j]));
+        dev = std::max(dev, std::abs(records_saved[i][j] - records_restored[i][j]));
+      }
+      EXPECT_LE(dev, 1e-3 * max) << "level " << l << " record " << i;
+    }
+  }
+
+  // a different block size changes the parameter hash, and any
+  // attempt to restore the saved fields would fail on their sizes
+  strcpy(mg_param.checkpoint_infile, saved.c_str());
+  strcpy(mg_param.checkpoint_outfile, rebuilt.c_str());
+  mg_param.geo_block_size[0][3] *= 2;
+  solve_converged(tol);
+  {
+    quda::MGCheckpointHeader header_saved, header_rebuilt;
+    read_checkpoint(checkpoint_filename(saved, 0), header_saved);
+    EXPECT_FALSE(read_checkpoint(checkpoint_filename(rebuilt, 0), header_rebuilt).empty());
+    EXPECT_NE(header_saved.param_key, header_rebuilt.param_key);
+  }
+
+  for (auto &prefix : {saved, restored, rebuilt})
+    for (int l = 0; l < mg_param.n_level - 1; l++) remove(checkpoint_filename(prefix, l).c_str());
+}
+
+using InvertRefreshTest = InvertMultigridTest;
+
+// after the gauge field is perturbed, an incremental refresh converges
+// within a quarter more iterations than a full refresh, whether it
+// reuses the fine level or rebuilds it, in which case the coarser
+// level is checked in turn and reused
+TEST_P(InvertRefreshTest, verify)
+{
+  ParamGuard guard;
+  auto tol = set_tol();
+
+  // every solve refreshes its hierarchy on the same perturbed gauge field
+  auto gauge_initial = gauge_;
+  mg_update = [&](void *mg) {
+    std::copy(gauge_initial.begin(), gauge_initial.end(), gauge_.begin());
+    perturbHostGaugeField(gauge.data(), gauge_param.cpu_prec, 1e-3);
+    freeGaugeQuda();
+    loadGaugeQuda(gauge.data(), &gauge_param);
+    updateMultigridQuda(mg, &mg_param);
+  };
+
+  mg_param.thin_update_only = QUDA_BOOLEAN_FALSE;
+  mg_param.setup_refresh_incremental = QUDA_BOOLEAN_FALSE;
+  auto iter_full = solve_converged(tol);
+
+  // a level is reused unless its convergence factor has grown a thousandfold
+  mg_param.setup_refresh_incremental = QUDA_BOOLEAN_TRUE;
+  for (int i = 0; i < mg_param.n_level; i++) mg_param.setup_refresh_tol[i] = 1e3;
+  auto iter_reused = solve_converged(tol);
+  EXPECT_EQ(mg_param.setup_refresh_rebuilt[0], QUDA_BOOLEAN_FALSE);
+
+  // a negative tolerance forces the fine level to be rebuilt
+  mg_param.setup_refresh_tol[0] = -1.0;
+  auto iter_rebuilt = solve_converged(tol);
+  EXPECT_EQ(mg_param.setup_refresh_rebuilt[0], QUDA_BOOLEAN_TRUE);
+  if (mg_param.n_level > 2) EXPECT_EQ(mg_param.setup_refresh_rebuilt[1], QUDA_BOOLEAN_FALSE);
+
+  mg_update = nullptr;
+  std::copy(gauge_initial.begin(), gauge_initial.end(), gauge_.begin());
+  freeGaugeQuda();
+  loadGaugeQuda(gauge.data(), &gauge_param);
+
+  EXPECT_LE(iter_reused, iter_full + iter_full / 4 + 1);
+  EXPECT_LE(iter_rebuilt, iter_full + iter_full / 4 + 1);
+}
+
+using InvertAgglomerateTest = InvertMultigridTest;
+
+// agglomerating a coarse level onto fewer processes leaves the coarse
+// operator unchanged, so the solve takes as many iterations as without
+TEST_P(InvertAgglomerateTest, verify)
+{
+  bool agglomerate = false;
+  for (int i = 0; i < mg_param.n_level; i++)
+    for (int d = 0; d < 4; d++) agglomerate = agglomerate || mg_param.agglomerate_grid[i][d] > 1;
+  if (!agglomerate) GTEST_SKIP();
+
+  ParamGuard guard;
+  auto tol = set_tol();
+  auto iter = solve_converged(tol);
+
+  for (int i = 0; i < mg_param.n_level; i++)
+    for (int d = 0; d < 4; d++) mg_param.agglomerate_grid[i][d] = 1;
+  auto iter_ref = solve_converged(tol);
+
+  // the redundant coarse solves only differ in the order of the reductions
+  EXPECT_LE(iter, iter_ref + iter_ref / 10 + 1);
+}
+
+using InvertAdaptiveCycleTest = InvertMultigridTest;
+
+// the adaptive cycle skips the K-cycle whenever the V-cycle alone
+// reduces the coarse-grid residual below the threshold, and converges
+// within a tenth more outer iterations than the recursive cycle
+TEST_P(InvertAdaptiveCycleTest, verify)
+{
+  if (mg_param.n_level < 3 || mg_param.cycle_type[0] != QUDA_MG_CYCLE_ADAPTIVE) GTEST_SKIP();
+
+  ParamGuard guard;
+  auto tol = set_tol();
+
+  // a threshold any V-cycle of a working hierarchy meets at times
+  for (int i = 0; i < mg_param.n_level; i++) mg_param.cycle_adaptive_threshold[i] = 0.5;
+  auto iter = solve_converged(tol);
+  auto skipped = mg_param.cycle_adaptive_skipped[0];
+
+  // with a vanishing threshold every V-cycle is followed by the K-cycle
+  for (int i = 0; i < mg_param.n_level; i++) mg_param.cycle_adaptive_threshold[i] = 0.0;
+  auto iter_kcycle = solve_converged(tol);
+  auto skipped_kcycle = mg_param.cycle_adaptive_skipped[0];
+
+  for (int i = 0; i < mg_param.n_level; i++) mg_param.cycle_type[i] = QUDA_MG_CYCLE_RECURSIVE;
+  auto iter_ref = solve_converged(tol);
+
+  EXPECT_GT(skipped, 0);
+  EXPECT_EQ(skipped_kcycle, 0);
+  EXPECT_LE(iter, iter_ref + iter_ref / 10 + 1);
+  EXPECT_LE(iter_kcycle, iter_ref + iter_ref / 10 + 1);
+}
+
+// the fitted offset moves the aggregate boundaries onto the planes of
+// least density of a synthetic null space, whose density is small on
+// the two sites on either side of the planes x_d = offset (mod 4), so
+// that no other plane cuts as little; the offset 0 is kept as well
+TEST(AggregateOffsetTest, fit)
+{
+  const int X[4] = {8, 8, 8, 8};
+  const int geo_bs[4] = {4, 4, 4, 4};
+  const int expected[4] = {1, 2, 3, 0};
+
+  std::vector<double> rho(X[0] * X[1] * X[2] * X[3]);
+  for (auto i = 0u; i < rho.size(); i++) {
+    rho[i] = 1.0;
+    for (int d = 0, r = i; d < 4; d++) {
+      int x = r % X[d];
+      r /= X[d];
+      if (x % geo_bs[d] == expected[d] || (x + 1) % geo_bs[d] == expected[d]) rho[i] *= 1e-2;
+    }
+  }
+
+  int offset[4];
+  quda::fitAggregateOffset(offset, rho, X, geo_bs);
+  for (int d = 0; d < 4; d++)
+    EXPECT_EQ(offset[d], quda::comm_dim_partitioned(d) ? 0 : expected[d]) << "dimension " << d;
+}
+
+using InvertAggregationTest = InvertMultigridTest;
+
+// the multigrid verification fails the setup unless P P^\dagger leaves
+// the null-space vectors unchanged and the coarse operator equals
+// P^\dagger D P, so it checks the transfer and coarse operator with
+// aggregates that are shifted from the lattice origin, e.g., when
+// forced by QUDA_MG_AGGREGATE_OFFSET, both at setup and after a
+// refresh, which refits the offset
+TEST_P(InvertAggregationTest, verify)
+{
+  bool fit = false;
+  for (int i = 0; i < mg_param.n_level - 1; i++) fit = fit || mg_param.fit_aggregate_offset[i] == QUDA_BOOLEAN_TRUE;
+  if (!fit) GTEST_SKIP();
+
+  ParamGuard guard;
+  Restore<std::function<void(void *)>> hook(mg_update);
+  auto tol = set_tol();
+  mg_param.run_verify = QUDA_BOOLEAN_TRUE;
+  mg_param.thin_update_only = QUDA_BOOLEAN_FALSE;
+  mg_param.setup_refresh_incremental = QUDA_BOOLEAN_FALSE;
+  mg_update = [](void *mg) { updateMultigridQuda(mg, &mg_param); };
+  solve_converged(tol);
+}
+
+using InvertMultigridTuneTest = InvertMultigridTest;
+
+// the tuned multigrid parameters converge, and are cached in
+// QUDA_RESOURCE_PATH so that they are reused by a later tune
+TEST_P(InvertMultigridTuneTest, verify)
+{
+  if (!mg_tune || !getenv("QUDA_RESOURCE_PATH")) GTEST_SKIP();
+
+  ParamGuard guard;
+  auto tol = set_tol();
+
+  // start from an empty cache, which is only read by rank 0, so that the first solve tunes
+  if (quda::comm_rank() == 0) remove((std::string(getenv("QUDA_RESOURCE_PATH")) + "/mg_tunecache.json").c_str());
+
+  auto mg_param_initial = mg_param;
+  solve_converged(tol);
+  auto mg_param_tuned = mg_param;
+
+  double plaq[3];
+  plaqQuda(plaq);
+  auto key = quda::mgTuneKey(mg_param, inv_param, {xdim, ydim, zdim, tdim}, plaq[0]);
+
+  auto mg_param_cached = mg_param_initial;
+  quda::MGTuneResult result;
+  ASSERT_TRUE(quda::mgTuneCacheLoad(key, mg_param_cached, result));
+  EXPECT_TRUE(result.converged);
+  EXPECT_GT(result.iter, 0.0);
+
+  // tuning again from the initial parameters loads the cached ones
+  mg_param = mg_param_initial;
+  solve_converged(tol);
+
+  for (int i = 0; i < mg_param.n_level - 1; i++) {
+    for (int d = 0; d < 4; d++) {
+      EXPECT_EQ(mg_param_cached.geo_block_size[i][d], mg_param_tuned.geo_block_size[i][d]);
+      EXPECT_EQ(mg_param.geo_block_size[i][d], mg_param_tuned.geo_block_size[i][d]);
+    }
+    EXPECT_EQ(mg_param_cached.n_vec[i], mg_param_tuned.n_vec[i]);
+    EXPECT_EQ(mg_param_cached.setup_maxiter[i], mg_param_tuned.setup_maxiter[i]);
+    EXPECT_EQ(mg_param_cached.nu_pre[i], mg_param_tuned.nu_pre[i]);
+    EXPECT_EQ(mg_param_cached.nu_post[i], mg_param_tuned.nu_post[i]);
+    EXPECT_EQ(mg_param.n_vec[i], mg_param_tuned.n_vec[i]);
+    EXPECT_EQ(mg_param.setup_maxiter[i], mg_param_tuned.setup_maxiter[i]);
+    EXPECT_EQ(mg_param.nu_pre[i], mg_param_tuned.nu_pre[i]);
+    EXPECT_EQ(mg_param.nu_post[i], mg_param_tuned.nu_post[i]);
+  }
+}
+
 using ::testing::Combine;
 using ::testing::Values;
-auto normal_solvers
-  = Values(QUDA_CG_INVERTER, QUDA_CA_CG_INVERTER, QUDA_CG3_INVERTER, QUDA_PCG_INVERTER, QUDA_SD_INVERTER);
+auto normal_solvers = Values(QUDA_CG_INVERTER, QUDA_CA_CG_INVERTER, QUDA_CG3_INVERTER, QUDA_PCG_INVERTER,
+                             QUDA_SD_INVERTER, QUDA_BLOCK_CG_INVERTER);
 
 auto direct_solvers = Values(QUDA_CGNE_INVERTER, QUDA_CGNR_INVERTER, QUDA_CA_CGNE_INVERTER, QUDA_CA_CGNR_INVERTER,
                              QUDA_CG3NE_INVERTER, QUDA_CG3NR_INVERTER, QUDA_GCR_INVERTER, QUDA_CA_GCR_INVERTER,
@@ -171,6 +681,8 @@ auto no_schwarz = Combine(Values(QUDA_INVALID_SCHWARZ), Values(QUDA_INVALID_INVE
 
 auto no_heavy_quark = Values(QUDA_L2_RELATIVE_RESIDUAL);
 
+auto multigrid = Combine(Values(QUDA_INVALID_SCHWARZ), Values(QUDA_MG_INVERTER), Values(QUDA_HALF_PRECISION));
+
 // preconditioned normal solves
 INSTANTIATE_TEST_SUITE_P(NormalEvenOdd, InvertTest,
                          Combine(precisions, sloppy_precisions, normal_solvers,
@@ -231,3 +743,89 @@ INSTANTIATE_TEST_SUITE_P(HeavyQuarkEvenOdd, InvertTest,
                                  Values(QUDA_NORMOP_PC_SOLVE), Values(1), solution_accumulator_pipelines, no_schwarz,
                                  Values(QUDA_L2_RELATIVE_RESIDUAL | QUDA_HEAVY_QUARK_RESIDUAL, QUDA_HEAVY_QUARK_RESIDUAL)),
                          gettestname);
+
+// recycled multi-source solves
+INSTANTIATE_TEST_SUITE_P(RecycleNormalEvenOdd, InvertRecycleTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_CG_INVERTER),
+                                 Values(QUDA_MATPCDAG_MATPC_SOLUTION), Values(QUDA_NORMOP_PC_SOLVE), Values(1),
+                                 Values(1), no_schwarz, no_heavy_quark),
+                         gettestname);
+
+INSTANTIATE_TEST_SUITE_P(RecycleEvenOdd, InvertRecycleTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_GCR_INVERTER),
+                                 Values(QUDA_MATPC_SOLUTION), Values(QUDA_DIRECT_PC_SOLVE), Values(1), Values(1),
+                                 no_schwarz, no_heavy_quark),
+                         gettestname);
+
+// adaptive sloppy precision, starting from the half precision
+// preconditioner and promoting through single precision
+INSTANTIATE_TEST_SUITE_P(AdaptiveNormalEvenOdd, InvertAdaptiveTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_CG_INVERTER),
+                                 Values(QUDA_MATPCDAG_MATPC_SOLUTION), Values(QUDA_NORMOP_PC_SOLVE), Values(1),
+                                 Values(1),
+                                 Combine(Values(QUDA_INVALID_SCHWARZ), Values(QUDA_INVALID_INVERTER),
+                                         Values(QUDA_HALF_PRECISION)),
+                                 no_heavy_quark),
+                         gettestname);
+
+// deflated solves, with the deflation space in core and out of core
+INSTANTIATE_TEST_SUITE_P(DeflationNormalEvenOdd, InvertDeflationTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_CG_INVERTER),
+                                 Values(QUDA_MATPCDAG_MATPC_SOLUTION), Values(QUDA_NORMOP_PC_SOLVE), Values(1),
+                                 Values(1), no_schwarz, no_heavy_quark),
+                         gettestname);
+
+// Chebyshev smoothing of the (non-Hermitian) operator
+INSTANTIATE_TEST_SUITE_P(SmootherEvenOdd, InvertSmootherTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_CHEBYSHEV_INVERTER),
+                                 Values(QUDA_MATPC_SOLUTION), Values(QUDA_DIRECT_PC_SOLVE), Values(1), Values(1),
+                                 no_schwarz, no_heavy_quark),
+                         gettestname);
+
+INSTANTIATE_TEST_SUITE_P(SmootherFull, InvertSmootherTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_CHEBYSHEV_INVERTER),
+                                 Values(QUDA_MAT_SOLUTION), Values(QUDA_DIRECT_SOLVE), Values(1), Values(1), no_schwarz,
+                                 no_heavy_quark),
+                         gettestname);
+
+// multigrid solves restored from a checkpoint
+INSTANTIATE_TEST_SUITE_P(CheckpointEvenOdd, InvertCheckpointTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_GCR_INVERTER),
+                                 Values(QUDA_MAT_SOLUTION), Values(QUDA_DIRECT_PC_SOLVE), Values(1), Values(1),
+                                 multigrid, no_heavy_quark),
+                         gettestname);
+
+// multigrid solves after an incremental refresh
+INSTANTIATE_TEST_SUITE_P(RefreshEvenOdd, InvertRefreshTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_GCR_INVERTER),
+                                 Values(QUDA_MAT_SOLUTION), Values(QUDA_DIRECT_PC_SOLVE), Values(1), Values(1),
+                                 multigrid, no_heavy_quark),
+                         gettestname);
+
+// multigrid solves with an agglomerated coarse grid
+INSTANTIATE_TEST_SUITE_P(AgglomerateEvenOdd, InvertAgglomerateTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_GCR_INVERTER),
+                                 Values(QUDA_MAT_SOLUTION), Values(QUDA_DIRECT_PC_SOLVE), Values(1), Values(1),
+                                 multigrid, no_heavy_quark),
+                         gettestname);
+
+// multigrid solves with the adaptive cycle
+INSTANTIATE_TEST_SUITE_P(AdaptiveCycleEvenOdd, InvertAdaptiveCycleTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_GCR_INVERTER),
+                                 Values(QUDA_MAT_SOLUTION), Values(QUDA_DIRECT_PC_SOLVE), Values(1), Values(1),
+                                 multigrid, no_heavy_quark),
+                         gettestname);
+
+// multigrid solves with aggregates fitted to the null space
+INSTANTIATE_TEST_SUITE_P(AggregationEvenOdd, InvertAggregationTest,
+                         Combine(precisions, Values(QUDA_SINGLE_PRECISION), Values(QUDA_GCR_INVERTER),
+                                 Values(QUDA_MAT_SOLUTION), Values(QUDA_DIRECT_PC_SOLVE), Values(1), Values(1),
+                                 multigrid, no_heavy_quark),
+                         gettestname);
+
+// multigrid solves with tuned parameters
+INSTANTIATE_TEST_SUITE_P(MultigridTuneEvenOdd, InvertMultigridTuneTest,
+                         Combine(Values(QUDA_DOUBLE_PRECISION), Values(QUDA_SINGLE_PRECISION),
+                                 Values(QUDA_GCR_INVERTER), Values(QUDA_MAT_SOLUTION), Values(QUDA_DIRECT_PC_SOLVE),
+                                 Values(1), Values(1), multigrid, no_heavy_quark),
+                         gettestname);
@@ -3,6 +3,7 @@
 
 #include <instantiate.h>
 #include <color_spinor_field.h>
+#include <gauge_field.h>
 #include <misc.h>
 #include <qio_field.h> // for QIO routines
 #include <vector_io.h>
@@ -56,11 +57,26 @@ TEST_P(GaugeIOTest, verify)
 
   auto file = "dummy.lat";
 
+  // host field wrapping the gauge field, used to compute the SciDAC checksum locally
+  quda::GaugeFieldParam cpu_param(gauge_param, gauge);
+  quda::GaugeField cpu_gauge(cpu_param);
+  auto checksum = quda::ScidacChecksum(cpu_gauge);
+
   // write out the gauge field
   write_gauge_field(file, gauge, gauge_param.cpu_prec, gauge_param.X, 0, nullptr);
+  uint32_t checksum_write[2];
+  get_last_qio_checksum(checksum_write);
 
   // read it back
   read_gauge_field(file, gauge, gauge_param.cpu_prec, gauge_param.X, 0, nullptr);
+  uint32_t checksum_read[2];
+  get_last_qio_checksum(checksum_read);
+
+  // test the checksum computed by QUDA matches that of the record
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(checksum[i], checksum_write[i]);
+    EXPECT_EQ(checksum[i], checksum_read[i]);
+  }
 
   auto plaq_new = get_plaq();
 
@@ -74,6 +90,71 @@ TEST_P(GaugeIOTest, verify)
   for (int dir = 0; dir < 4; dir++) { host_free(gauge[dir]); }
 }
 
+// test prefetched gauge fields are identical to those read synchronously
+// (with more than one process, the prefetcher reads them when loaded)
+TEST_P(GaugeIOTest, prefetch)
+{
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  setWilsonGaugeParam(gauge_param);
+
+  gauge_param.cpu_prec = ::testing::get<0>(param);
+  if (!quda::is_enabled(gauge_param.cpu_prec)) GTEST_SKIP();
+  gauge_param.cuda_prec = gauge_param.cpu_prec;
+  gauge_param.cuda_prec_sloppy = gauge_param.cpu_prec;
+  gauge_param.cuda_prec_precondition = gauge_param.cpu_prec;
+  gauge_param.cuda_prec_eigensolver = gauge_param.cpu_prec;
+  gauge_param.t_boundary = QUDA_PERIODIC_T;
+
+  void *gauge[4];
+  for (int dir = 0; dir < 4; dir++) gauge[dir] = safe_malloc(V * gauge_site_size * host_gauge_data_type_size);
+
+  // write out two distinct configurations
+  const char *files[] = {"dummy_0.lat", "dummy_1.lat"};
+  for (auto file : files) {
+    constructHostGaugeField(gauge, gauge_param, 0, nullptr);
+    write_gauge_field(file, gauge, gauge_param.cpu_prec, gauge_param.X, 0, nullptr);
+  }
+
+  auto get_plaq = [&](void *gauge) {
+    loadGaugeQuda(gauge, &gauge_param);
+    std::array<double, 3> plaq;
+    plaqQuda(plaq.data());
+    return plaq;
+  };
+
+  // read synchronously first, since no other QIO I/O may be done while prefetching
+  uint32_t checksum_read[2][2];
+  std::array<double, 3> plaq_read[2];
+  for (int f = 0; f < 2; f++) {
+    read_gauge_field(files[f], gauge, gauge_param.cpu_prec, gauge_param.X, 0, nullptr);
+    get_last_qio_checksum(checksum_read[f]);
+    plaq_read[f] = get_plaq(gauge);
+    freeGaugeQuda();
+  }
+
+  prefetchGaugeQuda(files, 2, 1, &gauge_param);
+  for (int f = 0; f < 2; f++) {
+    void *gauge_prefetch = loadNextGaugeQuda(&gauge_param);
+    ASSERT_NE(gauge_prefetch, nullptr);
+    quda::GaugeFieldParam cpu_param(gauge_param, static_cast<void **>(gauge_prefetch));
+    quda::GaugeField cpu_gauge(cpu_param);
+    auto checksum = quda::ScidacChecksum(cpu_gauge);
+    std::array<double, 3> plaq_prefetch;
+    plaqQuda(plaq_prefetch.data());
+    freeGaugeQuda();
+
+    for (int i = 0; i < 2; i++) EXPECT_EQ(checksum[i], checksum_read[f][i]);
+    for (int i = 0; i < 3; i++) EXPECT_EQ(plaq_prefetch[i], plaq_read[f][i]);
+  }
+  EXPECT_EQ(loadNextGaugeQuda(&gauge_param), nullptr);
+  endPrefetchGaugeQuda();
+
+  for (auto file : files)
+    if (remove(file) != 0) errorQuda("Error deleting file");
+
+  for (int dir = 0; dir < 4; dir++) { host_free(gauge[dir]); }
+}
+
 using cs_test_t = ::testing::tuple<QudaSiteSubset, QudaSiteSubset, QudaParity, bool, QudaPrecision, QudaPrecision, int,
                                    bool, QudaFieldLocation>;
 
@@ -12,6 +12,8 @@
 // include because of nasty globals used in the tests
 #include <dslash_reference.h>
 #include <dirac_quda.h>
+#include <transfer.h>
+#include <blas_lapack.h>
 #include <tune_quda.h>
 #include <gauge_tools.h>
 #include <gtest/gtest.h>
@@ -134,6 +136,9 @@ DiracCoarsePC *dirac_pc;
 
 TEST(multi_rhs_test, verify)
 {
+  // the host benchmarks are verified separately
+  if (test_type > 7) GTEST_SKIP();
+
   printfQuda("\nTesting Multi-RHS correctness...\n\n");
 
   blas::zero(xD);
@@ -181,10 +186,279 @@ TEST(multi_rhs_test, verify)
   }
 }
 
+/**
+   The inputs to the host construction of the next coarser operator
+   from the present one: a host copy of the present operator, random
+   null-space vectors and the transfer operator they define.  The
+   number of coarse colors is set by the second-level --mg-nvec.
+*/
+struct CoarseOpSetup {
+  std::shared_ptr<GaugeField> Y_h;
+  std::shared_ptr<GaugeField> X_h;
+  std::shared_ptr<GaugeField> Xinv_h;
+  std::shared_ptr<GaugeField> Yhat_h;
+  std::unique_ptr<DiracCoarse> dirac_h;
+  std::vector<ColorSpinorField> B;
+  std::unique_ptr<Transfer> T;
+  int n_coarse;
+  int geo_bs[QUDA_MAX_DIM];
+  DiracParam param_coarse;
+
+  CoarseOpSetup()
+  {
+    auto create_host_copy = [](const GaugeField &U) {
+      GaugeFieldParam param(U);
+      param.location = QUDA_CPU_FIELD_LOCATION;
+      param.order = QUDA_QDP_GAUGE_ORDER;
+      param.pad = 0;
+      auto U_h = std::make_shared<GaugeField>(param);
+      U_h->copy(U);
+      return U_h;
+    };
+
+    Y_h = create_host_copy(*Y_d);
+    X_h = create_host_copy(*X_d);
+    Xinv_h = create_host_copy(*Xinv_d);
+    Yhat_h = create_host_copy(*Yhat_d);
+
+    DiracParam param;
+    param.kappa = 1.0;
+    param.dagger = QUDA_DAG_NO;
+    param.matpcType = QUDA_MATPC_EVEN_EVEN;
+    dirac_h = std::make_unique<DiracCoarse>(param, Y_h, X_h, Xinv_h, Yhat_h, Y_d, X_d, Xinv_d, Yhat_d);
+
+    // host null-space vectors
+    ColorSpinorParam cs_param(xD[0]);
+    cs_param.location = QUDA_CPU_FIELD_LOCATION;
+    cs_param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    cs_param.setPrecision(prec_sloppy);
+    cs_param.create = QUDA_NULL_FIELD_CREATE;
+    n_coarse = nvec[1] == 0 ? Ncolor : nvec[1];
+    B = std::vector<ColorSpinorField>(n_coarse, cs_param);
+    {
+      ColorSpinorField tmp(xD[0]);
+      quda::RNG rng(tmp, 4321);
+      for (auto &b : B) {
+        spinorNoise(tmp, rng, QUDA_NOISE_UNIFORM);
+        b.copy(tmp);
+      }
+    }
+
+    for (int d = 0; d < 4; d++) geo_bs[d] = geo_block_size[1][d] == 0 ? 2 : geo_block_size[1][d];
+    T = std::make_unique<Transfer>(B, n_coarse, 1, false, geo_bs, 1, prec_sloppy, QUDA_TRANSFER_AGGREGATE);
+
+    param_coarse.kappa = 1.0;
+    param_coarse.dagger = QUDA_DAG_NO;
+    param_coarse.matpcType = QUDA_MATPC_EVEN_EVEN;
+    param_coarse.transfer = T.get();
+    param_coarse.dirac = dirac_h.get();
+  }
+};
+
+// the host coarse links accumulated over aggregates agree with those
+// accumulated over fine-grid sites
+TEST(coarse_op_test, verify)
+{
+  if (test_type != 8) GTEST_SKIP();
+
+  printfQuda("\nTesting host coarse operator construction...\n\n");
+
+  CoarseOpSetup setup;
+  DiracCoarse coarse(setup.param_coarse, false);
+
+  // the fine-site accumulation is selected with QUDA_ENABLE_COARSE_AGGREGATE_PARALLEL=0
+  auto enable_env = getenv("QUDA_ENABLE_COARSE_AGGREGATE_PARALLEL");
+  std::string enable = enable_env ? enable_env : "";
+  setenv("QUDA_ENABLE_COARSE_AGGREGATE_PARALLEL", "0", 1);
+  DiracCoarse coarse_ref(setup.param_coarse, false);
+  if (enable_env)
+    setenv("QUDA_ENABLE_COARSE_AGGREGATE_PARALLEL", enable.c_str(), 1);
+  else
+    unsetenv("QUDA_ENABLE_COARSE_AGGREGATE_PARALLEL");
+
+  auto in_d = xD[0].create_coarse(setup.geo_bs, 1, setup.n_coarse, prec_sloppy, QUDA_CUDA_FIELD_LOCATION);
+  {
+    quda::RNG rng(in_d, 5678);
+    spinorNoise(in_d, rng, QUDA_NOISE_GAUSS);
+  }
+  ColorSpinorParam param(in_d);
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.create = QUDA_NULL_FIELD_CREATE;
+  ColorSpinorField in(param);
+  ColorSpinorField out(param);
+  ColorSpinorField out_ref(param);
+  in.copy(in_d);
+
+  auto tol = prec_sloppy == QUDA_DOUBLE_PRECISION ? 1e-12 : prec_sloppy == QUDA_SINGLE_PRECISION ? 1e-5 : 1e-3;
+
+  // the dslash applies the coarse links Y and the clover the coarse clover X
+  for (int op = 0; op < 2; op++) {
+    if (op == 0) {
+      coarse.Dslash(out.Even(), in.Odd(), QUDA_EVEN_PARITY);
+      coarse_ref.Dslash(out_ref.Even(), in.Odd(), QUDA_EVEN_PARITY);
+    } else {
+      coarse.Clover(out.Even(), in.Even(), QUDA_EVEN_PARITY);
+      coarse_ref.Clover(out_ref.Even(), in.Even(), QUDA_EVEN_PARITY);
+    }
+
+    auto x2 = blas::norm2(out_ref.Even());
+    auto l2_dev = blas::xmyNorm(out.Even(), out_ref.Even());
+    EXPECT_LE(sqrt(l2_dev / x2), tol) << (op == 0 ? "coarse links Y" : "coarse clover X");
+  }
+}
+
+/**
+   Benchmark the host construction of the next coarser operator from
+   the present one, i.e., the CPU-location multigrid setup: the coarse
+   links (UV and VUV), followed by Xinv and Yhat.
+*/
+double benchmark_coarse_op(const int niter)
+{
+  CoarseOpSetup setup;
+
+  host_timer_t host_timer;
+  host_timer.start();
+  for (int i = 0; i < niter; ++i) DiracCoarse coarse(setup.param_coarse, false);
+  host_timer.stop();
+
+  printfQuda("Ncolor = %2d -> %2d, coarse operator construction: %e s per build\n", Ncolor, setup.n_coarse,
+             host_timer.last() / niter);
+
+  return host_timer.last();
+}
+
+/**
+   The inputs and outputs of the batched inversion of the coarse
+   clover field, on the host in QDP order and on the device in MILC
+   order, as used to form Xinv.  The batched inverse, as
+   calculateYhat, requires at least single precision.  The random
+   clover field is made diagonally dominant, as the coarse clover is,
+   so that it is well conditioned.
+*/
+struct InvertXSetup {
+  std::unique_ptr<GaugeField> X_h;
+  std::unique_ptr<GaugeField> Xinv_h;
+  std::unique_ptr<GaugeField> X_aos;
+  std::unique_ptr<GaugeField> Xinv_aos;
+
+  template <typename Float> void shift_diagonal(GaugeField &X)
+  {
+    const int n = X.Ncolor();
+    auto x = X.data<Float *>(0);
+    // the norm of a Gaussian random complex n x n matrix is about 2 sqrt(2 n)
+    Float shift = 4.0 * sqrt(2.0 * n);
+    for (size_t i = 0; i < X.Volume(); i++)
+      for (int c = 0; c < n; c++) x[2 * ((i * n + c) * n + c)] += shift;
+  }
+
+  InvertXSetup()
+  {
+    auto precision = std::max(X_d->Precision(), QUDA_SINGLE_PRECISION);
+
+    GaugeFieldParam param(*X_d);
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.order = QUDA_QDP_GAUGE_ORDER;
+    param.pad = 0;
+    param.setPrecision(precision);
+    X_h = std::make_unique<GaugeField>(param);
+    Xinv_h = std::make_unique<GaugeField>(param);
+    X_h->copy(*X_d);
+    if (precision == QUDA_DOUBLE_PRECISION)
+      shift_diagonal<double>(*X_h);
+    else
+      shift_diagonal<float>(*X_h);
+
+    // the native batched inverse requires a contiguous matrix per site
+    GaugeFieldParam aos_param(*X_d);
+    aos_param.order = QUDA_MILC_GAUGE_ORDER;
+    aos_param.setPrecision(precision);
+    X_aos = std::make_unique<GaugeField>(aos_param);
+    Xinv_aos = std::make_unique<GaugeField>(aos_param);
+    X_aos->copy(*X_h);
+  }
+
+  long long invert_native()
+  {
+    return blas_lapack::native::BatchInvertMatrix(Xinv_aos->data(), X_aos->data(), X_aos->Ncolor(), X_aos->Volume(),
+                                                  X_aos->Precision(), QUDA_CUDA_FIELD_LOCATION);
+  }
+
+  long long invert_generic()
+  {
+    return blas_lapack::generic::BatchInvertMatrix(Xinv_h->data<void *>(0), X_h->data<void *>(0), X_h->Ncolor(),
+                                                   X_h->Volume(), X_h->Precision(), QUDA_CPU_FIELD_LOCATION);
+  }
+};
+
+template <typename Float> double max_deviation(const GaugeField &a, const GaugeField &b)
+{
+  auto a_ = a.data<Float *>(0);
+  auto b_ = b.data<Float *>(0);
+  double dev = 0.0;
+  for (size_t i = 0; i < 2 * a.Volume() * a.Ncolor() * a.Ncolor(); i++)
+    dev = std::max(dev, std::abs(static_cast<double>(a_[i]) - static_cast<double>(b_[i])));
+  return dev;
+}
+
+// the host batched inverse agrees with the native one
+TEST(invert_x_test, verify)
+{
+  if (test_type != 9) GTEST_SKIP();
+
+  printfQuda("\nTesting host batched inverse...\n\n");
+
+  InvertXSetup setup;
+  setup.invert_native();
+  setup.invert_generic();
+
+  GaugeFieldParam param(*setup.Xinv_h);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  GaugeField Xinv_ref(param);
+  Xinv_ref.copy(*setup.Xinv_aos);
+
+  auto dev = setup.Xinv_h->Precision() == QUDA_DOUBLE_PRECISION ? max_deviation<double>(*setup.Xinv_h, Xinv_ref) :
+                                                                   max_deviation<float>(*setup.Xinv_h, Xinv_ref);
+  auto tol = setup.Xinv_h->Precision() == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+  EXPECT_LE(dev / Xinv_ref.abs_max(), tol);
+}
+
+/**
+   Benchmark the batched inversion of the coarse clover field, as used
+   to form Xinv, on the host (generic) path.  For reference the
+   throughput of the native path is also reported.
+*/
+double benchmark_invert_x(const int niter)
+{
+  InvertXSetup setup;
+  const int n = setup.X_h->Ncolor();
+  const uint64_t batch = setup.X_h->Volume();
+
+  device_timer_t device_timer;
+  device_timer.start();
+  long long flops_native = 0;
+  for (int i = 0; i < niter; ++i) flops_native += setup.invert_native();
+  device_timer.stop();
+  printfQuda("n = %3d, batch = %lu, native BatchInvertMatrix: Gflop/s = %6.1f\n", n, batch,
+             1e-9 * flops_native / device_timer.last());
+
+  host_timer_t host_timer;
+  host_timer.start();
+  long long flops = 0;
+  for (int i = 0; i < niter; ++i) flops += setup.invert_generic();
+  host_timer.stop();
+  Tunable::flops_global(Tunable::flops_global() + flops);
+
+  return host_timer.last();
+}
+
 double benchmark(int test, const int niter)
 {
   printfQuda("\nBenchmarking %s precision with %d iterations...\n\n", get_prec_str(prec), niter);
 
+  if (test == 8) return benchmark_coarse_op(niter);
+  if (test == 9) return benchmark_invert_x(niter);
+
   device_timer_t device_timer;
   device_timer.start();
 
@@ -224,7 +498,8 @@ double benchmark(int test, const int niter)
   return device_timer.last();
 }
 
-const char *names[] = {"Dslash", "Mat", "Clover", "MatDag", "MatDagMat", "MatPC", "MatPCDag", "MatPCDagMatPC"};
+const char *names[] = {"Dslash", "Mat",      "Clover",        "MatDag",     "MatDagMat",
+                       "MatPC",  "MatPCDag", "MatPCDagMatPC", "CoarseOpCPU", "InvertXCPU"};
 
 int main(int argc, char **argv)
 {
@@ -240,8 +515,10 @@ int main(int argc, char **argv)
   // command line options
   auto app = make_app();
   add_multigrid_option_group(app);
-  CLI::TransformPairs<int> test_type_map {{"Dslash", 0},    {"Mat", 1},   {"Clover", 2},   {"MatDag", 3},
-                                          {"MatDagMat", 4}, {"MatPC", 5}, {"MatPCDag", 6}, {"MatPCDagMatPC", 7}};
+  CLI::TransformPairs<int> test_type_map {{"Dslash", 0},        {"Mat", 1},        {"Clover", 2},
+                                          {"MatDag", 3},        {"MatDagMat", 4},  {"MatPC", 5},
+                                          {"MatPCDag", 6},      {"MatPCDagMatPC", 7}, {"CoarseOpCPU", 8},
+                                          {"InvertXCPU", 9}};
   app->add_option("--test", test_type, "Test method")->transform(CLI::CheckedTransformer(test_type_map));
 
   try {
@@ -51,6 +51,7 @@ std::string gauge_outfile;
 int Nsrc = 1;
 int Msrc = 1;
 int Nsrc_tile = 1;
+int Nsrc_rank = 0;
 int Msrc_tile = 1;
 int niter = 100;
 int nrepeat = 1;
@@ -65,11 +66,19 @@ double ca_lambda_min_precondition = 0.0;
 double ca_lambda_max_precondition = -1.0;
 int pipeline = 0;
 int solution_accumulator_pipeline = 0;
+int recycle_max_dim = 0;
+int recycle_block_size = 1;
 int test_type = 0;
 quda::mgarray<int> nvec = {};
 quda::mgarray<int> nvec_batch = {};
 quda::mgarray<std::string> mg_vec_infile;
 quda::mgarray<std::string> mg_vec_outfile;
+std::string mg_checkpoint_infile;
+std::string mg_checkpoint_outfile;
+bool mg_tune = false;
+int mg_tune_n_probe = 2;
+int mg_tune_n_solve = 12;
+std::string mg_tune_outfile;
 quda::mgarray<bool> mg_vec_partfile = {};
 QudaInverterType inv_type;
 bool inv_deflate = false;
@@ -121,6 +130,7 @@ double tol_precondition = 1e-1;
 double tol_hq = 0.;
 double reliable_delta = 0.1;
 bool alternative_reliable = false;
+bool adaptive_precision = false;
 QudaTwistFlavorType twist_flavor = QUDA_TWIST_SINGLET;
 QudaMassNormalization normalization = QUDA_KAPPA_NORMALIZATION;
 QudaMatPCType matpc_type = QUDA_MATPC_EVEN_EVEN;
@@ -143,6 +153,7 @@ quda::mgarray<int> nu_pre = {};
 quda::mgarray<int> nu_post = {};
 quda::mgarray<int> n_block_ortho = {};
 quda::mgarray<bool> block_ortho_two_pass = {};
+quda::mgarray<bool> mg_fit_aggregate_offset = {};
 quda::mgarray<double> mu_factor = {};
 quda::mgarray<QudaVerbosity> mg_verbosity = {};
 quda::mgarray<bool> mg_setup_use_mma = {};
@@ -154,6 +165,8 @@ quda::mgarray<int> num_setup_iter = {};
 quda::mgarray<double> setup_tol = {};
 quda::mgarray<int> setup_maxiter = {};
 quda::mgarray<int> setup_maxiter_refresh = {};
+bool setup_refresh_incremental = false;
+quda::mgarray<double> setup_refresh_tol = {};
 quda::mgarray<QudaCABasis> setup_ca_basis = {};
 quda::mgarray<int> setup_ca_basis_size = {};
 quda::mgarray<double> setup_ca_lambda_min = {};
@@ -179,6 +192,8 @@ bool generate_nullspace = true;
 bool generate_all_levels = true;
 quda::mgarray<QudaSchwarzType> mg_schwarz_type = {};
 quda::mgarray<int> mg_schwarz_cycle = {};
+quda::mgarray<QudaMultigridCycleType> mg_cycle_type = {};
+quda::mgarray<double> mg_cycle_adaptive_threshold = {};
 bool mg_evolve_thin_updates = false;
 
 // Aggregation type for the top level of staggered
@@ -186,6 +201,7 @@ QudaTransferType staggered_transfer_type = QUDA_TRANSFER_OPTIMIZED_KD;
 
 // we only actually support 4 here currently
 quda::mgarray<std::array<int, 4>> geo_block_size = {};
+quda::mgarray<std::array<int, 4>> agglomerate_grid = {};
 
 bool mg_allow_truncation = false;
 bool mg_staggered_kd_dagger_approximation = false;
@@ -220,6 +236,12 @@ int eig_n_kr = 32;
 int eig_n_conv = -1;        // If unchanged, will be set to n_ev
 int eig_n_ev_deflate = -1;  // If unchanged, will be set to n_conv
 int eig_batched_rotate = 0; // If unchanged, will be set to maximum
+bool eig_deflation_out_of_core = false;
+int eig_deflation_tile_size = 64;
+bool eig_deflation_refine = false;
+int eig_deflation_refine_sweeps = 4;
+bool eig_precise_refine = false;
+double eig_tol_sloppy = 1e-6;
 bool eig_require_convergence = true;
 int eig_check_interval = 10;
 int eig_max_restarts = 1000;
@@ -227,6 +249,7 @@ int eig_max_ortho_attempts = 10;
 double eig_tol = 1e-6;
 double eig_qr_tol = 1e-11;
 bool eig_use_eigen_qr = true;
+bool eig_use_arrow_solver = true;
 bool eig_use_poly_acc = true;
 int eig_poly_deg = 100;
 double eig_amin = 0.1;
@@ -393,7 +416,9 @@ namespace
                                                            {"ca-cg", QUDA_CA_CG_INVERTER},
                                                            {"ca-cgne", QUDA_CA_CGNE_INVERTER},
                                                            {"ca-cgnr", QUDA_CA_CGNR_INVERTER},
-                                                           {"ca-gcr", QUDA_CA_GCR_INVERTER}};
+                                                           {"ca-gcr", QUDA_CA_GCR_INVERTER},
+                                                           {"block-cg", QUDA_BLOCK_CG_INVERTER},
+                                                           {"chebyshev", QUDA_CHEBYSHEV_INVERTER}};
 
   CLI::TransformPairs<QudaPrecision> precision_map {{"double", QUDA_DOUBLE_PRECISION},
                                                     {"single", QUDA_SINGLE_PRECISION},
@@ -417,7 +442,8 @@ namespace
                                                  {"blktrlm", QUDA_EIG_BLK_TR_LANCZOS},
                                                  {"trlm-3d", QUDA_EIG_TR_LANCZOS_3D},
                                                  {"iram", QUDA_EIG_IR_ARNOLDI},
-                                                 {"blkiram", QUDA_EIG_BLK_IR_ARNOLDI}};
+                                                 {"blkiram", QUDA_EIG_BLK_IR_ARNOLDI},
+                                                 {"lobpcg", QUDA_EIG_LOBPCG}};
 
   CLI::TransformPairs<QudaTransferType> transfer_type_map {
     {"aggregate", QUDA_TRANSFER_AGGREGATE},
@@ -468,6 +494,10 @@ namespace
 
   CLI::TransformPairs<QudaSetupType> setup_type_map {{"test", QUDA_TEST_VECTOR_SETUP}, {"null", QUDA_TEST_VECTOR_SETUP}};
 
+  CLI::TransformPairs<QudaMultigridCycleType> cycle_type_map {{"vcycle", QUDA_MG_CYCLE_VCYCLE},
+                                                              {"recursive", QUDA_MG_CYCLE_RECURSIVE},
+                                                              {"adaptive", QUDA_MG_CYCLE_ADAPTIVE}};
+
   CLI::TransformPairs<QudaExtLibType> extlib_map {{"eigen", QUDA_EIGEN_EXTLIB}};
 
   CLI::TransformPairs<QudaContractType> contract_type_map {{"dr-ft-t", QUDA_CONTRACT_TYPE_DR_FT_T},
@@ -482,6 +512,9 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
   quda_app->option_defaults()->always_capture_default();
 
   quda_app->add_option("--alternative-reliable", alternative_reliable, "use alternative reliable updates");
+  quda_app->add_option("--adaptive-precision", adaptive_precision,
+                       "Start CG in the preconditioner precision and promote the sloppy precision on stagnation "
+                       "(default false)");
   quda_app->add_option("--anisotropy", anisotropy, "Temporal anisotropy factor (default 1.0)");
 
   quda_app->add_option("--ca-basis-type", ca_basis, "The basis to use for CA solvers (default chebyshev)")
@@ -621,6 +654,9 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
   quda_app->add_option("--nsrc", Nsrc,
                        "How many spinors to apply the dslash to simultaneusly (experimental for staggered only)");
   quda_app->add_option("--nsrc-tile", Nsrc_tile, "Set the Nsrc tile size (where applicable)");
+  quda_app->add_option("--nsrc-rank", Nsrc_rank,
+                       "The number of linearly independent sources, with the remainder formed from linear "
+                       "combinations of these (default 0, all sources independent)");
 
   quda_app->add_option("--pipeline", pipeline,
                        "The pipeline length for fused operations in GCR, BiCGstab-l (default 0, no pipelining)");
@@ -671,6 +707,11 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
   quda_app->add_option("--recon-sloppy", link_recon_sloppy, "Sloppy link reconstruction type")
     ->transform(CLI::QUDACheckedTransformer(reconstruct_type_map));
 
+  quda_app->add_option("--recycle-max-dim", recycle_max_dim,
+                       "Maximum size of the solution basis recycled across sources in a multi-source solve (default 0, "
+                       "disabled)");
+  quda_app->add_option("--recycle-block-size", recycle_block_size,
+                       "Number of sources solved together between recycled basis updates (default 1)");
   quda_app->add_option("--reliable-delta", reliable_delta, "Set reliable update delta factor");
   quda_app->add_option("--save-gauge", gauge_outfile,
                        "Save gauge field \" file \" for the test (requires QIO, heatbath test only)");
@@ -785,6 +826,9 @@ void add_eigen_option_group(std::shared_ptr<QUDAApp> quda_app)
                       "Cross check the device data against ARPACK (requires ARPACK, default false)");
   opgroup->add_option("--eig-use-eigen-qr", eig_use_eigen_qr,
                       "Use Eigen to eigensolve the upper Hessenberg in IRAM, else use QUDA's QR code. (default true)");
+  opgroup->add_option("--eig-use-arrow-solver", eig_use_arrow_solver,
+                      "Use the structured divide-and-conquer solver for the arrow matrix in TRLM, else use Eigen's "
+                      "dense solver (default true)");
   opgroup->add_option("--eig-compute-svd", eig_compute_svd,
                       "Solve the MdagM problem, use to compute SVD of M (default false)");
 
@@ -809,6 +853,21 @@ void add_eigen_option_group(std::shared_ptr<QUDAApp> quda_app)
   opgroup->add_option("--eig-n-kr", eig_n_kr, "The size of the Krylov subspace to use in the eigensolver");
   opgroup->add_option("--eig-batched-rotate", eig_batched_rotate,
                       "The maximum number of extra eigenvectors the solver may allocate to perform a Ritz rotation.");
+  opgroup->add_option("--eig-deflation-out-of-core", eig_deflation_out_of_core,
+                      "Keep the preserved deflation space in host memory, streaming it to the device when deflating "
+                      "(default false)");
+  opgroup->add_option("--eig-deflation-tile-size", eig_deflation_tile_size,
+                      "The number of vectors streamed to the device at a time in out-of-core deflation (default 64)");
+  opgroup->add_option("--eig-deflation-refine", eig_deflation_refine,
+                      "Refine a preserved deflation space on the present operator, falling back to a full eigensolve "
+                      "if it does not converge (default false)");
+  opgroup->add_option("--eig-deflation-refine-sweeps", eig_deflation_refine_sweeps,
+                      "The maximum number of sweeps used to refine a deflation space (default 4)");
+  opgroup->add_option("--eig-precise-refine", eig_precise_refine,
+                      "Run the eigensolver in the eigensolver precision to --eig-tol-sloppy, then refine the "
+                      "eigenpairs in the solver precision to --eig-tol (default false)");
+  opgroup->add_option("--eig-tol-sloppy", eig_tol_sloppy,
+                      "The tolerance of the eigensolver when using --eig-precise-refine (default 1e-6)");
   opgroup->add_option("--eig-poly-deg", eig_poly_deg, "TODO");
   opgroup->add_option(
     "--eig-require-convergence",
@@ -893,6 +952,9 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
                       "Let multigrid coarsening trucate improvement terms in operators, e.g. dropping asqtad long "
                       "links in a dimension with an aggreation length smaller than 3 (default false)");
 
+  quda_app->add_mgoption(
+    opgroup, "--mg-agglomerate-grid", agglomerate_grid, CLI::Validator(),
+    "Set the grid of sub-partitions onto which a multigrid level and all coarser levels are agglomerated (default 1 1 1 1)");
   quda_app->add_mgoption(
     opgroup, "--mg-block-size", geo_block_size, CLI::Validator(),
     "Set the geometric block size for the each multigrid levels transfer operator (default 4 4 4 4)");
@@ -920,6 +982,11 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
                          "The coarse solver maxiter for each level (default 100)");
   quda_app->add_mgoption(opgroup, "--mg-coarse-solver-tol", coarse_solver_tol, CLI::PositiveNumber,
                          "The coarse solver tolerance for each level (default 0.25, only for levels 1+)");
+  quda_app->add_mgoption(opgroup, "--mg-cycle-type", mg_cycle_type, CLI::QUDACheckedTransformer(cycle_type_map),
+                         "The type of cycle on each level (vcycle, recursive (default), adaptive), where adaptive only "
+                         "runs the coarse solver as a K-cycle when a V-cycle alone does not reduce the residual enough");
+  quda_app->add_mgoption(opgroup, "--mg-cycle-adaptive-threshold", mg_cycle_adaptive_threshold, CLI::PositiveNumber,
+                         "The V-cycle residual reduction above which the adaptive cycle runs the K-cycle (default 0.25)");
   quda_app->add_mgoption(opgroup, "--mg-eig", mg_eig, CLI::Validator(),
                          "Use the eigensolver on this level (default false)");
   quda_app->add_mgoption(opgroup, "--mg-eig-amax", mg_eig_amax, CLI::PositiveNumber,
@@ -996,6 +1063,19 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
                          "Load the vectors <file> for the multigrid_test (requires QIO)");
   quda_app->add_mgoption(opgroup, "--mg-save-vec", mg_vec_outfile, CLI::Validator(),
                          "Save the generated null-space vectors <file> from the multigrid_test (requires QIO)");
+  opgroup->add_option("--mg-load-checkpoint", mg_checkpoint_infile,
+                      "Restore the multigrid hierarchy from the checkpoint with filename prefix <file>, falling back "
+                      "to a regular setup if the checkpoint is incompatible");
+  opgroup->add_option("--mg-save-checkpoint", mg_checkpoint_outfile,
+                      "Save the multigrid hierarchy to a checkpoint with filename prefix <file>");
+  opgroup->add_option("--mg-tune", mg_tune,
+                      "Tune the multigrid parameters before the solve, or use those cached in QUDA_RESOURCE_PATH for "
+                      "this ensemble (default false)");
+  opgroup->add_option("--mg-tune-n-probe", mg_tune_n_probe,
+                      "The number of random right-hand sides each candidate is measured on when tuning (default 2)");
+  opgroup->add_option("--mg-tune-n-solve", mg_tune_n_solve,
+                      "The number of solves the setup time is amortized over when tuning (default 12)");
+  opgroup->add_option("--mg-tune-outfile", mg_tune_outfile, "Write the tuned multigrid parameters as JSON to <file>");
   quda_app->add_mgoption(
     opgroup, "--mg-save-partfile", mg_vec_partfile, CLI::Validator(),
     "Whether to save near-null vectors as partfile instead of singlefile (default false; singlefile)");
@@ -1016,6 +1096,9 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
   quda_app->add_mgoption(
     opgroup, "--mg-block-ortho-two-pass", block_ortho_two_pass, CLI::Validator(),
     "Whether to use a two block-orthogonalization when using fixed-point null space vectors (default true)");
+  quda_app->add_mgoption(opgroup, "--mg-fit-aggregate-offset", mg_fit_aggregate_offset, CLI::Validator(),
+                         "Whether to shift the aggregate boundaries by a global offset fitted to the null-space "
+                         "vectors in the unpartitioned dimensions (default false)");
   quda_app->add_mgoption(opgroup, "--mg-nu-post", nu_post, CLI::PositiveNumber,
                          "The number of post-smoother applications to do at a given multigrid level (default 2)");
   quda_app->add_mgoption(opgroup, "--mg-nu-pre", nu_pre, CLI::PositiveNumber,
@@ -1064,6 +1147,11 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
   quda_app->add_mgoption(
     opgroup, "--mg-setup-maxiter-refresh", setup_maxiter_refresh, CLI::Validator(),
     "The maximum number of solver iterations to use when refreshing the pre-existing null space vectors (default 100)");
+  opgroup->add_option("--mg-setup-refresh-incremental", setup_refresh_incremental,
+                      "Only rebuild the levels whose probed convergence factor has degraded on a refresh (default false)");
+  quda_app->add_mgoption(
+    opgroup, "--mg-setup-refresh-tol", setup_refresh_tol, CLI::Validator(),
+    "The relative increase of the probed convergence factor beyond which a level is rebuilt on an incremental refresh (default 0.1)");
   quda_app->add_mgoption(opgroup, "--mg-setup-tol", setup_tol, CLI::Validator(),
                          "The tolerance to use for the setup of multigrid (default 5e-6)");
 
@@ -1085,11 +1173,12 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
                          CLI::QUDACheckedTransformer(ca_basis_map),
                          "The basis to use for CA solver smoothers in multigrid (default power)");
   quda_app->add_mgoption(opgroup, "--mg-smoother-cheby-basis-eig-max", smoother_solver_ca_lambda_max, CLI::PositiveNumber,
-                         "Conservative estimate of largest eigenvalue for CA solvers used as a multigrid smoother "
-                         "(default is to guess with power iterations)");
+                         "Conservative estimate of largest eigenvalue for CA and Chebyshev solvers used as a multigrid "
+                         "smoother (default is to guess with power iterations)");
   quda_app->add_mgoption(
     opgroup, "--mg-smoother-cheby-basis-eig-min", smoother_solver_ca_lambda_min, CLI::PositiveNumber,
-    "Conservative estimate of smallest eigenvalue for CA solvers used as a multigrid smoother (default 0)");
+    "Conservative estimate of smallest eigenvalue for CA and Chebyshev solvers used as a multigrid smoother (default 0, "
+    "which for the Chebyshev smoother selects a tenth of the largest eigenvalue)");
   opgroup
     ->add_option("--mg-smoother-halo-prec", smoother_halo_prec,
                  "The smoother halo precision (applies to all levels - defaults to null_precision)")
@@ -310,6 +310,7 @@ extern std::string gauge_outfile;
 extern int Nsrc;
 extern int Msrc;
 extern int Nsrc_tile;
+extern int Nsrc_rank;
 extern int Msrc_tile;
 extern int niter;
 extern int nrepeat;
@@ -324,11 +325,19 @@ extern double ca_lambda_min_precondition;
 extern double ca_lambda_max_precondition;
 extern int pipeline;
 extern int solution_accumulator_pipeline;
+extern int recycle_max_dim;
+extern int recycle_block_size;
 extern int test_type;
 extern quda::mgarray<int> nvec;
 extern quda::mgarray<int> nvec_batch;
 extern quda::mgarray<std::string> mg_vec_infile;
 extern quda::mgarray<std::string> mg_vec_outfile;
+extern std::string mg_checkpoint_infile;
+extern std::string mg_checkpoint_outfile;
+extern bool mg_tune;
+extern int mg_tune_n_probe;
+extern int mg_tune_n_solve;
+extern std::string mg_tune_outfile;
 extern quda::mgarray<bool> mg_vec_partfile;
 extern QudaInverterType inv_type;
 extern bool inv_deflate;
@@ -380,6 +389,7 @@ extern double tol_precondition;
 extern double tol_hq;
 extern double reliable_delta;
 extern bool alternative_reliable;
+extern bool adaptive_precision;
 extern QudaTwistFlavorType twist_flavor;
 extern QudaMassNormalization normalization;
 extern QudaMatPCType matpc_type;
@@ -401,6 +411,7 @@ extern quda::mgarray<int> nu_pre;
 extern quda::mgarray<int> nu_post;
 extern quda::mgarray<int> n_block_ortho;
 extern quda::mgarray<bool> block_ortho_two_pass;
+extern quda::mgarray<bool> mg_fit_aggregate_offset;
 extern quda::mgarray<double> mu_factor;
 extern quda::mgarray<QudaVerbosity> mg_verbosity;
 extern quda::mgarray<bool> mg_setup_use_mma;
@@ -412,6 +423,8 @@ extern quda::mgarray<int> num_setup_iter;
 extern quda::mgarray<double> setup_tol;
 extern quda::mgarray<int> setup_maxiter;
 extern quda::mgarray<int> setup_maxiter_refresh;
+extern bool setup_refresh_incremental;
+extern quda::mgarray<double> setup_refresh_tol;
 extern quda::mgarray<QudaCABasis> setup_ca_basis;
 extern quda::mgarray<int> setup_ca_basis_size;
 extern quda::mgarray<double> setup_ca_lambda_min;
@@ -437,10 +450,13 @@ extern bool generate_nullspace;
 extern bool generate_all_levels;
 extern quda::mgarray<QudaSchwarzType> mg_schwarz_type;
 extern quda::mgarray<int> mg_schwarz_cycle;
+extern quda::mgarray<QudaMultigridCycleType> mg_cycle_type;
+extern quda::mgarray<double> mg_cycle_adaptive_threshold;
 extern bool mg_evolve_thin_updates;
 extern QudaTransferType staggered_transfer_type;
 
 extern quda::mgarray<std::array<int, 4>> geo_block_size;
+extern quda::mgarray<std::array<int, 4>> agglomerate_grid;
 extern bool mg_allow_truncation;
 extern bool mg_staggered_kd_dagger_approximation;
 
@@ -470,6 +486,12 @@ extern int eig_n_kr;
 extern int eig_n_conv;         // If unchanged, will be set to n_ev
 extern int eig_n_ev_deflate;   // If unchanged, will be set to n_conv
 extern int eig_batched_rotate; // If unchanged, will be set to maximum
+extern bool eig_deflation_out_of_core;
+extern int eig_deflation_tile_size;
+extern bool eig_deflation_refine;
+extern int eig_deflation_refine_sweeps;
+extern bool eig_precise_refine;
+extern double eig_tol_sloppy;
 extern bool eig_require_convergence;
 extern int eig_check_interval;
 extern int eig_max_restarts;
@@ -477,6 +499,7 @@ extern int eig_max_ortho_attempts;
 extern double eig_tol;
 extern double eig_qr_tol;
 extern bool eig_use_eigen_qr;
+extern bool eig_use_arrow_solver;
 extern bool eig_use_poly_acc;
 extern int eig_poly_deg;
 extern double eig_amin;
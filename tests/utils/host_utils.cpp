@@ -1,5 +1,6 @@
 #include <limits>
 #include <complex>
+#include <random>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -100,11 +101,14 @@ void setQudaDefaultMgTestParams()
     setup_tol[i] = 5e-6;
     setup_maxiter[i] = 500;
     setup_maxiter_refresh[i] = 20;
+    setup_refresh_tol[i] = 0.1;
     mu_factor[i] = 1.;
     coarse_solve_type[i] = QUDA_INVALID_SOLVE;
     smoother_solve_type[i] = QUDA_INVALID_SOLVE;
     mg_schwarz_type[i] = QUDA_INVALID_SCHWARZ;
     mg_schwarz_cycle[i] = 1;
+    mg_cycle_type[i] = QUDA_MG_CYCLE_RECURSIVE;
+    mg_cycle_adaptive_threshold[i] = 0.25;
     smoother_type[i] = QUDA_MR_INVERTER;
     smoother_tol[i] = 0.25;
     coarse_solver[i] = QUDA_GCR_INVERTER;
@@ -116,6 +120,7 @@ void setQudaDefaultMgTestParams()
     nu_post[i] = 2;
     n_block_ortho[i] = 1;
     block_ortho_two_pass[i] = true;
+    mg_fit_aggregate_offset[i] = false;
 
     // Default eigensolver params
     mg_eig[i] = false;
@@ -343,7 +348,8 @@ bool is_hermitian_solver(QudaInverterType type)
 {
   switch (type) {
   case QUDA_CG_INVERTER:
-  case QUDA_CA_CG_INVERTER: return true;
+  case QUDA_CA_CG_INVERTER:
+  case QUDA_BLOCK_CG_INVERTER: return true;
   default: return false;
   }
 }
@@ -1100,6 +1106,36 @@ template <typename Float> void constructRandomGaugeField(Float **res, QudaGaugeP
 template void constructRandomGaugeField(float **res, QudaGaugeParam *param, QudaDslashType dslash_type);
 template void constructRandomGaugeField(double **res, QudaGaugeParam *param, QudaDslashType dslash_type);
 
+template <typename Float> static void perturbHostGaugeField(Float **gauge, double eps)
+{
+  std::mt19937 rng(5678 + quda::comm_rank());
+  std::normal_distribution<double> dist(0.0, eps);
+  for (int d = 0; d < 4; d++) {
+    for (int x = 0; x < V; x++) {
+      double phi[3] = {dist(rng), dist(rng), 0.0};
+      phi[2] = -phi[0] - phi[1];
+      for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+          auto u = &gauge[d][x * gauge_site_size + (row * 3 + col) * 2];
+          std::complex<double> z = std::complex<double>(u[0], u[1]) * std::polar(1.0, phi[col]);
+          u[0] = z.real();
+          u[1] = z.imag();
+        }
+      }
+    }
+  }
+}
+
+void perturbHostGaugeField(void **gauge, QudaPrecision precision, double eps)
+{
+  if (precision == QUDA_DOUBLE_PRECISION)
+    perturbHostGaugeField(reinterpret_cast<double **>(gauge), eps);
+  else if (precision == QUDA_SINGLE_PRECISION)
+    perturbHostGaugeField(reinterpret_cast<float **>(gauge), eps);
+  else
+    errorQuda("Unsupported precision %d", precision);
+}
+
 template <typename Float> void constructUnitaryGaugeField(Float **res)
 {
   Float *resOdd[4], *resEven[4];
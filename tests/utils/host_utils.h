@@ -119,6 +119,15 @@ template <typename Float> void constructUnitGaugeField(Float **res, QudaGaugePar
 template <typename Float>
 void constructRandomGaugeField(Float **res, QudaGaugeParam *param, QudaDslashType dslash_type = QUDA_WILSON_DSLASH);
 template <typename Float> void applyGaugeFieldScaling(Float **gauge, int Vh, QudaGaugeParam *param);
+
+/**
+   @brief Perturb a host gauge field by a random diagonal SU(3) matrix
+   on every link, U -> U diag(e^{i phi_1}, e^{i phi_2}, e^{-i (phi_1 + phi_2)})
+   @param[in,out] gauge The host gauge field (QDP order)
+   @param[in] precision The precision of the host gauge field
+   @param[in] eps The width of the random phases
+*/
+void perturbHostGaugeField(void **gauge, QudaPrecision precision, double eps);
 //------------------------------------------------------
 
 // Spinor utils
@@ -224,6 +224,7 @@ const char *get_eig_type_str(QudaEigType type)
   case QUDA_EIG_TR_LANCZOS_3D: ret = "trlm_3d"; break;
   case QUDA_EIG_IR_ARNOLDI: ret = "iram"; break;
   case QUDA_EIG_BLK_IR_ARNOLDI: ret = "blkiram"; break;
+  case QUDA_EIG_LOBPCG: ret = "lobpcg"; break;
   default: ret = "unknown eigensolver"; break;
   }
 
@@ -364,6 +365,8 @@ const char *get_solver_str(QudaInverterType type)
   case QUDA_CA_CGNE_INVERTER: ret = "ca_cgne"; break;
   case QUDA_CA_CGNR_INVERTER: ret = "ca_cgnr"; break;
   case QUDA_CA_GCR_INVERTER: ret = "ca_gcr"; break;
+  case QUDA_BLOCK_CG_INVERTER: ret = "block_cg"; break;
+  case QUDA_CHEBYSHEV_INVERTER: ret = "chebyshev"; break;
   default:
     ret = "unknown";
     errorQuda("Error: invalid solver type %d\n", type);
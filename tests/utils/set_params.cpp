@@ -238,8 +238,11 @@ void setInvertParam(QudaInvertParam &inv_param)
   inv_param.maxiter = niter;
   inv_param.reliable_delta = reliable_delta;
   inv_param.use_alternative_reliable = alternative_reliable;
+  inv_param.adaptive_precision = adaptive_precision ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   inv_param.use_sloppy_partial_accumulator = 0;
   inv_param.solution_accumulator_pipeline = solution_accumulator_pipeline;
+  inv_param.recycle_max_dim = recycle_max_dim;
+  inv_param.recycle_block_size = recycle_block_size;
   inv_param.max_res_increase = max_res_increase;
   inv_param.max_res_increase_total = max_res_increase_total;
 
@@ -317,7 +320,7 @@ void setEigParam(QudaEigParam &eig_param)
 {
   eig_param.eig_type = eig_type;
   eig_param.spectrum = eig_spectrum;
-  if ((eig_type == QUDA_EIG_TR_LANCZOS || eig_type == QUDA_EIG_BLK_TR_LANCZOS)
+  if ((eig_type == QUDA_EIG_TR_LANCZOS || eig_type == QUDA_EIG_BLK_TR_LANCZOS || eig_type == QUDA_EIG_LOBPCG)
       && !(eig_spectrum == QUDA_SPECTRUM_LR_EIG || eig_spectrum == QUDA_SPECTRUM_SR_EIG)) {
     errorQuda("Only real spectrum type (LR or SR) can be passed to Lanczos type solver.");
   }
@@ -348,6 +351,12 @@ void setEigParam(QudaEigParam &eig_param)
   eig_param.tol = eig_tol;
   eig_param.qr_tol = eig_qr_tol;
   eig_param.batched_rotate = eig_batched_rotate;
+  eig_param.deflation_out_of_core = eig_deflation_out_of_core ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  eig_param.deflation_tile_size = eig_deflation_tile_size;
+  eig_param.deflation_refine = eig_deflation_refine ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  eig_param.deflation_refine_sweeps = eig_deflation_refine_sweeps;
+  eig_param.precise_refine = eig_precise_refine ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  eig_param.tol_sloppy = eig_tol_sloppy;
   eig_param.require_convergence = eig_require_convergence ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   eig_param.check_interval = eig_check_interval;
   eig_param.max_restarts = eig_max_restarts;
@@ -364,6 +373,7 @@ void setEigParam(QudaEigParam &eig_param)
   }
 
   eig_param.use_eigen_qr = eig_use_eigen_qr ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  eig_param.use_arrow_solver = eig_use_arrow_solver ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   eig_param.use_poly_acc = eig_use_poly_acc ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   eig_param.poly_deg = eig_poly_deg;
   eig_param.a_min = eig_amin;
@@ -456,6 +466,7 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     for (int j = 0; j < 4; j++) {
       // if not defined use 4
       mg_param.geo_block_size[i][j] = geo_block_size[i][j] ? geo_block_size[i][j] : 4;
+      mg_param.agglomerate_grid[i][j] = agglomerate_grid[i][j] ? agglomerate_grid[i][j] : 1;
     }
     for (int j = 4; j < QUDA_MAX_DIM; j++) mg_param.geo_block_size[i][j] = 1;
     mg_param.use_eig_solver[i] = mg_eig[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
@@ -467,6 +478,7 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     mg_param.setup_tol[i] = setup_tol[i];
     mg_param.setup_maxiter[i] = setup_maxiter[i];
     mg_param.setup_maxiter_refresh[i] = setup_maxiter_refresh[i];
+    mg_param.setup_refresh_tol[i] = setup_refresh_tol[i];
 
     // Basis to use for CA solver setups
     mg_param.setup_ca_basis[i] = setup_ca_basis[i];
@@ -484,13 +496,15 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     mg_param.n_block_ortho[i] = n_block_ortho[i];    // number of times to Gram-Schmidt
     mg_param.block_ortho_two_pass[i]
       = block_ortho_two_pass[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE; // whether to use a two-pass block ortho
+    mg_param.fit_aggregate_offset[i] = mg_fit_aggregate_offset[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
     mg_param.precision_null[i] = prec_null;                               // precision to store the null-space basis
     mg_param.smoother_halo_precision[i] = smoother_halo_prec; // precision of the halo exchange in the smoother
     mg_param.nu_pre[i] = nu_pre[i];
     mg_param.nu_post[i] = nu_post[i];
     mg_param.mu_factor[i] = mu_factor[i];
 
-    mg_param.cycle_type[i] = QUDA_MG_CYCLE_RECURSIVE;
+    mg_param.cycle_type[i] = mg_cycle_type[i];
+    mg_param.cycle_adaptive_threshold[i] = mg_cycle_adaptive_threshold[i];
 
     // Is not a staggered solve, always aggregate
     mg_param.transfer_type[i] = QUDA_TRANSFER_AGGREGATE;
@@ -618,6 +632,7 @@ void setMultigridParam(QudaMultigridParam &mg_param)
   mg_param.setup_type = setup_type;
   mg_param.pre_orthonormalize = pre_orthonormalize ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   mg_param.post_orthonormalize = post_orthonormalize ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  mg_param.setup_refresh_incremental = setup_refresh_incremental ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
   mg_param.compute_null_vector = generate_nullspace ? QUDA_COMPUTE_NULL_VECTOR_YES : QUDA_COMPUTE_NULL_VECTOR_NO;
 
@@ -646,6 +661,11 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     if (mg_vec_outfile[i].size() > 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
     mg_param.mg_vec_partfile[i] = mg_vec_partfile[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   }
+  safe_strcpy(mg_param.checkpoint_infile, mg_checkpoint_infile, 256, "mg_checkpoint_infile");
+  safe_strcpy(mg_param.checkpoint_outfile, mg_checkpoint_outfile, 256, "mg_checkpoint_outfile");
+  mg_param.tune_n_probe = mg_tune_n_probe;
+  mg_param.tune_n_solve = mg_tune_n_solve;
+  safe_strcpy(mg_param.tune_outfile, mg_tune_outfile, 256, "mg_tune_outfile");
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
@@ -954,8 +974,11 @@ void setStaggeredInvertParam(QudaInvertParam &inv_param)
   inv_param.maxiter = niter;
   inv_param.reliable_delta = reliable_delta;
   inv_param.use_alternative_reliable = alternative_reliable;
+  inv_param.adaptive_precision = adaptive_precision ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   inv_param.use_sloppy_partial_accumulator = false;
   inv_param.solution_accumulator_pipeline = solution_accumulator_pipeline;
+  inv_param.recycle_max_dim = recycle_max_dim;
+  inv_param.recycle_block_size = recycle_block_size;
   inv_param.pipeline = pipeline;
   inv_param.max_res_increase = max_res_increase;
   inv_param.max_res_increase_total = max_res_increase_total;
@@ -1074,6 +1097,7 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
     for (int j = 0; j < 4; j++) {
       // if not defined use 4
       mg_param.geo_block_size[i][j] = geo_block_size[i][j] ? geo_block_size[i][j] : 4;
+      mg_param.agglomerate_grid[i][j] = agglomerate_grid[i][j] ? agglomerate_grid[i][j] : 1;
     }
     mg_param.use_eig_solver[i] = mg_eig[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
     mg_param.verbosity[i] = mg_verbosity[i];
@@ -1100,6 +1124,7 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
     mg_param.n_block_ortho[i] = n_block_ortho[i];    // number of times to Gram-Schmidt
     mg_param.block_ortho_two_pass[i]
       = block_ortho_two_pass[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE; // whether to use a two-pass block ortho
+    mg_param.fit_aggregate_offset[i] = mg_fit_aggregate_offset[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
     mg_param.precision_null[i] = prec_null;                               // precision to store the null-space basis
     mg_param.smoother_halo_precision[i] = smoother_halo_prec; // precision of the halo exchange in the smoother
     mg_param.nu_pre[i] = nu_pre[i];
@@ -1108,7 +1133,8 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
 
     mg_param.transfer_type[i] = (i == 0) ? staggered_transfer_type : QUDA_TRANSFER_AGGREGATE;
 
-    mg_param.cycle_type[i] = QUDA_MG_CYCLE_RECURSIVE;
+    mg_param.cycle_type[i] = mg_cycle_type[i];
+    mg_param.cycle_adaptive_threshold[i] = mg_cycle_adaptive_threshold[i];
 
     // set the coarse solver wrappers including bottom solver
     mg_param.coarse_solver[i] = coarse_solver[i];
@@ -1240,6 +1266,7 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
   mg_param.setup_type = setup_type;
   mg_param.pre_orthonormalize = pre_orthonormalize ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   mg_param.post_orthonormalize = post_orthonormalize ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  mg_param.setup_refresh_incremental = setup_refresh_incremental ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
   mg_param.compute_null_vector = generate_nullspace ? QUDA_COMPUTE_NULL_VECTOR_YES : QUDA_COMPUTE_NULL_VECTOR_NO;
 
@@ -1257,6 +1284,11 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
     if (mg_vec_outfile[i].size() > 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
     mg_param.mg_vec_partfile[i] = mg_vec_partfile[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   }
+  safe_strcpy(mg_param.checkpoint_infile, mg_checkpoint_infile, 256, "mg_checkpoint_infile");
+  safe_strcpy(mg_param.checkpoint_outfile, mg_checkpoint_outfile, 256, "mg_checkpoint_outfile");
+  mg_param.tune_n_probe = mg_tune_n_probe;
+  mg_param.tune_n_solve = mg_tune_n_solve;
+  safe_strcpy(mg_param.tune_outfile, mg_tune_outfile, 256, "mg_tune_outfile");
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 